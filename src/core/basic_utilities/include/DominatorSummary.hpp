@@ -37,11 +37,21 @@ namespace llvm::noelle {
     BasicBlock *B;
     unsigned level;
 
+    /*
+     * Interval of the node in a depth-first visit of the tree: a node dominates another one if and only if its interval includes the interval of the other node.
+     */
+    unsigned dfsIn;
+    unsigned dfsOut;
+
     DomNodeSummary *parent;
     std::vector<DomNodeSummary *> children;
     DomNodeSummary *iDom;
   };
 
+  /*
+   * The nodes of the tree are stored in a flat array and numbered by a depth-first visit of the tree, so dominance between basic blocks is checked in constant time.
+   * Summaries of a subset of the basic blocks keep the numbering of the tree they come from.
+   */
   class DomTreeSummary {
    public:
     DomTreeSummary (DominatorTree &DT);
@@ -59,11 +69,12 @@ namespace llvm::noelle {
     template <typename TreeType>
     std::set<DTAliases::Node *> collectNodesOfTree (TreeType &T);
     std::set<DomNodeSummary *> filterNodes (
-      std::set<DomNodeSummary *> &nodes,
+      std::vector<DomNodeSummary> &nodes,
       std::set<BasicBlock *> &bbSubset
     );
     template <typename NodeType>
     void cloneNodes (std::set<NodeType *> &nodes);
+    void computeDFSIntervals (void);
 
    public:
     DomNodeSummary *getNode (BasicBlock *B) const ;
@@ -75,7 +86,7 @@ namespace llvm::noelle {
     DomNodeSummary *findNearestCommonDominator (DomNodeSummary *node1, DomNodeSummary *node2) const ;
 
    private:
-    std::set<DomNodeSummary *> nodes;
+    std::vector<DomNodeSummary> nodes;
     std::unordered_map<BasicBlock *, DomNodeSummary *> bbNodeMap;
     bool post;
   };
@@ -21,6 +21,20 @@ namespace llvm {
       std::vector<Function *> queuePushes;
       std::vector<Function *> queuePops;
       std::vector<Type *> queueTypes;
+      Function *queueFlush;
+
+      /*
+       * Queues that distribute values across the replicas of a pipeline stage.
+       */
+      std::vector<Function *> queueRoundRobinPushes;
+      std::vector<Function *> queueRoundRobinPops;
+      Function *queueRoundRobinFlush;
+
+      /*
+       * Queues that carry records of values produced in the same iteration.
+       */
+      Function *queueRecordPush;
+      Function *queueRecordPop;
   };
 
 }
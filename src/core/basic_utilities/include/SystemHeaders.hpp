@@ -23,6 +23,7 @@
 #include <list>
 #include <deque>
 #include <thread>
+#include <atomic>
 #include <sstream>
 #include <math.h>
 #include <optional>
@@ -18,11 +18,11 @@ namespace llvm::noelle {
  */
 
 DomNodeSummary::DomNodeSummary (const DTAliases::Node &node) :
-  B{node.getBlock()}, level{node.getLevel()},
+  B{node.getBlock()}, level{node.getLevel()}, dfsIn{0}, dfsOut{0},
   parent{nullptr}, iDom{nullptr}, children{} {}
 
 DomNodeSummary::DomNodeSummary (const DomNodeSummary &node) :
-  B{node.getBlock()}, level{node.getLevel()},
+  B{node.getBlock()}, level{node.getLevel()}, dfsIn{node.dfsIn}, dfsOut{node.dfsOut},
   parent{nullptr}, iDom{nullptr}, children{} {}
 
 raw_ostream &DomNodeSummary::print (raw_ostream &stream, std::string prefix) {
@@ -83,6 +83,7 @@ DomTreeSummary::DomTreeSummary (PostDominatorTree &PDT)
 DomTreeSummary::DomTreeSummary (std::set<DTAliases::Node *> nodeSubset) :
   nodes{}, bbNodeMap{} {
   this->cloneNodes<DTAliases::Node>(nodeSubset);
+  this->computeDFSIntervals();
 }
 
 DomTreeSummary::DomTreeSummary (DomTreeSummary &DTS, std::set<BasicBlock *> &bbSubset) :
@@ -94,15 +95,16 @@ DomTreeSummary::DomTreeSummary (std::set<DomNodeSummary *> nodeSubset)
 }
 
 DomTreeSummary::~DomTreeSummary () {
-  for (auto node : nodes) delete node;
   nodes.clear();
   bbNodeMap.clear();
 }
 
 void DomTreeSummary::transferToClones (std::unordered_map<BasicBlock *, BasicBlock *> &bbCloneMap) {
-  for (auto node : nodes) {
-    assert(bbCloneMap.find(node->B) != bbCloneMap.end());
-    node->B = bbCloneMap[node->B];
+  bbNodeMap.clear();
+  for (auto &node : nodes) {
+    assert(bbCloneMap.find(node.B) != bbCloneMap.end());
+    node.B = bbCloneMap[node.B];
+    bbNodeMap[node.B] = &node;
   }
 }
 
@@ -130,13 +132,13 @@ std::set<DTAliases::Node *> DomTreeSummary::collectNodesOfTree (TreeType &T) {
 }
 
 std::set<DomNodeSummary *> DomTreeSummary::filterNodes (
-  std::set<DomNodeSummary *> &nodes,
+  std::vector<DomNodeSummary> &nodes,
   std::set<BasicBlock *> &bbSubset
 ) {
   std::set<DomNodeSummary *> nodesSubset;
-  for (auto node : nodes) {
-    if (bbSubset.find(node->B) != bbSubset.end()) {
-      nodesSubset.insert(node);
+  for (auto &node : nodes) {
+    if (bbSubset.find(node.B) != bbSubset.end()) {
+      nodesSubset.insert(&node);
     }
   }
   return nodesSubset;
@@ -147,12 +149,14 @@ void DomTreeSummary::cloneNodes (std::set<NodeType *> &nodesToClone) {
 
   /*
    * Clone nodes using DomNodeSummary constructors. Track cloned pairs in map
+   * NOTE: the array is allocated once, so pointers to its nodes stay valid
    */
   std::unordered_map<NodeType *, DomNodeSummary *> nodeMap;
+  this->nodes.reserve(nodesToClone.size());
   for (auto node : nodesToClone) {
-    auto summary = new DomNodeSummary(*node);
+    this->nodes.emplace_back(*node);
+    auto summary = &this->nodes.back();
     nodeMap[node] = summary;
-    this->nodes.insert(summary);
     this->bbNodeMap[summary->B] = summary;
   }
 
@@ -178,6 +182,33 @@ void DomTreeSummary::cloneNodes (std::set<NodeType *> &nodesToClone) {
   }
 }
 
+void DomTreeSummary::computeDFSIntervals (void) {
+  unsigned counter = 0;
+  std::vector<std::pair<DomNodeSummary *, unsigned>> stack;
+  for (auto &root : this->nodes) {
+    if (root.parent != nullptr) continue;
+
+    /*
+     * Number the nodes of the tree rooted at @root.
+     */
+    root.dfsIn = counter++;
+    stack.push_back(std::make_pair(&root, 0));
+    while (!stack.empty()) {
+      auto node = stack.back().first;
+      auto nextChild = stack.back().second;
+      if (nextChild == node->children.size()) {
+        node->dfsOut = counter++;
+        stack.pop_back();
+        continue;
+      }
+      stack.back().second++;
+      auto child = node->children[nextChild];
+      child->dfsIn = counter++;
+      stack.push_back(std::make_pair(child, 0));
+    }
+  }
+}
+
 DomNodeSummary *DomTreeSummary::getNode (BasicBlock *B) const {
   auto nodeIter = bbNodeMap.find(B);
   return nodeIter == bbNodeMap.end() ? nullptr : nodeIter->second;
@@ -264,16 +295,7 @@ bool DomTreeSummary::dominates (BasicBlock *B1, BasicBlock *B2) const {
 }
 
 bool DomTreeSummary::dominates (DomNodeSummary *node1, DomNodeSummary *node2) const {
-  std::queue<DomNodeSummary *> worklist;
-  worklist.push(node1);
-  while (!worklist.empty()) {
-    auto node = worklist.front();
-    worklist.pop();
-
-    if (node == node2) return true;
-    for (auto child : node->children) worklist.push(child);
-  }
-  return false;
+  return (node1->dfsIn <= node2->dfsIn) && (node2->dfsOut <= node1->dfsOut);
 }
 
 std::set<DomNodeSummary *> DomTreeSummary::dominates (DomNodeSummary *node) const {
@@ -314,25 +336,17 @@ DomNodeSummary *DomTreeSummary::findNearestCommonDominator (
   DomNodeSummary *node2
 ) const {
 
-  /*
-   * Helpers to determine whether a node n dominates node2
-   */
-  auto dominatorsOf2 = this->dominates(node2);
-  auto dominates2 = [&](DomNodeSummary *node) -> bool {
-    return dominatorsOf2.find(node) != dominatorsOf2.end();
-  };
-
   /*
    * Traversal of parents of node1 to find common dominator
    */
   DomNodeSummary *node = node1;
-  while (node && !dominates2(node)) node = node->parent;
+  while (node && !this->dominates(node, node2)) node = node->parent;
   return node;
 }
 
 raw_ostream &DomTreeSummary::print (raw_ostream &stream, std::string prefixToUse) const {
-  for (auto node : nodes) {
-    node->print(stream, prefixToUse);
+  for (auto &pair : bbNodeMap) {
+    pair.second->print(stream, prefixToUse);
   }
   return stream;
 }
@@ -36,6 +36,14 @@ namespace llvm::noelle {
 
       uint64_t getTotalInstructions (Instruction *i) const ;
 
+      /*
+       * Return the callees invoked by the indirect call @i, each one paired with the number of times @i invoked it.
+       * Callees are sorted from the most invoked one.
+       */
+      std::vector<std::pair<Function *, uint64_t>> getIndirectCallTargets (Instruction *i) const ;
+
+      void setIndirectCallTargets (Instruction *i, std::vector<std::pair<Function *, uint64_t>> const &targets);
+
 
       /*
        * =========================== Basic blocks ================================
@@ -163,6 +171,7 @@ namespace llvm::noelle {
       std::unordered_map<Function *, uint64_t> functionSelfInstructions;
       std::unordered_map<Function *, uint64_t> functionTotalInstructions;
       std::unordered_map<Instruction *, uint64_t> instructionTotalInstructions;
+      std::unordered_map<Instruction *, std::vector<std::pair<Function *, uint64_t>>> indirectCallTargets;
       uint64_t moduleNumberOfInstructionsExecuted;
 
       void computeTotalInstructions (Module &M); 
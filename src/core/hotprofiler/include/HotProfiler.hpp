@@ -35,6 +35,11 @@ namespace llvm::noelle {
     private:
       Hot hot;
 
+      /*
+       * Maximum number of targets fetched per indirect call.
+       */
+      static const uint32_t MaxNumIndirectCallTargets = 8;
+
       void analyzeProfiles (Module &M);
   };
 }
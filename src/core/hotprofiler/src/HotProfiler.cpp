@@ -10,6 +10,8 @@
  */
 #include "SystemHeaders.hpp"
 
+#include "llvm/ProfileData/InstrProf.h"
+
 #include "HotProfiler.hpp"
 
 using namespace llvm;
@@ -74,6 +76,47 @@ void HotProfiler::analyzeProfiles (Module &M){
     }
   }
 
+  /*
+   * Fetch the callees invoked by each indirect call.
+   * These are the values profiled for the targets of indirect calls, which are identified by the MD5 hash of the name of the callee.
+   */
+  InstrProfSymtab symtab;
+  if (auto err = symtab.create(M)){
+    consumeError(std::move(err));
+
+  } else {
+    for (auto &F : M){
+      for (auto &inst : instructions(F)){
+        auto callInst = dyn_cast<CallInst>(&inst);
+        if (  false
+              || (callInst == nullptr)
+              || (callInst->getCalledFunction() != nullptr)
+           ){
+          continue ;
+        }
+
+        /*
+         * Fetch the profiled targets.
+         */
+        InstrProfValueData valueData[MaxNumIndirectCallTargets];
+        uint32_t numberOfTargets = 0;
+        uint64_t totalCount = 0;
+        if (!getValueProfDataFromInst(inst, IPVK_IndirectCallTarget, MaxNumIndirectCallTargets, valueData, numberOfTargets, totalCount)){
+          continue ;
+        }
+        std::vector<std::pair<Function *, uint64_t>> targets;
+        for (auto i = 0u; i < numberOfTargets; i++){
+          auto callee = symtab.getFunction(valueData[i].Value);
+          if (callee == nullptr){
+            continue ;
+          }
+          targets.push_back(std::make_pair(callee, valueData[i].Count));
+        }
+        this->hot.setIndirectCallTargets(&inst, targets);
+      }
+    }
+  }
+
   /*
    * Compute the global counters.
    */
@@ -92,3 +92,26 @@ bool Hot::hasBeenExecuted (Instruction *i) const {
 
   return true;
 }
+
+std::vector<std::pair<Function *, uint64_t>> Hot::getIndirectCallTargets (Instruction *i) const {
+  if (this->indirectCallTargets.find(i) == this->indirectCallTargets.end()){
+    return {};
+  }
+
+  return this->indirectCallTargets.at(i);
+}
+
+void Hot::setIndirectCallTargets (Instruction *i, std::vector<std::pair<Function *, uint64_t>> const &targets){
+
+  /*
+   * Sort the callees from the most invoked one.
+   */
+  auto sortedTargets = targets;
+  std::stable_sort(sortedTargets.begin(), sortedTargets.end(), [](auto const &t1, auto const &t2) -> bool {
+    return t1.second > t2.second;
+  });
+
+  this->indirectCallTargets[i] = sortedTargets;
+
+  return ;
+}
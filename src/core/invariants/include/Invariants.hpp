@@ -12,15 +12,54 @@
 
 #include "PDG.hpp"
 #include "LoopsSummary.hpp"
+#include "StayConnectedNestedLoopForest.hpp"
 
 namespace llvm::noelle {
 
+  /*
+   * Loop invariants of all loops of a function computed at once.
+   * For each instruction included in a loop, the analysis records the nesting level of the outermost loop the instruction is invariant in.
+   * An instruction invariant in a loop is invariant in all loops nested in it that include the instruction, so a single level describes the instruction for the whole nest.
+   */
+  class LoopForestInvariants {
+    public:
+
+      /*
+       * @forest must include all loops of the function @functionDG has been computed for.
+       */
+      LoopForestInvariants (
+        StayConnectedNestedLoopForest *forest,
+        PDG *functionDG
+      );
+
+      LoopForestInvariants () = delete;
+
+      /*
+       * Return true if @inst is known to be invariant in @loop.
+       * A false answer means that this analysis could not prove it (e.g., @inst belongs to a function the analysis has not been computed for).
+       */
+      bool isLoopInvariant (LoopStructure *loop, Instruction *inst) const ;
+
+    private:
+      std::unordered_map<Instruction *, uint32_t> outermostInvariantLevel;
+  };
+
   class InvariantManager {
     public:
       InvariantManager (
         LoopStructure *loop,
         PDG *loopDG
       );
+
+      /*
+       * The loop invariants already proved by @forestInvariants are fetched from it rather than computed again.
+       * Only the remaining instructions of @loop are analyzed with @loopDG.
+       */
+      InvariantManager (
+        LoopStructure *loop,
+        PDG *loopDG,
+        LoopForestInvariants *forestInvariants
+      );
       
       InvariantManager () = delete;
 
@@ -28,6 +67,11 @@ namespace llvm::noelle {
 
       std::unordered_set<Instruction *> getLoopInstructionsThatAreLoopInvariants (void) const ;
 
+      /*
+       * Check whether all incoming values of @phi are the same value (or loads of the same global).
+       */
+      static bool arePHIIncomingValuesEquivalent (PHINode *phi) ;
+
     private:
       std::unordered_set<Instruction *> invariants;
       LoopStructure *ls;
@@ -65,8 +109,6 @@ namespace llvm::noelle {
            */
           std::unordered_set<Instruction *> dependencyValuesBeingChecked;
 
-          bool arePHIIncomingValuesEquivalent (PHINode *phi) ;
-
       };
 
   };
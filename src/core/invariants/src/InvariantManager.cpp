@@ -23,7 +23,7 @@ InvariantManager::InvariantManager (
   /*
    * Check every instruction of the loop.
    */
-  for (auto inst : loop->getInstructions()){
+  for (auto inst : loop->instructions()){
 
     /*
      * Check if it is loop invariant according to the loop structure.
@@ -46,6 +46,45 @@ InvariantManager::InvariantManager (
   return ;
 }
 
+InvariantManager::InvariantManager (
+  LoopStructure *loop,
+  PDG *loopDG,
+  LoopForestInvariants *forestInvariants
+  ) : ls{loop}
+{
+  assert(forestInvariants != nullptr);
+
+  /*
+   * Check every instruction of the loop.
+   */
+  for (auto inst : loop->instructions()){
+
+    /*
+     * Check if it is loop invariant according to the loop structure or to the invariants of the whole loop nest.
+     */
+    if (  false
+          || loop->isLoopInvariant(inst)
+          || forestInvariants->isLoopInvariant(loop, inst)
+       ){
+
+      /*
+       * @inst is a loop invariant.
+       */
+      this->invariants.insert(inst);
+      continue ;
+    }
+  }
+
+  /*
+   * The invariants of the loop nest have been computed with the dependences of the whole function.
+   * The dependence graph of the loop can be more accurate, so we traverse it to identify the remaining loop invariants.
+   * The instructions already known to be invariant are not analyzed again.
+   */
+  InvarianceChecker checker{loop, loopDG, this->invariants};
+
+  return ;
+}
+
 bool InvariantManager::isLoopInvariant (Value *value) const {
 
   /*
@@ -83,7 +122,7 @@ InvariantManager::InvarianceChecker::InvarianceChecker (
   /*
    * Check all instructions.
    */
-  for (auto inst : loop->getInstructions()){
+  for (auto inst : loop->instructions()){
 
     /*
      * Since we will rely on data dependencies to identify loop invariants, we exclude instructions that are involved in control dependencies.
@@ -254,7 +293,7 @@ bool InvariantManager::InvarianceChecker::isEvolvingValue (Value *toValue, DGEdg
   return canEvolve;
 }
 
-bool InvariantManager::InvarianceChecker::arePHIIncomingValuesEquivalent (PHINode *phi) {
+bool InvariantManager::arePHIIncomingValuesEquivalent (PHINode *phi) {
 
   std::unordered_set<Value *> incomingValues{};
   for (auto &incomingUse : phi->incoming_values()) {
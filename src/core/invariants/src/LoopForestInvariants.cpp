@@ -0,0 +1,188 @@
+/*
+ * Copyright 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "Invariants.hpp"
+#include "PDGAnalysis.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+LoopForestInvariants::LoopForestInvariants (
+  StayConnectedNestedLoopForest *forest,
+  PDG *functionDG
+  ) {
+  assert(forest != nullptr);
+  assert(functionDG != nullptr);
+
+  /*
+   * Map every instruction to the innermost loop that includes it.
+   * Loops are visited from the outermost ones, so the innermost loop is the last one that claims the instruction.
+   */
+  std::unordered_map<Instruction *, StayConnectedNestedLoopForestNode *> innermostLoop;
+  std::vector<Instruction *> loopInstructions;
+  for (auto tree : forest->getTrees()){
+    auto mapInstructions = [&innermostLoop, &loopInstructions](StayConnectedNestedLoopForestNode *n, uint32_t treeLevel) -> bool {
+      for (auto inst : n->getLoop()->instructions()){
+        if (innermostLoop.find(inst) == innermostLoop.end()){
+          loopInstructions.push_back(inst);
+        }
+        innermostLoop[inst] = n;
+      }
+      return false;
+    };
+    tree->visitPreOrder(mapInstructions);
+  }
+
+  /*
+   * Nesting level of the innermost loop that includes both instructions given as input (0 if there is none).
+   */
+  auto getCommonNestingLevel = [&innermostLoop](Instruction *i1, Instruction *i2) -> uint32_t {
+    auto i2LoopIt = innermostLoop.find(i2);
+    if (i2LoopIt == innermostLoop.end()){
+      return 0;
+    }
+    for (auto n = i2LoopIt->second; n != nullptr; n = n->getParent()){
+      auto loop = n->getLoop();
+      if (loop->isIncluded(i1)){
+        return loop->getNestingLevel();
+      }
+    }
+    return 0;
+  };
+
+  /*
+   * Start from the assumption that no instruction is invariant in any loop.
+   * The level of an instruction can only decrease as the levels of the instructions it depends on decrease, so the next fixed-point computation terminates.
+   */
+  auto notInvariantLevel = std::numeric_limits<uint32_t>::max();
+  for (auto inst : loopInstructions){
+    this->outermostInvariantLevel[inst] = notInvariantLevel;
+  }
+
+  /*
+   * Compute the nesting level of the outermost loop each instruction is invariant in.
+   */
+  std::queue<Instruction *> worklist;
+  std::unordered_set<Instruction *> inWorklist;
+  for (auto inst : loopInstructions){
+    worklist.push(inst);
+    inWorklist.insert(inst);
+  }
+  while (!worklist.empty()){
+    auto inst = worklist.front();
+    worklist.pop();
+    inWorklist.erase(inst);
+
+    /*
+     * Terminators, PHIs that select between different values, and calls to impure library functions are never invariant.
+     * This is consistent with InvariantManager.
+     */
+    if (inst->isTerminator()){
+      continue ;
+    }
+    if (auto phi = dyn_cast<PHINode>(inst)){
+      if (!InvariantManager::arePHIIncomingValuesEquivalent(phi)){
+        continue ;
+      }
+    }
+    if (auto callInst = dyn_cast<CallInst>(inst)){
+      auto callee = callInst->getCalledFunction();
+      if (  true
+            && (callee != nullptr)
+            && (callee->empty())
+            && (!PDGAnalysis::isTheLibraryFunctionPure(callee))
+         ){
+        continue ;
+      }
+    }
+
+    /*
+     * @inst is invariant in a loop that includes it only if every instruction of that loop it depends on is invariant in the same loop.
+     * Memory dependences and dependences from stores or from PHIs that select between different values prevent @inst from being invariant in the loops that include both instructions.
+     */
+    uint32_t level = 1;
+    auto computeLevel = [this, inst, &level, &getCommonNestingLevel](Value *fromValue, DGEdge<Value> *dep) -> bool {
+      auto fromInst = dyn_cast<Instruction>(fromValue);
+      if (fromInst == nullptr){
+        return false;
+      }
+      auto commonLevel = getCommonNestingLevel(fromInst, inst);
+      if (commonLevel == 0){
+        return false;
+      }
+      uint32_t requiredLevel = commonLevel + 1;
+      auto isFromInstEvolving = false
+        || dep->isMemoryDependence()
+        || isa<StoreInst>(fromInst)
+        || (isa<PHINode>(fromInst) && !InvariantManager::arePHIIncomingValuesEquivalent(cast<PHINode>(fromInst)));
+      if (!isFromInstEvolving){
+        requiredLevel = std::min(requiredLevel, this->outermostInvariantLevel.at(fromInst));
+      }
+      level = std::max(level, requiredLevel);
+      return false;
+    };
+    functionDG->iterateOverDependencesTo(inst, false, true, true, computeLevel);
+
+    /*
+     * Check if @inst is invariant in at least one loop that includes it.
+     */
+    if (level > innermostLoop.at(inst)->getLoop()->getNestingLevel()){
+      continue ;
+    }
+
+    /*
+     * Check if the level has decreased.
+     * If it has, then the instructions that depend on @inst need to be analyzed again.
+     */
+    if (level >= this->outermostInvariantLevel.at(inst)){
+      continue ;
+    }
+    this->outermostInvariantLevel[inst] = level;
+    auto addDependent = [this, &worklist, &inWorklist](Value *toValue, DGEdge<Value> *dep) -> bool {
+      auto toInst = dyn_cast<Instruction>(toValue);
+      if (  false
+            || (toInst == nullptr)
+            || (this->outermostInvariantLevel.find(toInst) == this->outermostInvariantLevel.end())
+            || (inWorklist.find(toInst) != inWorklist.end())
+         ){
+        return false;
+      }
+      worklist.push(toInst);
+      inWorklist.insert(toInst);
+      return false;
+    };
+    functionDG->iterateOverDependencesFrom(inst, false, true, true, addDependent);
+  }
+
+  return ;
+}
+
+bool LoopForestInvariants::isLoopInvariant (LoopStructure *loop, Instruction *inst) const {
+
+  /*
+   * If the instruction is outside the loop, then it's a loop invariant.
+   */
+  if (!loop->isIncluded(inst)){
+    return true;
+  }
+
+  /*
+   * Check if the instruction has been analyzed.
+   */
+  auto levelIt = this->outermostInvariantLevel.find(inst);
+  if (levelIt == this->outermostInvariantLevel.end()){
+    return false;
+  }
+
+  /*
+   * @inst is invariant in @loop if it is invariant in @loop or in a loop that includes @loop.
+   */
+  return levelIt->second <= loop->getNestingLevel();
+}
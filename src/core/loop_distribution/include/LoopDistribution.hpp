@@ -39,6 +39,16 @@ namespace llvm::noelle {
         std::set<Instruction *> &instructionsAdded
         );
 
+      /*
+       * Collect the instructions that a split pulling out SCCsToPullOut would replicate in both loops (i.e., the control flow and the sub-loop code they depend on).
+       * Return false if the loop cannot be split.
+       */
+      bool collectInstructionsToClone (
+        LoopDependenceInfo const &LDI,
+        std::set<SCC *> const &SCCsToPullOut,
+        std::set<Instruction *> &instsToClone
+        );
+
     private:
 
       /*
@@ -55,6 +65,17 @@ namespace llvm::noelle {
         std::set<Instruction *> &instructionsAdded
       );
 
+      bool collectInstructionsToClone (
+        LoopDependenceInfo const &LDI,
+        std::set<Instruction *> const &instsToPullOut,
+        std::set<Instruction *> &instsToClone
+      );
+
+      void collectInstructionsOfSCCs (
+        std::set<SCC *> const &SCCs,
+        std::set<Instruction *> &insts
+      );
+
       void recursivelyCollectDependencies (
         Instruction * inst,
         std::set<Instruction *> &toPopulate,
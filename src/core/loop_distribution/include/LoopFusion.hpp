@@ -0,0 +1,85 @@
+/*
+ * Copyright 2020 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+#include "LoopDependenceInfo.hpp"
+#include "LoopStructure.hpp"
+#include "PDG.hpp"
+
+namespace llvm::noelle {
+
+  class LoopFusion {
+    public:
+
+      /*
+       * Methods
+       */
+      LoopFusion();
+
+      /*
+       * Check whether the loop @second can be fused into the loop @first.
+       * The two loops must be adjacent siblings (@second starts right after @first exits), they must be governed by induction variables that evolve in the same way, and they must not have dependences that would be reversed by the fusion.
+       * @functionPDG is the dependence graph of the function that includes both loops.
+       */
+      bool canFuseLoops (
+        LoopDependenceInfo const &first,
+        LoopDependenceInfo const &second,
+        PDG *functionPDG
+        );
+
+      /*
+       * Fuse the loop @second into the loop @first.
+       * The body of @second is executed right after the body of @first within the same iteration.
+       * Return false if the loops cannot be fused.
+       */
+      bool fuseLoops (
+        LoopDependenceInfo const &first,
+        LoopDependenceInfo const &second,
+        PDG *functionPDG,
+        std::set<Instruction *> &instructionsRemoved
+        );
+
+    private:
+
+      /*
+       * Methods
+       */
+      bool isLoopShapeSupported (
+        LoopDependenceInfo const &LDI
+        );
+
+      bool haveSameTripCount (
+        LoopDependenceInfo const &first,
+        LoopDependenceInfo const &second
+        );
+
+      bool isDefinedOutsideBothLoops (
+        Value *v,
+        LoopStructure *first,
+        LoopStructure *second
+        );
+
+      bool doAccessSameLocationInSameIteration (
+        Instruction *firstInst,
+        Instruction *secondInst,
+        LoopDependenceInfo const &first,
+        LoopDependenceInfo const &second
+        );
+
+      bool isDerivedFromGoverningIV (
+        Value *index,
+        LoopDependenceInfo const &LDI,
+        Instruction * &castInst
+        );
+  };
+
+}
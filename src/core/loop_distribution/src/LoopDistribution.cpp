@@ -33,16 +33,7 @@ bool LoopDistribution::splitLoop (
   std::set<Instruction *> &instructionsAdded
   ){
   std::set<Instruction *> Insts{};
-  for (auto SCCToPullOut : SCCsToPullOut) {
-    for (auto node : SCCToPullOut->getNodes()){
-      auto v = node->getT();
-      if (!isa<Instruction>(v)) {
-        continue;
-      }
-      auto i = cast<Instruction>(v);
-      Insts.insert(i);
-    }
-  }
+  this->collectInstructionsOfSCCs(SCCsToPullOut, Insts);
   bool modified = this->splitLoop(LDI, Insts, instructionsRemoved, instructionsAdded);
   return modified;
 }
@@ -69,37 +60,17 @@ bool LoopDistribution::splitLoop (
     assert(std::find(loopBBs.begin(), loopBBs.end(), parent) != loopBBs.end());
   }
   std::set<Instruction *> instsToClone{};
-
-  /*
-   * Require that all terminators in the loop are branches and collect instructions that
-   *   are dependencies of conditional branches
-   */
-  for (auto BB : loopStructure->getBasicBlocks()) {
-    if (auto branch = dyn_cast<BranchInst>(BB->getTerminator())) {
-      // errs () << "LoopDistribution: Branch instruction: " <<  *branch << "\n";
-      instsToClone.insert(branch);
-      this->recursivelyCollectDependencies(branch, instsToClone, LDI);
-
-    } else {
-      // errs() << "LoopDistribution: Abort: Non-branch terminator " << *BB->getTerminator() << "\n";
-      return false;
-    }
+  if (!this->collectInstructionsToClone(LDI, instsToPullOut, instsToClone)) {
+    return false;
   }
 
   /*
-   * Collect all sub-loop instructions and their dependencies. This does not capture sub-sub loops,
-   *   but those BBs should still be in the level 2 loops
+   * Collect all sub-loop basic blocks.
    */
   std::set<BasicBlock *> subLoopBBs{};
   for (auto childLoopStructure : loopStructure->getChildren()) {
-    // errs() << "LoopDistribution: New sub loop\n";
     for (auto &childBB : childLoopStructure->getBasicBlocks()) {
       subLoopBBs.insert(childBB);
-      for (auto &childI : *childBB) {
-        // errs() << "LoopDistribution: Sub loop instruction: " << childI << "\n";
-        instsToClone.insert(&childI);
-        this->recursivelyCollectDependencies(&childI, instsToClone, LDI);
-      }
     }
   }
 
@@ -171,6 +142,105 @@ bool LoopDistribution::splitLoop (
 }
 
 
+bool LoopDistribution::collectInstructionsToClone (
+  LoopDependenceInfo const &LDI,
+  std::set<SCC *> const &SCCsToPullOut,
+  std::set<Instruction *> &instsToClone
+  ){
+  std::set<Instruction *> instsToPullOut{};
+  this->collectInstructionsOfSCCs(SCCsToPullOut, instsToPullOut);
+  auto canBeSplit = this->collectInstructionsToClone(LDI, instsToPullOut, instsToClone);
+  return canBeSplit;
+}
+
+
+/*
+ * Collect the instructions that both loops need after a split: the control flow of the loop
+ *   and the sub-loop instructions that the instructions to pull out depend on
+ */
+bool LoopDistribution::collectInstructionsToClone (
+  LoopDependenceInfo const &LDI,
+  std::set<Instruction *> const &instsToPullOut,
+  std::set<Instruction *> &instsToClone
+  ){
+  auto loopStructure = LDI.getLoopStructure();
+
+  /*
+   * Require that all terminators in the loop are branches and collect instructions that
+   *   are dependencies of conditional branches
+   */
+  for (auto BB : loopStructure->getBasicBlocks()) {
+    if (auto branch = dyn_cast<BranchInst>(BB->getTerminator())) {
+      // errs () << "LoopDistribution: Branch instruction: " <<  *branch << "\n";
+      instsToClone.insert(branch);
+      this->recursivelyCollectDependencies(branch, instsToClone, LDI);
+
+    } else {
+      // errs() << "LoopDistribution: Abort: Non-branch terminator " << *BB->getTerminator() << "\n";
+      return false;
+    }
+  }
+
+  /*
+   * Collect the sub-loop instructions that the instructions to pull out depend on, and their dependencies.
+   *   The control flow of the sub-loops has already been collected, so the rest of the sub-loops stays in
+   *   the original loop only. This does not capture sub-sub loops, but those BBs should still be in the level 2 loops
+   */
+  std::set<BasicBlock *> subLoopBBs{};
+  for (auto childLoopStructure : loopStructure->getChildren()) {
+    for (auto &childBB : childLoopStructure->getBasicBlocks()) {
+      subLoopBBs.insert(childBB);
+    }
+  }
+  std::set<Instruction *> subLoopDependences{};
+  auto collectSubLoopDependence = [&subLoopBBs, &subLoopDependences](Value *from, DGEdge<Value> *dep) -> bool {
+    auto i = dyn_cast<Instruction>(from);
+    if (  true
+          && (i != nullptr)
+          && (subLoopBBs.find(i->getParent()) != subLoopBBs.end())
+       ){
+      subLoopDependences.insert(i);
+    }
+    return false;
+  };
+  auto pdg = LDI.getLoopDG();
+  for (auto inst : instsToPullOut) {
+    pdg->iterateOverDependencesTo(
+      inst,
+      false, // Control
+      true,  // Memory
+      true,  // Register
+      collectSubLoopDependence
+    );
+  }
+  for (auto subLoopI : subLoopDependences) {
+    // errs() << "LoopDistribution: Sub loop instruction: " << *subLoopI << "\n";
+    instsToClone.insert(subLoopI);
+    this->recursivelyCollectDependencies(subLoopI, instsToClone, LDI);
+  }
+
+  return true;
+}
+
+
+void LoopDistribution::collectInstructionsOfSCCs (
+  std::set<SCC *> const &SCCs,
+  std::set<Instruction *> &insts
+  ){
+  for (auto scc : SCCs) {
+    for (auto node : scc->getNodes()){
+      auto v = node->getT();
+      if (!isa<Instruction>(v)) {
+        continue;
+      }
+      auto i = cast<Instruction>(v);
+      insts.insert(i);
+    }
+  }
+  return ;
+}
+
+
 /*
  * Add every instruction that is a dependency of inst to the set toPopulate
  */
@@ -0,0 +1,509 @@
+/*
+ * Copyright 2020 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "LoopFusion.hpp"
+
+namespace llvm::noelle {
+
+LoopFusion::LoopFusion()
+  {
+
+  return ;
+}
+
+bool LoopFusion::canFuseLoops (
+  LoopDependenceInfo const &first,
+  LoopDependenceInfo const &second,
+  PDG *functionPDG
+  ){
+  assert(functionPDG != nullptr);
+  auto firstLS = first.getLoopStructure();
+  auto secondLS = second.getLoopStructure();
+
+  /*
+   * The two loops must be siblings of the same function.
+   */
+  if (  false
+        || (firstLS == secondLS)
+        || (firstLS->getFunction() != secondLS->getFunction())
+        || (firstLS->getNestingLevel() != secondLS->getNestingLevel())
+     ){
+    return false;
+  }
+
+  /*
+   * Check the shape of both loops.
+   */
+  if (  false
+        || (!this->isLoopShapeSupported(first))
+        || (!this->isLoopShapeSupported(second))
+     ){
+    return false;
+  }
+
+  /*
+   * The two loops must be adjacent: the only exit of the first loop must be the pre-header of the second one, and this pre-header must not include any code.
+   */
+  auto firstHeader = firstLS->getHeader();
+  auto secondHeader = secondLS->getHeader();
+  auto secondPreHeader = secondLS->getPreHeader();
+  auto firstExits = firstLS->getLoopExitBasicBlocks();
+  if (  false
+        || (firstExits[0] != secondPreHeader)
+        || (secondPreHeader->getSinglePredecessor() != firstHeader)
+        || (secondPreHeader->size() != 1)
+     ){
+    return false;
+  }
+  auto secondPreHeaderBr = dyn_cast<BranchInst>(secondPreHeader->getTerminator());
+  if (  false
+        || (secondPreHeaderBr == nullptr)
+        || (secondPreHeaderBr->isConditional())
+     ){
+    return false;
+  }
+
+  /*
+   * The two loops must execute the same number of iterations.
+   */
+  if (!this->haveSameTripCount(first, second)){
+    return false;
+  }
+
+  /*
+   * The header of the second loop becomes part of the body of the fused loop, which does not evaluate it at the last iteration.
+   * Hence, its instructions must not have side effects.
+   * Furthermore, the initial values of its PHIs must be available before the first loop starts.
+   */
+  for (auto &inst : *secondHeader){
+    if (auto phi = dyn_cast<PHINode>(&inst)){
+      auto initialValue = phi->getIncomingValueForBlock(secondPreHeader);
+      if (!this->isDefinedOutsideBothLoops(initialValue, firstLS, secondLS)){
+        return false;
+      }
+      continue ;
+    }
+    if (inst.mayHaveSideEffects()){
+      return false;
+    }
+  }
+
+  /*
+   * Check the register dependences.
+   *
+   * The second loop cannot consume values produced by the first one because it would observe the ones of the current iteration rather than the last ones.
+   * Furthermore, only the PHIs of the header of the second loop can be used outside it, because they are the only values that will be available when the fused loop exits.
+   */
+  for (auto bb : secondLS->getBasicBlocks()){
+    for (auto &inst : *bb){
+      for (auto &op : inst.operands()){
+        auto opInst = dyn_cast<Instruction>(op.get());
+        if (  true
+              && (opInst != nullptr)
+              && firstLS->isIncluded(opInst)
+           ){
+          return false;
+        }
+      }
+      if (  true
+            && isa<PHINode>(&inst)
+            && (bb == secondHeader)
+         ){
+        continue ;
+      }
+      for (auto user : inst.users()){
+        auto userInst = dyn_cast<Instruction>(user);
+        if (  false
+              || (userInst == nullptr)
+              || (!secondLS->isIncluded(userInst))
+           ){
+          return false;
+        }
+      }
+    }
+  }
+
+  /*
+   * Check the memory dependences between the two loops.
+   * After the fusion, an instruction of the second loop runs before the instructions of the first loop that belong to later iterations.
+   * Hence, the only dependences we can preserve are between instructions that access the same location at the same iteration, and no other location at other iterations.
+   */
+  for (auto bb : secondLS->getBasicBlocks()){
+    for (auto &inst : *bb){
+      if (!inst.mayReadOrWriteMemory()){
+        continue ;
+      }
+      auto secondInst = &inst;
+      auto isDependenceNotPreserved = [this, firstLS, secondInst, &first, &second](Value *v, DGEdge<Value> *dep) -> bool {
+        auto firstInst = dyn_cast<Instruction>(v);
+        if (  false
+              || (firstInst == nullptr)
+              || (!firstLS->isIncluded(firstInst))
+           ){
+          return false;
+        }
+        return !this->doAccessSameLocationInSameIteration(firstInst, secondInst, first, second);
+      };
+      if (functionPDG->iterateOverDependencesTo(secondInst, false, true, false, isDependenceNotPreserved)){
+        return false;
+      }
+      if (functionPDG->iterateOverDependencesFrom(secondInst, false, true, false, isDependenceNotPreserved)){
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool LoopFusion::fuseLoops (
+  LoopDependenceInfo const &first,
+  LoopDependenceInfo const &second,
+  PDG *functionPDG,
+  std::set<Instruction *> &instructionsRemoved
+  ){
+
+  /*
+   * Check if the loops can be fused.
+   */
+  if (!this->canFuseLoops(first, second, functionPDG)){
+    return false;
+  }
+
+  /*
+   * Fetch the basic blocks involved.
+   */
+  auto firstLS = first.getLoopStructure();
+  auto secondLS = second.getLoopStructure();
+  auto firstPreHeader = firstLS->getPreHeader();
+  auto firstHeader = firstLS->getHeader();
+  auto firstLatch = *firstLS->getLatches().begin();
+  auto secondPreHeader = secondLS->getPreHeader();
+  auto secondHeader = secondLS->getHeader();
+  auto secondLatch = *secondLS->getLatches().begin();
+  auto secondExit = secondLS->getLoopExitBasicBlocks()[0];
+  auto firstAttr = first.getLoopGoverningIVAttribution();
+  auto secondAttr = second.getLoopGoverningIVAttribution();
+  auto firstHeaderBr = firstAttr->getHeaderBrInst();
+  auto secondHeaderBr = secondAttr->getHeaderBrInst();
+  auto secondHeaderCmp = secondAttr->getHeaderCmpInst();
+  auto secondBodyEntry = (secondHeaderBr->getSuccessor(0) == secondExit) ? secondHeaderBr->getSuccessor(1) : secondHeaderBr->getSuccessor(0);
+
+  /*
+   * The back edge of the fused loop goes from the latch of the second loop to the header of the first one.
+   */
+  for (auto &phi : firstHeader->phis()){
+    auto idx = phi.getBasicBlockIndex(firstLatch);
+    assert(idx >= 0);
+    phi.setIncomingBlock(idx, secondLatch);
+  }
+
+  /*
+   * Move the PHIs of the second loop to the header of the fused loop.
+   */
+  std::vector<PHINode *> secondPHIs;
+  for (auto &phi : secondHeader->phis()){
+    secondPHIs.push_back(&phi);
+  }
+  for (auto phi : secondPHIs){
+    phi->moveBefore(firstHeader->getFirstNonPHI());
+    auto idx = phi->getBasicBlockIndex(secondPreHeader);
+    assert(idx >= 0);
+    phi->setIncomingBlock(idx, firstPreHeader);
+  }
+
+  /*
+   * Append the body of the second loop to the one of the first loop.
+   */
+  auto firstLatchBr = firstLatch->getTerminator();
+  for (auto idx = 0u; idx < firstLatchBr->getNumSuccessors(); idx++){
+    if (firstLatchBr->getSuccessor(idx) == firstHeader){
+      firstLatchBr->setSuccessor(idx, secondHeader);
+    }
+  }
+  auto secondLatchBr = secondLatch->getTerminator();
+  for (auto idx = 0u; idx < secondLatchBr->getNumSuccessors(); idx++){
+    if (secondLatchBr->getSuccessor(idx) == secondHeader){
+      secondLatchBr->setSuccessor(idx, firstHeader);
+    }
+  }
+
+  /*
+   * The latch of the second loop is now the latch of the fused loop, which is the first loop.
+   * Hence, the loop metadata (e.g., llvm.loop) of the second loop does not apply anymore, and the one of the first loop moves to the new back edge.
+   */
+  auto firstLoopMetadata = firstLatchBr->getMetadata(LLVMContext::MD_loop);
+  firstLatchBr->setMetadata(LLVMContext::MD_loop, nullptr);
+  secondLatchBr->setMetadata(LLVMContext::MD_loop, firstLoopMetadata);
+
+  /*
+   * The header of the second loop does not need to evaluate the exit condition anymore.
+   */
+  BranchInst::Create(secondBodyEntry, secondHeaderBr);
+  instructionsRemoved.insert(secondHeaderBr);
+  secondHeaderBr->eraseFromParent();
+  if (secondHeaderCmp->use_empty()){
+    instructionsRemoved.insert(secondHeaderCmp);
+    secondHeaderCmp->eraseFromParent();
+  }
+
+  /*
+   * The fused loop exits where the second loop used to exit.
+   */
+  for (auto idx = 0u; idx < firstHeaderBr->getNumSuccessors(); idx++){
+    if (firstHeaderBr->getSuccessor(idx) == secondPreHeader){
+      firstHeaderBr->setSuccessor(idx, secondExit);
+    }
+  }
+  for (auto &phi : secondExit->phis()){
+    auto idx = phi.getBasicBlockIndex(secondHeader);
+    while (idx >= 0){
+      phi.setIncomingBlock(idx, firstHeader);
+      idx = phi.getBasicBlockIndex(secondHeader);
+    }
+  }
+
+  /*
+   * The pre-header of the second loop is now unreachable.
+   */
+  instructionsRemoved.insert(secondPreHeader->getTerminator());
+  secondPreHeader->eraseFromParent();
+
+  errs() << "LoopFusion: Success: Finished fusion in " << firstLS->getFunction()->getName() << "\n";
+  return true;
+}
+
+/*
+ * Check if the loop is governed by an induction variable evaluated only at the header, it has a single latch, and it has a single exit.
+ */
+bool LoopFusion::isLoopShapeSupported (
+  LoopDependenceInfo const &LDI
+  ){
+  auto ls = LDI.getLoopStructure();
+
+  /*
+   * The loop must be governed by an induction variable.
+   */
+  auto attr = LDI.getLoopGoverningIVAttribution();
+  if (  false
+        || (attr == nullptr)
+        || (!attr->isSCCContainingIVWellFormed())
+     ){
+    return false;
+  }
+
+  /*
+   * The loop must have a pre-header, a single latch that is not the header, and a single exit reached from the header.
+   */
+  auto header = ls->getHeader();
+  auto latches = ls->getLatches();
+  if (  false
+        || (ls->getPreHeader() == nullptr)
+        || (latches.size() != 1)
+        || (*latches.begin() == header)
+        || (ls->numberOfExitBasicBlocks() != 1)
+        || (ls->getLoopExitBasicBlocks()[0] != attr->getExitBlockFromHeader())
+     ){
+    return false;
+  }
+  for (auto bb : ls->getBasicBlocks()){
+    if (bb == header){
+      continue ;
+    }
+    auto terminator = bb->getTerminator();
+    if (!isa<BranchInst>(terminator)){
+      return false;
+    }
+    for (auto succ : successors(bb)){
+      if (!ls->isIncluded(succ)){
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Check if the governing induction variables of the two loops start from the same value, they have the same step, and they are compared against the same value in the same way.
+ */
+bool LoopFusion::haveSameTripCount (
+  LoopDependenceInfo const &first,
+  LoopDependenceInfo const &second
+  ){
+  auto firstLS = first.getLoopStructure();
+  auto secondLS = second.getLoopStructure();
+  auto firstAttr = first.getLoopGoverningIVAttribution();
+  auto secondAttr = second.getLoopGoverningIVAttribution();
+  auto &firstIV = firstAttr->getInductionVariable();
+  auto &secondIV = secondAttr->getInductionVariable();
+
+  /*
+   * Check the evolution of the induction variables.
+   */
+  auto firstStart = firstIV.getStartValue();
+  auto secondStart = secondIV.getStartValue();
+  if (  false
+        || (firstStart != secondStart)
+        || (!this->isDefinedOutsideBothLoops(firstStart, firstLS, secondLS))
+        || (firstIV.getSingleComputedStepValue() != secondIV.getSingleComputedStepValue())
+        || (firstIV.getLoopEntryPHI()->getType() != secondIV.getLoopEntryPHI()->getType())
+     ){
+    return false;
+  }
+
+  /*
+   * Check the exit conditions.
+   */
+  auto firstCmp = firstAttr->getHeaderCmpInst();
+  auto secondCmp = secondAttr->getHeaderCmpInst();
+  auto firstBound = firstAttr->getHeaderCmpInstConditionValue();
+  auto secondBound = secondAttr->getHeaderCmpInstConditionValue();
+  if (  false
+        || (firstCmp->getPredicate() != secondCmp->getPredicate())
+        || (firstBound != secondBound)
+        || (!this->isDefinedOutsideBothLoops(firstBound, firstLS, secondLS))
+        || ((firstCmp->getOperand(0) == firstBound) != (secondCmp->getOperand(0) == secondBound))
+     ){
+    return false;
+  }
+  auto firstExitIndex = (firstAttr->getHeaderBrInst()->getSuccessor(0) == firstAttr->getExitBlockFromHeader()) ? 0 : 1;
+  auto secondExitIndex = (secondAttr->getHeaderBrInst()->getSuccessor(0) == secondAttr->getExitBlockFromHeader()) ? 0 : 1;
+  if (firstExitIndex != secondExitIndex){
+    return false;
+  }
+
+  return true;
+}
+
+bool LoopFusion::isDefinedOutsideBothLoops (
+  Value *v,
+  LoopStructure *first,
+  LoopStructure *second
+  ){
+  auto inst = dyn_cast<Instruction>(v);
+  if (inst == nullptr){
+    return true;
+  }
+  if (  false
+        || first->isIncluded(inst)
+        || second->isIncluded(inst)
+     ){
+    return false;
+  }
+
+  return true;
+}
+
+/*
+ * Check if the two memory instructions access the element of the same object that is selected by the governing induction variables.
+ * Because the induction variables have the same value at the same iteration and their step is not zero, every iteration accesses a different element.
+ */
+bool LoopFusion::doAccessSameLocationInSameIteration (
+  Instruction *firstInst,
+  Instruction *secondInst,
+  LoopDependenceInfo const &first,
+  LoopDependenceInfo const &second
+  ){
+  auto firstLS = first.getLoopStructure();
+  auto secondLS = second.getLoopStructure();
+
+  /*
+   * Fetch the addresses accessed.
+   */
+  auto firstPtr = getLoadStorePointerOperand(firstInst);
+  auto secondPtr = getLoadStorePointerOperand(secondInst);
+  if (  false
+        || (firstPtr == nullptr)
+        || (secondPtr == nullptr)
+     ){
+    return false;
+  }
+  auto firstGEP = dyn_cast<GetElementPtrInst>(firstPtr);
+  auto secondGEP = dyn_cast<GetElementPtrInst>(secondPtr);
+  if (  false
+        || (firstGEP == nullptr)
+        || (secondGEP == nullptr)
+        || (firstGEP->getPointerOperand() != secondGEP->getPointerOperand())
+        || (!this->isDefinedOutsideBothLoops(firstGEP->getPointerOperand(), firstLS, secondLS))
+        || (firstGEP->getSourceElementType() != secondGEP->getSourceElementType())
+        || (firstGEP->getNumIndices() != secondGEP->getNumIndices())
+     ){
+    return false;
+  }
+
+  /*
+   * Compare the indices.
+   */
+  auto isIndexedByIV = false;
+  for (auto idx = 1u; idx < firstGEP->getNumOperands(); idx++){
+    auto firstIndex = firstGEP->getOperand(idx);
+    auto secondIndex = secondGEP->getOperand(idx);
+
+    /*
+     * Check if the indices are the same loop invariant.
+     */
+    if (firstIndex == secondIndex){
+      if (!this->isDefinedOutsideBothLoops(firstIndex, firstLS, secondLS)){
+        return false;
+      }
+      continue ;
+    }
+
+    /*
+     * Check if the indices are the governing induction variables of the two loops.
+     */
+    Instruction *firstCast = nullptr;
+    Instruction *secondCast = nullptr;
+    if (  false
+          || (!this->isDerivedFromGoverningIV(firstIndex, first, firstCast))
+          || (!this->isDerivedFromGoverningIV(secondIndex, second, secondCast))
+       ){
+      return false;
+    }
+    if ((firstCast == nullptr) != (secondCast == nullptr)){
+      return false;
+    }
+    if (  true
+          && (firstCast != nullptr)
+          && (  false
+                || (firstCast->getOpcode() != secondCast->getOpcode())
+                || (firstCast->getType() != secondCast->getType())
+             )
+       ){
+      return false;
+    }
+    isIndexedByIV = true;
+  }
+
+  return isIndexedByIV;
+}
+
+bool LoopFusion::isDerivedFromGoverningIV (
+  Value *index,
+  LoopDependenceInfo const &LDI,
+  Instruction * &castInst
+  ){
+  auto phi = LDI.getLoopGoverningIVAttribution()->getInductionVariable().getLoopEntryPHI();
+  if (index == phi){
+    castInst = nullptr;
+    return true;
+  }
+  if (auto cast = dyn_cast<CastInst>(index)){
+    if (cast->getOperand(0) == phi){
+      castInst = cast;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}
@@ -79,12 +79,18 @@ namespace llvm::noelle {
     /*
      * Reduce live out variables given binary operators to reduce
      * with and initial values to start at
+     *
+     * Variables reduced with Instruction::Select are min/max: @minMaxPredicates holds the predicate P that picks a private copy x over the accumulated value v when P(x, v) holds.
+     * Variables in @indicesOfMinMax are the positions of a min/max (e.g., argmin): each is mapped to the environment index of its min/max
+     * and to whether the smallest position is kept when min/max values are equal.
      */
     BasicBlock * reduceLiveOutVariables (
       BasicBlock *bb,
       IRBuilder<>,
       std::unordered_map<int, int> &reducableBinaryOps,
       std::unordered_map<int, Value *> &initialValues,
+      std::unordered_map<int, CmpInst::Predicate> &minMaxPredicates,
+      std::unordered_map<int, std::pair<int, bool>> &indicesOfMinMax,
       Value *numberOfThreadsExecuted
     );
 
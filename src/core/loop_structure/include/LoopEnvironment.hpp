@@ -46,6 +46,11 @@ namespace llvm::noelle {
 
       uint64_t addLiveInValue (Value *newLiveInValue, const std::unordered_set<Instruction *> &consumers);
 
+      /*
+       * Add a live-out value that is not used after the loop (e.g., a value needed to reduce other live-out values).
+       */
+      uint64_t addLiveOutValue (Value *newLiveOutValue);
+
     private:
       uint64_t addLiveInProducer (Value *producer);
       void addLiveOutProducer (Value *producer);
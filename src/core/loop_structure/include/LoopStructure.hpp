@@ -17,6 +17,38 @@ namespace llvm::noelle {
   class LoopStructure {
     public:
 
+      /*
+       * Iterator over the instructions of the loop that walks its basic blocks in place.
+       */
+      class InstructionIterator {
+        public:
+          using iterator_category = std::forward_iterator_tag;
+          using value_type = Instruction *;
+          using difference_type = std::ptrdiff_t;
+          using pointer = Instruction **;
+          using reference = Instruction *;
+
+          InstructionIterator (
+            std::vector<BasicBlock *>::const_iterator bbIt,
+            std::vector<BasicBlock *>::const_iterator bbEnd
+            );
+
+          Instruction * operator* (void) const ;
+
+          InstructionIterator & operator++ (void) ;
+
+          bool operator== (const InstructionIterator &other) const ;
+
+          bool operator!= (const InstructionIterator &other) const ;
+
+        private:
+          std::vector<BasicBlock *>::const_iterator bbIt;
+          std::vector<BasicBlock *>::const_iterator bbEnd;
+          BasicBlock::iterator instIt;
+
+          void skipEmptyBasicBlocks (void) ;
+      };
+
       LoopStructure (
         Loop *l
         );
@@ -57,6 +89,14 @@ namespace llvm::noelle {
       std::unordered_set<BasicBlock *> getBasicBlocks (void) const ;
 
       std::unordered_set<Instruction *> getInstructions (void) const ;
+
+      /*
+       * Iterate over the basic blocks and the instructions of the loop without copying them.
+       * The loop must not be modified while iterating.
+       */
+      iterator_range<std::vector<BasicBlock *>::const_iterator> blocks (void) const ;
+
+      iterator_range<InstructionIterator> instructions (void) const ;
       
       uint64_t getNumberOfInstructions (void) const ;
 
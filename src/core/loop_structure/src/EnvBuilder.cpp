@@ -325,6 +325,8 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
   IRBuilder<> builder,
   std::unordered_map<int, int> &reducableBinaryOps,
   std::unordered_map<int, Value *> &initialValues,
+  std::unordered_map<int, CmpInst::Predicate> &minMaxPredicates,
+  std::unordered_map<int, std::pair<int, bool>> &indicesOfMinMax,
   Value *numberOfThreadsExecuted
 ) {
 
@@ -373,6 +375,7 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
    * Add the PHI nodes about the current accumulated value
    */
   std::vector<PHINode *> phiNodes;
+  std::unordered_map<int, uint32_t> envIndexToPosition;
   auto count = 0;
   for (auto envIndexInitValue : initialValues) {
     auto envIndex = envIndexInitValue.first;
@@ -392,6 +395,7 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
     /*
      * Keep track of the PHI node just created.
      */
+    envIndexToPosition[envIndex] = phiNodes.size();
     phiNodes.push_back(phiNode);
   }
 
@@ -458,7 +462,52 @@ BasicBlock * EnvBuilder::reduceLiveOutVariables (
      * Accumulate values to the accumulator of the current reduced variable.
      */
     auto privateCurrentCopy = loadedValues[count];
-    auto newAccumulatorValue = loopBodyBuilder.CreateBinOp(binOp, accumVal, privateCurrentCopy);
+    Value *newAccumulatorValue = nullptr;
+    if (indicesOfMinMax.find(envIndex) != indicesOfMinMax.end()){
+
+      /*
+       * The variable is the position of a min/max.
+       * Pick the position of the private copy if its min/max wins, and break ties between equal min/max values by position.
+       */
+      auto minMaxEnvIndex = indicesOfMinMax[envIndex].first;
+      auto keepSmallestPosition = indicesOfMinMax[envIndex].second;
+      auto minMaxPosition = envIndexToPosition.at(minMaxEnvIndex);
+      auto minMaxAccumVal = phiNodes[minMaxPosition];
+      auto minMaxPrivateCopy = loadedValues[minMaxPosition];
+      auto predicate = minMaxPredicates.at(minMaxEnvIndex);
+      Value *isPrivateCopyPicked = nullptr;
+      Value *isTie = nullptr;
+      if (CmpInst::isFPPredicate(predicate)){
+        isPrivateCopyPicked = loopBodyBuilder.CreateFCmp(predicate, minMaxPrivateCopy, minMaxAccumVal);
+        isTie = loopBodyBuilder.CreateFCmpOEQ(minMaxPrivateCopy, minMaxAccumVal);
+      } else {
+        isPrivateCopyPicked = loopBodyBuilder.CreateICmp(predicate, minMaxPrivateCopy, minMaxAccumVal);
+        isTie = loopBodyBuilder.CreateICmpEQ(minMaxPrivateCopy, minMaxAccumVal);
+      }
+      isPrivateCopyPicked = loopBodyBuilder.CreateAnd(isPrivateCopyPicked, loopBodyBuilder.CreateNot(isTie));
+      auto isPrivateCopyPositionFirst = loopBodyBuilder.CreateICmpSLT(privateCurrentCopy, accumVal);
+      auto firstPosition = loopBodyBuilder.CreateSelect(isPrivateCopyPositionFirst, privateCurrentCopy, accumVal);
+      auto lastPosition = loopBodyBuilder.CreateSelect(isPrivateCopyPositionFirst, accumVal, privateCurrentCopy);
+      auto tiePosition = loopBodyBuilder.CreateSelect(isTie, keepSmallestPosition ? firstPosition : lastPosition, accumVal);
+      newAccumulatorValue = loopBodyBuilder.CreateSelect(isPrivateCopyPicked, privateCurrentCopy, tiePosition);
+
+    } else if (minMaxPredicates.find(envIndex) != minMaxPredicates.end()){
+
+      /*
+       * The variable is a min/max.
+       */
+      auto predicate = minMaxPredicates[envIndex];
+      Value *isPrivateCopyPicked = nullptr;
+      if (CmpInst::isFPPredicate(predicate)){
+        isPrivateCopyPicked = loopBodyBuilder.CreateFCmp(predicate, privateCurrentCopy, accumVal);
+      } else {
+        isPrivateCopyPicked = loopBodyBuilder.CreateICmp(predicate, privateCurrentCopy, accumVal);
+      }
+      newAccumulatorValue = loopBodyBuilder.CreateSelect(isPrivateCopyPicked, privateCurrentCopy, accumVal);
+
+    } else {
+      newAccumulatorValue = loopBodyBuilder.CreateBinOp(binOp, accumVal, privateCurrentCopy);
+    }
 
     /*
      * Keep track of the new accumulator value.
@@ -146,6 +146,10 @@ uint64_t LoopEnvironment::addLiveInValue (Value *newLiveInValue, const std::unor
   return newIndex;
 }
 
+uint64_t LoopEnvironment::addLiveOutValue (Value *newLiveOutValue){
+  return this->addProducer(newLiveOutValue, false);
+}
+
 bool LoopEnvironment::isProducer (Value *producer) const {
   return producerIndexMap.find(producer) != producerIndexMap.end();
 }
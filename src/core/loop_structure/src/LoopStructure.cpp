@@ -152,6 +152,17 @@ std::unordered_set<Instruction *> LoopStructure::getInstructions (void) const {
   return insts;
 }
       
+iterator_range<std::vector<BasicBlock *>::const_iterator> LoopStructure::blocks (void) const {
+  return make_range(this->orderedBBs.cbegin(), this->orderedBBs.cend());
+}
+
+iterator_range<LoopStructure::InstructionIterator> LoopStructure::instructions (void) const {
+  InstructionIterator begin{this->orderedBBs.cbegin(), this->orderedBBs.cend()};
+  InstructionIterator end{this->orderedBBs.cend(), this->orderedBBs.cend()};
+
+  return make_range(begin, end);
+}
+
 uint64_t LoopStructure::getNumberOfInstructions (void) const {
   uint64_t t = 0;
   for (auto bb : this->bbs){
@@ -293,4 +304,65 @@ uint64_t LoopStructure::numberOfExitBasicBlocks (void) const {
   return this->exitBlocks.size();
 }
 
+LoopStructure::InstructionIterator::InstructionIterator (
+  std::vector<BasicBlock *>::const_iterator bbIt,
+  std::vector<BasicBlock *>::const_iterator bbEnd
+  ) : bbIt{bbIt}, bbEnd{bbEnd}
+  {
+  if (this->bbIt != this->bbEnd){
+    this->instIt = (*this->bbIt)->begin();
+    this->skipEmptyBasicBlocks();
+  }
+
+  return ;
+}
+
+Instruction * LoopStructure::InstructionIterator::operator* (void) const {
+  return &*this->instIt;
+}
+
+LoopStructure::InstructionIterator & LoopStructure::InstructionIterator::operator++ (void) {
+  ++this->instIt;
+  this->skipEmptyBasicBlocks();
+
+  return *this;
+}
+
+bool LoopStructure::InstructionIterator::operator== (const InstructionIterator &other) const {
+  if (this->bbIt != other.bbIt){
+    return false;
+  }
+
+  /*
+   * Iterators at the end do not point to any instruction.
+   */
+  if (this->bbIt == this->bbEnd){
+    return true;
+  }
+
+  return this->instIt == other.instIt;
+}
+
+bool LoopStructure::InstructionIterator::operator!= (const InstructionIterator &other) const {
+  return !(*this == other);
+}
+
+void LoopStructure::InstructionIterator::skipEmptyBasicBlocks (void) {
+
+  /*
+   * Move to the first instruction of the next basic block when the current one has been fully visited.
+   */
+  while (  true
+           && (this->bbIt != this->bbEnd)
+           && (this->instIt == (*this->bbIt)->end())
+        ){
+    ++this->bbIt;
+    if (this->bbIt != this->bbEnd){
+      this->instIt = (*this->bbIt)->begin();
+    }
+  }
+
+  return ;
+}
+
 }
@@ -13,6 +13,7 @@
 #include "SystemHeaders.hpp"
 #include "LoopDependenceInfo.hpp"
 #include "SCC.hpp"
+#include "llvm/Analysis/DependenceAnalysis.h"
 
 namespace llvm::noelle {
 
@@ -35,6 +36,33 @@ namespace llvm::noelle {
         AssumptionCache &AC
         );
 
+      /*
+       * Unroll the loop @unrollFactor times.
+       * The remaining iterations (when the trip count is not a multiple of @unrollFactor) are handled based on how the loop governing induction variable controls the exit of the loop.
+       */
+      bool partiallyUnrollLoop (
+        LoopDependenceInfo const &LDI,
+        uint32_t unrollFactor,
+        LoopInfo &LI,
+        DominatorTree &DT,
+        ScalarEvolution &SE,
+        AssumptionCache &AC
+        );
+
+      /*
+       * Unroll the loop @unrollFactor times and jam the copies of its only sub-loop into a single one.
+       * The remaining iterations of the outer loop are executed by an epilogue loop.
+       */
+      bool unrollAndJamLoop (
+        LoopDependenceInfo const &LDI,
+        uint32_t unrollFactor,
+        LoopInfo &LI,
+        DominatorTree &DT,
+        ScalarEvolution &SE,
+        AssumptionCache &AC,
+        DependenceInfo &DI
+        );
+
     private:
 
       /*
@@ -44,6 +72,11 @@ namespace llvm::noelle {
       /*
        * Methods
        */
+      uint32_t computeTripMultiple (
+        LoopDependenceInfo const &LDI,
+        Loop *llvmLoop,
+        ScalarEvolution &SE
+        );
 
   };
 
@@ -96,3 +96,221 @@ bool LoopUnroll::fullyUnrollLoop (
 
   return modified;
 }
+
+bool LoopUnroll::partiallyUnrollLoop (
+  LoopDependenceInfo const &LDI,
+  uint32_t unrollFactor,
+  LoopInfo &LI,
+  DominatorTree &DT,
+  ScalarEvolution &SE,
+  AssumptionCache &AC
+  ){
+  if (unrollFactor < 2){
+    return false;
+  }
+
+  /*
+   * Fetch the LLVM loop.
+   */
+  auto ls = LDI.getLoopStructure();
+  auto loopFunction = ls->getFunction();
+  auto llvmLoop = LI.getLoopFor(ls->getHeader());
+  if (  false
+        || (llvmLoop == nullptr)
+        || (llvmLoop->getHeader() != ls->getHeader())
+     ){
+    return false;
+  }
+
+  /*
+   * Fetch the trip count, if it is known at compile time.
+   */
+  uint32_t tripCount = 0;
+  if (LDI.doesHaveCompileTimeKnownTripCount()){
+    tripCount = LDI.getCompileTimeTripCount();
+    if (tripCount <= unrollFactor){
+
+      /*
+       * The loop should be fully unrolled instead.
+       */
+      return false;
+    }
+  }
+  auto tripMultiple = this->computeTripMultiple(LDI, llvmLoop, SE);
+
+  /*
+   * Decide how to execute the remaining iterations.
+   *
+   * If the trip count is a multiple of the unroll factor, there is no remainder and the unrolled copies do not need to check the exit condition.
+   * Otherwise, if the exit of the loop is controlled by the loop governing induction variable in the header, every unrolled copy keeps its own check of the governing condition.
+   * The remaining iterations therefore leave the loop from the copy that reaches the bound, without needing an epilogue loop.
+   * Otherwise, an epilogue loop is generated to execute the remaining iterations (this requires the trip count to be computable at run time).
+   */
+  auto needsEpilogue = false;
+  if ((tripMultiple % unrollFactor) != 0){
+    auto loopGoverningIVAttr = LDI.getLoopGoverningIVAttribution();
+    if (  false
+          || (loopGoverningIVAttr == nullptr)
+          || (!loopGoverningIVAttr->isSCCContainingIVWellFormed())
+       ){
+      needsEpilogue = true;
+    }
+  }
+
+  /*
+   * Try to unroll the loop
+   */
+  UnrollLoopOptions opts;
+  opts.Count = unrollFactor;
+  opts.TripCount = tripCount;
+  opts.Force = false;
+  opts.AllowRuntime = needsEpilogue;
+  opts.AllowExpensiveTripCount = false;
+  opts.PreserveCondBr = false;
+  opts.TripMultiple = tripMultiple;
+  opts.PeelCount = 0;
+  opts.UnrollRemainder = false;
+  opts.ForgetAllSCEV = false;
+  OptimizationRemarkEmitter ORE(loopFunction);
+  auto unrolled = UnrollLoop(
+    llvmLoop, opts, 
+    &LI, &SE, &DT, &AC, &ORE, 
+    true);
+
+  /*
+   * Check if the loop unrolled.
+   */
+  auto modified = false;
+  switch (unrolled){
+    case LoopUnrollResult::FullyUnrolled :
+      errs() << "   Fully unrolled\n";
+      modified = true;
+      break ;
+
+    case LoopUnrollResult::PartiallyUnrolled :
+      errs() << "   Partially unrolled " << unrollFactor << " times\n";
+      modified = true;
+      break ;
+
+    case LoopUnrollResult::Unmodified :
+      errs() << "   Not unrolled\n";
+      modified = false;
+      break ;
+
+    default:
+      abort();
+  }
+
+  return modified;
+}
+
+bool LoopUnroll::unrollAndJamLoop (
+  LoopDependenceInfo const &LDI,
+  uint32_t unrollFactor,
+  LoopInfo &LI,
+  DominatorTree &DT,
+  ScalarEvolution &SE,
+  AssumptionCache &AC,
+  DependenceInfo &DI
+  ){
+  if (unrollFactor < 2){
+    return false;
+  }
+
+  /*
+   * The loop must include exactly one sub-loop to jam.
+   */
+  auto ls = LDI.getLoopStructure();
+  if (ls->getChildren().size() != 1){
+    return false;
+  }
+
+  /*
+   * Fetch the LLVM loop.
+   */
+  auto loopFunction = ls->getFunction();
+  auto llvmLoop = LI.getLoopFor(ls->getHeader());
+  if (  false
+        || (llvmLoop == nullptr)
+        || (llvmLoop->getHeader() != ls->getHeader())
+     ){
+    return false;
+  }
+
+  /*
+   * Check that the iterations of the outer loop can be interleaved within the sub-loop.
+   */
+  if (!isSafeToUnrollAndJam(llvmLoop, SE, DT, DI)){
+    return false;
+  }
+
+  /*
+   * Fetch the trip count.
+   */
+  uint32_t tripCount = 0;
+  if (LDI.doesHaveCompileTimeKnownTripCount()){
+    tripCount = LDI.getCompileTimeTripCount();
+    if (tripCount < unrollFactor){
+      return false;
+    }
+  }
+  auto tripMultiple = this->computeTripMultiple(LDI, llvmLoop, SE);
+
+  /*
+   * Unroll and jam.
+   */
+  OptimizationRemarkEmitter ORE(loopFunction);
+  auto unrolled = UnrollAndJamLoop(
+    llvmLoop, unrollFactor, tripCount, tripMultiple, 
+    false,
+    &LI, &SE, &DT, &AC, &ORE);
+
+  /*
+   * Check if the loop unrolled.
+   */
+  auto modified = false;
+  switch (unrolled){
+    case LoopUnrollResult::FullyUnrolled :
+    case LoopUnrollResult::PartiallyUnrolled :
+      errs() << "   Unrolled and jammed " << unrollFactor << " times\n";
+      modified = true;
+      break ;
+
+    case LoopUnrollResult::Unmodified :
+      errs() << "   Not unrolled and jammed\n";
+      modified = false;
+      break ;
+
+    default:
+      abort();
+  }
+
+  return modified;
+}
+
+/*
+ * Compute the largest known number that divides the trip count of the loop.
+ */
+uint32_t LoopUnroll::computeTripMultiple (
+  LoopDependenceInfo const &LDI,
+  Loop *llvmLoop,
+  ScalarEvolution &SE
+  ){
+
+  /*
+   * Check if the trip count is known at compile time.
+   */
+  if (LDI.doesHaveCompileTimeKnownTripCount()){
+    return LDI.getCompileTimeTripCount();
+  }
+
+  /*
+   * Rely on the scalar evolution.
+   */
+  auto tripMultiple = SE.getSmallConstantTripMultiple(llvmLoop);
+  if (tripMultiple == 0){
+    return 1;
+  }
+
+  return tripMultiple;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2020 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+#include "Noelle.hpp"
+#include "llvm/Analysis/ScalarEvolutionExpander.h"
+
+namespace llvm::noelle {
+
+  class LoopVersioner {
+    public:
+
+      /*
+       * Methods
+       */
+      LoopVersioner (Noelle &noelle);
+
+      /*
+       * Version the loop given as input to remove the loop-carried memory dependences of the SCCs given as input.
+       *
+       * These dependences exist only because the alias analyses cannot disprove aliasing between the pointers involved.
+       * A runtime check emitted in the pre-header verifies that the memory ranges accessed by these instructions across all iterations are disjoint.
+       * If they are, the execution jumps to a clone of the loop where such memory accesses are tagged as not aliasing each other.
+       * Otherwise, the original loop is executed.
+       *
+       * Return true if the loop has been versioned.
+       */
+      bool versionLoopToRemoveMemoryDependences (
+        LoopDependenceInfo &LDI,
+        std::unordered_set<SCC *> const &SCCs,
+        LoopInfo &LI,
+        DominatorTree &DT,
+        ScalarEvolution &SE
+      );
+
+      /*
+       * Return true if the loop given as input has been generated by versioning a loop.
+       */
+      bool isVersionedLoop (
+        LoopStructure &loop
+      ) const ;
+
+    private:
+
+      /*
+       * Fields
+       */
+      Noelle &noelle;
+      uint32_t maximumNumberOfChecks;
+      std::string outputPrefix;
+
+      /*
+       * Methods
+       */
+      bool collectMemoryInstructionsToCheck (
+        LoopDependenceInfo &LDI,
+        std::unordered_set<SCC *> const &SCCs,
+        std::vector<std::pair<Instruction *, Instruction *>> &pairsToCheck
+      ) const ;
+
+      bool areLoopValuesUsedOnlyByExitPHIs (
+        LoopStructure &loop
+      ) const ;
+
+      Value * emitOverlapCheck (
+        Instruction *insertPoint,
+        std::vector<std::pair<Instruction *, Instruction *>> const &pairsToCheck,
+        std::unordered_map<Instruction *, std::pair<const SCEV *, const SCEV *>> const &ranges,
+        ScalarEvolution &SE
+      ) const ;
+
+      void tagAccessesAsNotAliasing (
+        std::vector<std::pair<Instruction *, Instruction *>> const &pairsToCheck,
+        ValueToValueMapTy &cloneMap
+      ) const ;
+  };
+
+}
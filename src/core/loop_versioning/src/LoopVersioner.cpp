@@ -0,0 +1,398 @@
+/*
+ * Copyright 2020 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "LoopVersioner.hpp"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/MDBuilder.h"
+
+namespace llvm::noelle {
+
+  static const char *VERSIONED_LOOP_METADATA = "noelle.loop.versioned";
+
+  LoopVersioner::LoopVersioner (Noelle &noelle)
+    : noelle{noelle}
+    , maximumNumberOfChecks{16}
+    , outputPrefix{"LoopVersioner: "}
+    {
+    return ;
+  }
+
+  bool LoopVersioner::isVersionedLoop (
+    LoopStructure &loop
+  ) const {
+    auto headerTerminator = loop.getHeader()->getTerminator();
+
+    return headerTerminator->getMetadata(VERSIONED_LOOP_METADATA) != nullptr;
+  }
+
+  bool LoopVersioner::versionLoopToRemoveMemoryDependences (
+    LoopDependenceInfo &LDI,
+    std::unordered_set<SCC *> const &SCCs,
+    LoopInfo &LI,
+    DominatorTree &DT,
+    ScalarEvolution &SE
+  ) {
+
+    /*
+     * Fetch the loop.
+     */
+    auto loopStructure = LDI.getLoopStructure();
+    auto header = loopStructure->getHeader();
+    auto preHeader = loopStructure->getPreHeader();
+    auto loop = LI.getLoopFor(header);
+    if (  false
+          || (loop == nullptr)
+          || (loop->getHeader() != header)
+          || (preHeader == nullptr)
+       ){
+      return false;
+    }
+
+    /*
+     * Versioning a loop twice would keep cloning the original one.
+     */
+    if (this->isVersionedLoop(*loopStructure)){
+      return false;
+    }
+
+    /*
+     * The clone is meant to be parallelized by DOALL, which needs the loop-governing IV.
+     */
+    if (LDI.getLoopGoverningIVAttribution() == nullptr){
+      return false;
+    }
+
+    /*
+     * Collect the pairs of memory instructions whose dependences block the parallelization.
+     */
+    std::vector<std::pair<Instruction *, Instruction *>> pairsToCheck;
+    if (!this->collectMemoryInstructionsToCheck(LDI, SCCs, pairsToCheck)){
+      return false;
+    }
+    if (  false
+          || (pairsToCheck.size() == 0)
+          || (pairsToCheck.size() > this->maximumNumberOfChecks)
+       ){
+      return false;
+    }
+
+    /*
+     * Compute the ranges of memory accessed by these instructions across all iterations.
+     * They must be computable in the pre-header.
+     */
+    auto domainSpaceAnalysis = LDI.getLoopIterationDomainSpaceAnalysis();
+    auto preHeaderTerminator = preHeader->getTerminator();
+    std::unordered_map<Instruction *, std::pair<const SCEV *, const SCEV *>> ranges;
+    for (auto pair : pairsToCheck){
+      for (auto memoryInst : { pair.first, pair.second }){
+        if (ranges.find(memoryInst) != ranges.end()){
+          continue ;
+        }
+        const SCEV *rangeStart = nullptr;
+        const SCEV *rangeEnd = nullptr;
+        if (!domainSpaceAnalysis->computeRangeOfAccessedMemoryAcrossIterations(memoryInst, loop, SE, rangeStart, rangeEnd)){
+          return false;
+        }
+        if (  false
+              || !isSafeToExpandAt(rangeStart, preHeaderTerminator, SE)
+              || !isSafeToExpandAt(rangeEnd, preHeaderTerminator, SE)
+           ){
+          return false;
+        }
+        ranges[memoryInst] = std::make_pair(rangeStart, rangeEnd);
+      }
+    }
+
+    /*
+     * Values computed within the loop and used outside must flow through the PHIs of the exit blocks.
+     * This way, merging the two versions of the loop only requires extending these PHIs.
+     */
+    if (!this->areLoopValuesUsedOnlyByExitPHIs(*loopStructure)){
+      return false;
+    }
+    errs() << this->outputPrefix << "Version the loop with " << pairsToCheck.size() << " runtime alias checks\n";
+
+    /*
+     * Fetch the exit edges of the original loop.
+     */
+    SmallVector<std::pair<BasicBlock *, BasicBlock *>, 4> exitEdges;
+    for (auto exitEdge : loopStructure->getLoopExitEdges()){
+      exitEdges.push_back(exitEdge);
+    }
+
+    /*
+     * Split the pre-header.
+     * The original pre-header will host the runtime check, while the new one will be the pre-header of the original loop.
+     */
+    auto checkBB = preHeader;
+    auto originalPreHeader = SplitBlock(checkBB, checkBB->getTerminator(), &DT, &LI);
+
+    /*
+     * Clone the loop.
+     */
+    ValueToValueMapTy cloneMap;
+    SmallVector<BasicBlock *, 16> clonedBBs;
+    auto clonedLoop = cloneLoopWithPreheader(originalPreHeader, checkBB, loop, cloneMap, ".noelle.versioned", &LI, &DT, clonedBBs);
+    remapInstructionsInBlocks(clonedBBs, cloneMap);
+    auto clonedPreHeader = clonedLoop->getLoopPreheader();
+
+    /*
+     * Merge the values produced by the clone with the ones produced by the original loop.
+     */
+    for (auto exitEdge : exitEdges){
+      auto exitingBB = exitEdge.first;
+      auto exitBB = exitEdge.second;
+      auto clonedExitingBB = cast<BasicBlock>(cloneMap[exitingBB]);
+      for (auto &phi : exitBB->phis()){
+        auto incomingValue = phi.getIncomingValueForBlock(exitingBB);
+        auto clonedIncomingValue = cloneMap.lookup(incomingValue);
+        if (clonedIncomingValue == nullptr){
+          clonedIncomingValue = incomingValue;
+        }
+        phi.addIncoming(clonedIncomingValue, clonedExitingBB);
+      }
+    }
+
+    /*
+     * Emit the runtime check.
+     * The original loop runs if any pair of ranges overlaps.
+     */
+    auto overlap = this->emitOverlapCheck(checkBB->getTerminator(), pairsToCheck, ranges, SE);
+    auto oldTerminator = checkBB->getTerminator();
+    IRBuilder<> checkBuilder(oldTerminator);
+    checkBuilder.CreateCondBr(overlap, originalPreHeader, clonedPreHeader);
+    oldTerminator->eraseFromParent();
+
+    /*
+     * Remove the speculative dependences only within the clone.
+     */
+    this->tagAccessesAsNotAliasing(pairsToCheck, cloneMap);
+
+    /*
+     * Tag both versions of the loop to avoid versioning them again.
+     */
+    auto &context = header->getContext();
+    auto clonedHeader = cast<BasicBlock>(cloneMap[header]);
+    header->getTerminator()->setMetadata(VERSIONED_LOOP_METADATA, MDNode::get(context, MDString::get(context, "original")));
+    clonedHeader->getTerminator()->setMetadata(VERSIONED_LOOP_METADATA, MDNode::get(context, MDString::get(context, "checked")));
+
+    /*
+     * The check block now dominates the exit blocks.
+     */
+    DT.recalculate(*header->getParent());
+    SE.forgetLoop(loop);
+
+    return true;
+  }
+
+  bool LoopVersioner::collectMemoryInstructionsToCheck (
+    LoopDependenceInfo &LDI,
+    std::unordered_set<SCC *> const &SCCs,
+    std::vector<std::pair<Instruction *, Instruction *>> &pairsToCheck
+  ) const {
+    auto sccManager = LDI.getSCCManager();
+    auto domainSpaceAnalysis = LDI.getLoopIterationDomainSpaceAnalysis();
+    auto &DL = LDI.getLoopStructure()->getFunction()->getParent()->getDataLayout();
+
+    /*
+     * Every loop-carried data dependence of the SCCs must be a memory dependence between accesses to different objects.
+     */
+    std::set<std::pair<Instruction *, Instruction *>> pairsAlreadyIncluded;
+    auto canBeChecked = true;
+    for (auto scc : SCCs){
+      sccManager->iterateOverLoopCarriedDataDependences(scc, [
+        &canBeChecked, &pairsToCheck, &pairsAlreadyIncluded, domainSpaceAnalysis, &DL
+      ](DGEdge<Value> *dep) -> bool {
+        if (dep->isControlDependence()){
+          return false;
+        }
+        if (!dep->isMemoryDependence()){
+          canBeChecked = false;
+          return true;
+        }
+
+        /*
+         * Fetch the instructions.
+         */
+        auto fromInst = dyn_cast<Instruction>(dep->getOutgoingT());
+        auto toInst = dyn_cast<Instruction>(dep->getIncomingT());
+        if (  false
+              || (fromInst == nullptr)
+              || (toInst == nullptr)
+           ){
+          canBeChecked = false;
+          return true;
+        }
+
+        /*
+         * Dependences that do not exist between iterations do not need runtime checks.
+         */
+        if (domainSpaceAnalysis->areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst)){
+          return false;
+        }
+
+        /*
+         * Only loads and stores can be checked.
+         */
+        auto fromPointer = getLoadStorePointerOperand(fromInst);
+        auto toPointer = getLoadStorePointerOperand(toInst);
+        if (  false
+              || (fromPointer == nullptr)
+              || (toPointer == nullptr)
+           ){
+          canBeChecked = false;
+          return true;
+        }
+
+        /*
+         * Accesses to the same object would always fail the check.
+         */
+        if (GetUnderlyingObject(fromPointer, DL) == GetUnderlyingObject(toPointer, DL)){
+          canBeChecked = false;
+          return true;
+        }
+
+        /*
+         * Add the pair.
+         */
+        auto pair = (fromInst < toInst) ? std::make_pair(fromInst, toInst) : std::make_pair(toInst, fromInst);
+        if (pairsAlreadyIncluded.find(pair) == pairsAlreadyIncluded.end()){
+          pairsAlreadyIncluded.insert(pair);
+          pairsToCheck.push_back(pair);
+        }
+
+        return false;
+      });
+      if (!canBeChecked){
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool LoopVersioner::areLoopValuesUsedOnlyByExitPHIs (
+    LoopStructure &loop
+  ) const {
+    auto exitBBs = loop.getLoopExitBasicBlocks();
+    std::unordered_set<BasicBlock *> exitBBSet(exitBBs.begin(), exitBBs.end());
+
+    for (auto inst : loop.instructions()){
+      for (auto user : inst->users()){
+        auto userInst = dyn_cast<Instruction>(user);
+        if (  false
+              || (userInst == nullptr)
+              || loop.isIncluded(userInst)
+           ){
+          continue ;
+        }
+        if (  true
+              && isa<PHINode>(userInst)
+              && (exitBBSet.find(userInst->getParent()) != exitBBSet.end())
+           ){
+          continue ;
+        }
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  Value * LoopVersioner::emitOverlapCheck (
+    Instruction *insertPoint,
+    std::vector<std::pair<Instruction *, Instruction *>> const &pairsToCheck,
+    std::unordered_map<Instruction *, std::pair<const SCEV *, const SCEV *>> const &ranges,
+    ScalarEvolution &SE
+  ) const {
+
+    /*
+     * Materialize the bounds of the ranges as integers.
+     */
+    auto &DL = insertPoint->getModule()->getDataLayout();
+    auto intPtrType = DL.getIntPtrType(insertPoint->getContext());
+    SCEVExpander expander(SE, DL, "noelle.versioning");
+    std::unordered_map<Instruction *, std::pair<Value *, Value *>> bounds;
+    for (auto pair : pairsToCheck){
+      for (auto memoryInst : { pair.first, pair.second }){
+        if (bounds.find(memoryInst) != bounds.end()){
+          continue ;
+        }
+        auto range = ranges.at(memoryInst);
+        auto start = expander.expandCodeFor(range.first, intPtrType, insertPoint);
+        auto end = expander.expandCodeFor(range.second, intPtrType, insertPoint);
+        bounds[memoryInst] = std::make_pair(start, end);
+      }
+    }
+
+    /*
+     * Two ranges [s1, e1) and [s2, e2) overlap if s1 < e2 and s2 < e1.
+     */
+    IRBuilder<> builder(insertPoint);
+    Value *overlap = builder.getFalse();
+    for (auto pair : pairsToCheck){
+      auto bounds1 = bounds[pair.first];
+      auto bounds2 = bounds[pair.second];
+      auto startsBeforeEnd1 = builder.CreateICmpULT(bounds1.first, bounds2.second);
+      auto startsBeforeEnd2 = builder.CreateICmpULT(bounds2.first, bounds1.second);
+      auto pairOverlaps = builder.CreateAnd(startsBeforeEnd1, startsBeforeEnd2);
+      overlap = builder.CreateOr(overlap, pairOverlaps);
+    }
+
+    return overlap;
+  }
+
+  void LoopVersioner::tagAccessesAsNotAliasing (
+    std::vector<std::pair<Instruction *, Instruction *>> const &pairsToCheck,
+    ValueToValueMapTy &cloneMap
+  ) const {
+
+    /*
+     * Each checked access of the clone gets its own alias scope.
+     * An access does not alias the scopes of the accesses it has been checked against.
+     */
+    auto &context = pairsToCheck.front().first->getContext();
+    MDBuilder builder(context);
+    auto domain = builder.createAnonymousAliasScopeDomain("NOELLE loop versioning");
+    std::map<Instruction *, MDNode *> scopes;
+    std::map<Instruction *, std::vector<Metadata *>> notAliasingScopes;
+    for (auto pair : pairsToCheck){
+      for (auto memoryInst : { pair.first, pair.second }){
+        if (scopes.find(memoryInst) == scopes.end()){
+          scopes[memoryInst] = builder.createAnonymousAliasScope(domain);
+        }
+      }
+    }
+    for (auto pair : pairsToCheck){
+      notAliasingScopes[pair.first].push_back(scopes[pair.second]);
+      notAliasingScopes[pair.second].push_back(scopes[pair.first]);
+    }
+
+    /*
+     * Tag the accesses of the clone.
+     */
+    for (auto scopePair : scopes){
+      auto clonedInst = cast<Instruction>(cloneMap[scopePair.first]);
+      auto scope = MDNode::get(context, { scopePair.second });
+      auto noAlias = MDNode::get(context, notAliasingScopes[scopePair.first]);
+      clonedInst->setMetadata(
+        LLVMContext::MD_alias_scope,
+        MDNode::concatenate(clonedInst->getMetadata(LLVMContext::MD_alias_scope), scope)
+        );
+      clonedInst->setMetadata(
+        LLVMContext::MD_noalias,
+        MDNode::concatenate(clonedInst->getMetadata(LLVMContext::MD_noalias), noAlias)
+        );
+    }
+
+    return ;
+  }
+
+}
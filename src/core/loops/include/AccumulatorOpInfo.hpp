@@ -29,6 +29,16 @@ namespace llvm::noelle {
       bool isSubOp (unsigned op);
       unsigned accumOpForType (unsigned op, Type *type);
       Value *generateIdentityFor (Instruction *accumulator, Type *castType);
+
+      /*
+       * Return the identity of a min/max whose new values x replace the current one v when P(x, v) holds (e.g., the largest number for a minimum).
+       */
+      Value *generateIdentityForMinMax (CmpInst::Predicate predicate, Type *castType);
+
+      /*
+       * Return true if a min/max with predicate P keeps the first of equal values it observes (i.e., P is strict).
+       */
+      static bool doesMinMaxKeepFirstOfEqualValues (CmpInst::Predicate predicate);
   };
 
 }
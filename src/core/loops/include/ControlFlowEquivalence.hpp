@@ -1,7 +1,7 @@
 /*
  * Copyright 2016 - 2019  Angelo Matni, Simone Campanoni
  *
- * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publoopsh, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
 
  * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
 
@@ -11,26 +11,24 @@
 #pragma once
 
 #include "SystemHeaders.hpp"
-#include "LoopsSummary.hpp"
-#include "DominatorSummary.hpp"
+#include "LoopStructure.hpp"
 #include <memory>
 
 namespace llvm::noelle {
 
+  /*
+   * Sets of basic blocks that are control flow equivalent: the blocks of a set execute the same number of times every time their function executes.
+   *
+   * The sets are the cycle equivalence classes of the control flow graph extended with an edge from its exits to its entry (Johnson, Pearson, and Pingali, PLDI 1994).
+   * They are computed in time linear to the number of basic blocks and control flow edges.
+   */
   class ControlFlowEquivalence {
    public:
 
-    ControlFlowEquivalence (
-      const DominatorSummary *ds,
-      const LoopsSummary *loops,
-      Function &F
-    );
-
-    ControlFlowEquivalence (
-      const DominatorSummary *ds,
-      const LoopsSummary *loops,
-      const LoopStructure *loopStructure
-    );
+    /*
+     * Compute the sets of the basic blocks of @F.
+     */
+    ControlFlowEquivalence (Function &F);
 
     std::unordered_set<BasicBlock *> getEquivalences (BasicBlock *bb) const ;
 
@@ -38,13 +36,9 @@ namespace llvm::noelle {
 
    private:
 
-    void calculateControlFlowEquivalences (const DominatorSummary *DS, const LoopsSummary *loops);
-
-    void createEquivalenceSet (BasicBlock *singleB);
-
-    void mergeEquivalenceSets (BasicBlock *a, BasicBlock *b);
+    void calculateControlFlowEquivalences (void);
 
-    std::set<BasicBlock *> startBBs, endBBs;
+    BasicBlock *startBB;
 
     std::unordered_set<std::unique_ptr<std::unordered_set<BasicBlock *>>> equivalentBBs;
     std::unordered_map<BasicBlock *, std::unordered_set<BasicBlock *> *> bbToEquivalence;
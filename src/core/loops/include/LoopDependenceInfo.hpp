@@ -25,14 +25,19 @@
 
 namespace llvm::noelle {
 
+  /*
+   * Inputs needed to build the components of a loop.
+   */
+  struct LoopDependenceInfoInputs {
+    PDG *functionDG;
+    Loop *loop;
+    ScalarEvolution *SE;
+    LoopForestInvariants *forestInvariants;
+  };
+
   class LoopDependenceInfo {
     public:
 
-      /*
-       * Environment
-       */
-      LoopEnvironment *environment;
-
       /*
        * Parallelization options
        */
@@ -88,6 +93,40 @@ namespace llvm::noelle {
         bool enableLoopAwareDependenceAnalyses
       );
 
+      /*
+       * If @forestInvariants is not nullptr, the invariants of the loop it has already proved are not computed again.
+       * @forestInvariants must have been computed for the function of the loop.
+       */
+      LoopDependenceInfo (
+        PDG *fG,
+        Loop *l,
+        DominatorSummary &DS,
+        ScalarEvolution &SE,
+        uint32_t maxCores,
+        bool enableFloatAsReal,
+        std::unordered_set<LoopDependenceInfoOptimization> optimizations,
+        bool enableLoopAwareDependenceAnalyses,
+        LoopForestInvariants *forestInvariants
+      );
+
+      /*
+       * The components of the loop (e.g., dependence graph, SCCDAG, induction variables) are built when one of them is requested for the first time.
+       * This is meant for clients that only need the structure of many loops (e.g., surveys of the loops of a program).
+       * @l and @SE are used only by the constructor.
+       * The loop, the scalar evolution, and the dependences needed to build the components are fetched from the current state of the program by @fetchInputs, which is invoked once.
+       * All components are then built from the same inputs.
+       */
+      LoopDependenceInfo (
+        Loop *l,
+        DominatorSummary &DS,
+        ScalarEvolution &SE,
+        uint32_t maxCores,
+        bool enableFloatAsReal,
+        std::unordered_set<LoopDependenceInfoOptimization> optimizations,
+        bool enableLoopAwareDependenceAnalyses,
+        std::function<LoopDependenceInfoInputs (void)> fetchInputs
+      );
+
       LoopDependenceInfo () = delete ;
 
       /*
@@ -115,6 +154,11 @@ namespace llvm::noelle {
        */
       PDG * getLoopDG (void) const;
 
+      /*
+       * Get the environment of the loop (i.e., its live-in and live-out values).
+       */
+      LoopEnvironment * getEnvironment (void) const ;
+
       /*
        * Copy all options from otherLDI to "this".
        */
@@ -172,6 +216,17 @@ namespace llvm::noelle {
 
       uint32_t getMaximumNumberOfCores (void) const ;
 
+      /*
+       * Set the maximum number of cores the parallelization of the loop can use.
+       * This is used when the cores are split between the loop and the loops nested within it.
+       */
+      void setMaximumNumberOfCores (uint32_t cores) ;
+
+      /*
+       * Return the seconds spent to build each component of the loop that has been built so far.
+       */
+      const std::map<std::string, double> & getTimeSpentToBuildComponents (void) const ;
+
       /*
        * Deconstructor.
        */
@@ -190,6 +245,10 @@ namespace llvm::noelle {
                                                * This graph does not include instructions outside the loop (i.e., no external dependences are included).
                                                */
 
+      SCCDAG *loopSCCDAG;
+
+      LoopEnvironment *environment;
+
       uint32_t maximumNumberOfCoresForTheParallelization;
 
       LoopsSummary liSummary;                 /* This field describes the loops with the current one as outermost.
@@ -214,9 +273,51 @@ namespace llvm::noelle {
 
       SCCDAGAttrs *sccdagAttrs;
 
+      bool enableFloatAsReal;
+
+      /*
+       * Inputs needed to build the components of the loop.
+       * The function dependence graph, the loop, the scalar evolution, and the forest invariants belong to NOELLE and to the LLVM pass manager, which can free them at any time.
+       * Hence, they are kept only while the components are built, and components built on demand fetch them again through @fetchInputs.
+       */
+      PDG *functionDG;
+      Loop *loop;
+      DominatorSummary *DS;
+      bool isDSOwned;
+      ScalarEvolution *SE;
+      LoopForestInvariants *forestInvariants;
+      std::function<LoopDependenceInfoInputs (void)> fetchInputs;
+
+      std::map<std::string, double> timeSpentToBuildComponents;
+
       /*
        * Methods
        */
+      LoopDependenceInfo (
+        PDG *fG,
+        Loop *l,
+        DominatorSummary &DS,
+        ScalarEvolution &SE,
+        uint32_t maxCores,
+        bool enableFloatAsReal,
+        std::unordered_set<LoopDependenceInfoOptimization> optimizations,
+        bool enableLoopAwareDependenceAnalyses,
+        LoopForestInvariants *forestInvariants,
+        std::function<LoopDependenceInfoInputs (void)> fetchInputs
+      );
+
+      void buildComponents (void) ;
+      void buildDGs (void) ;
+      void buildEnvironment (void) ;
+      void buildInvariantManager (void) ;
+      void buildInductionVariableManager (void) ;
+      void buildSCCManager (void) ;
+      void buildLoopIterationDomainSpaceAnalysis (void) ;
+
+      void timeComponentConstruction (
+        std::string const &componentName,
+        std::function<void (void)> buildComponent
+        );
       void fetchLoopAndBBInfo (
         Loop *l,
         ScalarEvolution &SE
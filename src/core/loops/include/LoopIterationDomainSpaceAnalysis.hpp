@@ -44,6 +44,40 @@ namespace llvm::noelle {
         Instruction *to
       ) const ;
 
+      /*
+       * Check whether the loads or stores given as input can never access the same memory location, in any iteration of the loops of the nest.
+       */
+      bool areInstructionsAccessingDisjointMemoryLocations (
+        Instruction *from,
+        Instruction *to
+      ) const ;
+
+      /*
+       * Compute the distance vector of the memory dependence from the load or store @from to the load or store @to.
+       * The vector has an element for each loop of the nest that includes both instructions, from the outermost one.
+       * Each element is the number of iterations of its loop between @from and @to, or std::nullopt if it is unknown.
+       * Return false if the distances cannot be computed (e.g., the accessed addresses are not affine) or if the instructions do not depend on each other.
+       */
+      bool getDependenceDistanceVector (
+        Instruction *from,
+        Instruction *to,
+        std::vector<std::optional<int64_t>> &distances
+      ) const ;
+
+      /*
+       * Compute the range [rangeStart, rangeEnd) of bytes that the load or store given as input accesses across all iterations of @loop.
+       * @loop must be the LLVM loop of the outermost loop of the nest this analysis has been computed for.
+       * Both SCEVs are invariant with respect to @loop, so they can be evaluated in its pre-header.
+       * Return false if the range cannot be computed.
+       */
+      bool computeRangeOfAccessedMemoryAcrossIterations (
+        Instruction *memoryInstruction,
+        Loop *loop,
+        ScalarEvolution &SE,
+        const SCEV *&rangeStart,
+        const SCEV *&rangeEnd
+      ) const ;
+
     private:
 
       /*
@@ -61,6 +95,31 @@ namespace llvm::noelle {
 
       void indexIVInstructionSCEVs (ScalarEvolution &SE) ;
 
+      /*
+       * Linear function of the iterations of the loops of the nest (counted from 0) plus a term invariant in the nest: symbolic + constant + sum(coefficients[header] * iteration of the loop of header).
+       */
+      class AffineForm {
+        public:
+        const SCEV *symbolic;
+        int64_t constant;
+        std::map<BasicBlock *, int64_t> coefficients;
+      };
+
+      /*
+       * Outcome of the dependence tests (GCD, strong SIV, and Banerjee) between two memory accesses.
+       */
+      class DependenceTestResult {
+        public:
+        bool isApplicable;
+        bool mayDepend;
+
+        /*
+         * For each loop that includes both accesses, from the outermost one, whether the dependence can exist only within the same iteration of the loop and the distance of the dependence if known.
+         */
+        std::vector<bool> isOnlyWithinTheSameIteration;
+        std::vector<std::optional<int64_t>> distances;
+      };
+
       class MemoryAccessSpace {
         public:
         
@@ -88,6 +147,16 @@ namespace llvm::noelle {
          */
         SmallVector<std::pair<Instruction *, InductionVariable *>, 4> subscriptIVs;
 
+        /*
+         * Affine forms of the subscripts and of the offset of the accessed address from the base pointer.
+         * The subscripts are used by the dependence tests only if they are proved to be a delinearization of the offset that does not spill over the inner dimensions.
+         */
+        const SCEV *basePointer;
+        SmallVector<AffineForm, 4> affineSubscripts;
+        bool areSubscriptsUsableForDependenceTests;
+        AffineForm affineAccessFunction;
+        bool isAccessFunctionAffine;
+
       };
 
       /*
@@ -113,6 +182,36 @@ namespace llvm::noelle {
 
       bool isInnerDimensionSubscriptsBounded (ScalarEvolution &SE, MemoryAccessSpace *space) ;
 
+      /*
+       * Largest iteration index (i.e., trip count - 1) of the loops of the nest whose trip count is bounded by a constant
+       */
+      std::unordered_map<BasicBlock *, int64_t> maximumIterationIndexOfLoop;
+
+      void computeAffineFormsOfMemoryAccessSpaces (ScalarEvolution &SE) ;
+
+      bool computeAffineForm (ScalarEvolution &SE, const SCEV *scev, AffineForm &form) ;
+
+      bool isInvariantInTheLoopNest (const SCEV *scev) const ;
+
+      bool areAffineSubscriptsWithinTheirDimensions (ScalarEvolution &SE, MemoryAccessSpace *space) ;
+
+      DependenceTestResult testDependence (Instruction *from, Instruction *to) const ;
+
+      DependenceTestResult testDependenceEquation (
+        const AffineForm &fromForm,
+        const AffineForm &toForm,
+        int64_t offset,
+        const std::vector<BasicBlock *> &commonLoopHeaders
+      ) const ;
+
+      bool computeRangeOfSCEVAcrossIterations (
+        const SCEV *scev,
+        Loop *loop,
+        ScalarEvolution &SE,
+        const SCEV *&minimum,
+        const SCEV *&maximum
+      ) const ;
+
       // bool isIVRelatedSCEVBounded (ScalarEvolution &SE, MemoryAccessSpace *space) ;
 
   };
@@ -45,8 +45,37 @@ namespace llvm::noelle {
         PDG *ldg
       ) ;
 
+      /*
+       * Heap object (i.e., @memoryObject is the call to the allocator) or global variable.
+       * @allocatedType is the value type of a global and nullptr for heap objects.
+       */
+      ClonableMemoryLocation (
+        Value *memoryObject,
+        Type *allocatedType,
+        uint64_t sizeInBits,
+        LoopStructure *loop,
+        DominatorSummary &DS,
+        PDG *ldg
+      ) ;
+
+      /*
+       * Return the stack object or nullptr if the location is a heap object or a global.
+       */
       AllocaInst * getAllocation (void) const ;
 
+      Value * getMemoryObject (void) const ;
+
+      uint64_t getSizeInBytes (void) const ;
+
+      bool isStackObject (void) const ;
+
+      bool isGlobal (void) const ;
+
+      /*
+       * Return true if @c is a constant cast or GEP of the global.
+       */
+      bool isConstantCastOrGEPOfLocation (Constant *c) const ;
+
       std::unordered_set<Instruction *> getLoopInstructionsUsingLocation (void) const ;
 
       std::unordered_set<Instruction *> getInstructionsUsingLocationOutsideLoop (void) const ;
@@ -61,7 +90,15 @@ namespace llvm::noelle {
 
       static bool isMemCpyInstrinsicCall (CallInst *call) ;
 
+      static bool isMemSetInstrinsicCall (CallInst *call) ;
+
+      /*
+       * Return the size in bytes of the heap object allocated by @call with a constant size or 0 if @call isn't such allocation.
+       */
+      static uint64_t getSizeOfHeapAllocation (CallInst *call) ;
+
     private:
+      Value *memoryObject;
       AllocaInst *allocation;
       Type *allocatedType;
       uint64_t sizeInBits;
@@ -73,9 +110,23 @@ namespace llvm::noelle {
       std::unordered_set<Instruction *> storingInstructions;
       std::unordered_set<Instruction *> loadInstructions;
       std::unordered_set<Instruction *> nonStoringInstructions;
+      std::unordered_set<Constant *> constantCastsAndGEPs;
+      std::unordered_set<Instruction *> freeInstructions;
 
       bool identifyStoresAndOtherUsers (LoopStructure *loop, DominatorSummary &DS) ;
 
+      /*
+       * Check the users of a heap object or a global that make it possible to redirect all its accesses within the loop to a private copy.
+       */
+      bool isUserOfNonStackObjectSupported (Value *object, User *user, LoopStructure *loop) ;
+
+      /*
+       * Check that every read of a heap object or a global within the loop follows an overwrite of the whole object within the same iteration.
+       */
+      bool isEveryReadWithinLoopPrecededByAnOverwrite (LoopStructure *loop, DominatorSummary &DS) const ;
+
+      bool isOverwritingTheWholeObject (Instruction *storingInstruction) const ;
+
       bool isThereRAWThroughMemoryFromOutsideLoop (
           LoopStructure *loop, 
           AllocaInst *al, 
@@ -95,7 +95,7 @@ namespace llvm::noelle {
       bool canBeCloned (void) const ;
 
       /*
-       * Return true if cloning is possible through memory AllocaInst cloning
+       * Return true if cloning is possible through cloning memory objects (stack objects, heap objects, and globals)
        */
       bool canBeClonedUsingLocalMemoryLocations (void) const;
 
@@ -189,7 +189,23 @@ namespace llvm::noelle {
 
       void addClonableMemoryLocationsContainedInSCC (std::unordered_set<const ClonableMemoryLocation *> locations) ;
 
-      std::unordered_set<AllocaInst *> getMemoryLocationsToClone (void) const ;
+      std::unordered_set<Value *> getMemoryLocationsToClone (void) const ;
+
+      /*
+       * Return the memory location whose updates create the SCC if they can be reduced, nullptr otherwise.
+       * The SCC is still sequential unless the parallelization technique privatizes the memory location.
+       */
+      LoopCarriedMemoryLocation * getLoopCarriedMemoryLocation (void) const ;
+
+      void setLoopCarriedMemoryLocation (LoopCarriedMemoryLocation *location) ;
+
+      /*
+       * Return the SCC of the min/max whose position the SCC tracks (e.g., the index of a minimum), nullptr otherwise.
+       * The SCC can be reduced only together with the min/max.
+       */
+      SCC * getMinMaxTrackedByIndex (void) const ;
+
+      void setSCCToBeIndexOfMinMax (SCC *minMaxSCC, SelectInst *indexUpdate) ;
 
     private:
       SCC *scc;
@@ -205,6 +221,10 @@ namespace llvm::noelle {
       std::unordered_set<const ClonableMemoryLocation *> clonableMemoryLocations;
       bool isSCCClonableIntoLocalMemory;
 
+      LoopCarriedMemoryLocation *loopCarriedMemoryLocation;
+
+      SCC *minMaxTrackedByIndex;
+
       bool isClonable;
       bool hasIV;
       bool commutative;
@@ -39,6 +39,21 @@
           InductionVariableManager &IV,
           DominatorSummary &DS
         ) ;
+
+        /*
+         * The SCCs are classified by @numberOfThreads threads.
+         * The result is the same for any number of threads.
+         */
+        SCCDAGAttrs (
+          bool enableFloatAsReal,
+          PDG *loopDG,
+          SCCDAG *loopSCCDAG,
+          LoopsSummary &LIS,
+          ScalarEvolution &SE,
+          InductionVariableManager &IV,
+          DominatorSummary &DS,
+          uint32_t numberOfThreads
+        ) ;
         
         SCCDAGAttrs () = delete ;
 
@@ -127,6 +142,9 @@
          * Helper methods on single SCC
          */
         bool checkIfReducible (SCC *scc, LoopsSummary &LIS);
+        void checkIfReducibleThroughMemory (SCC *scc, LoopsSummary &LIS);
+        void checkIfIndicesOfMinMaxAreReducible (LoopsSummary &LIS, InductionVariableManager &IV);
+        SelectInst * getIndexUpdateOfMinMax (SCC *indexSCC, SCC *minMaxSCC, CmpInst *comparison, LoopsSummary &LIS, InductionVariableManager &IV) const ;
         bool checkIfIndependent (SCC *scc);
         bool checkIfSCCOnlyContainsInductionVariables (
           SCC *scc,
@@ -134,7 +152,7 @@
           std::set<InductionVariable *> &loopGoverningIVs,
           std::set<InductionVariable *> &IVs
         );
-        void checkIfClonable (SCC *scc, ScalarEvolution &SE, LoopsSummary &LIS);
+        void checkIfClonable (SCC *scc, LoopsSummary &LIS);
         void checkIfClonableByUsingLocalMemory(SCC *scc, LoopsSummary &LIS) ;
         bool isClonableByInductionVars (SCC *scc) const ;
         bool isClonableBySyntacticSugarInstrs (SCC *scc) const ;
@@ -35,12 +35,23 @@ namespace llvm::noelle {
 
   };
 
+  /*
+   * A LoopCarriedMemoryLocation is a memory object (e.g., an array of accumulators) that evolves across iterations
+   * only through updates of its elements like a[k] += v, where k is any index and v doesn't depend on the object.
+   */
   class LoopCarriedMemoryLocation : public LoopCarriedCycle {
     public:
 
       /*
-       * TODO: Implement
+       * An update of an element of the memory location: store(p, load(p) + v).
        */
+      struct MemoryUpdate {
+        LoadInst *load;
+        BinaryOperator *operation;
+        StoreInst *store;
+        Value *operand;
+      };
+
       LoopCarriedMemoryLocation (
         const LoopStructure &loop,
         PDG &loopDG,
@@ -50,10 +61,50 @@ namespace llvm::noelle {
 
       LoopCarriedMemoryLocation () = delete ;
 
+      bool isEvolutionReducibleAcrossLoopIterations (void) const override ;
+
+      Value * getMemoryLocation (void) const ;
+
       /*
-       * TODO: Implement
+       * Return the type of the elements that are updated.
        */
-      bool isEvolutionReducibleAcrossLoopIterations (void) const override ;
+      Type * getAccumulatorType (void) const ;
+
+      /*
+       * Return the size in bytes of the memory location if it is an array of accumulators of known size, 0 otherwise.
+       */
+      uint64_t getSizeInBytes (void) const ;
+
+      const std::vector<MemoryUpdate> & getUpdates (void) const ;
+
+      bool isLoadOrStoreOfUpdate (Instruction *inst) const ;
+
+      /*
+       * Return the memory object that @memoryInstruction accesses by stripping casts and GEPs from its pointer, nullptr if @memoryInstruction is not a load or a store.
+       */
+      static Value * getMemoryLocationAccessedBy (Instruction *memoryInstruction) ;
+
+    private:
+
+      bool identifyUpdates (const LoopStructure &loop, SCC &memoryLocationSCC) ;
+
+      bool isValueDependentOnLocation (const LoopStructure &loop, Value *value) const ;
+
+      void computeSizeOfArrayOfAccumulators (void) ;
+
+      bool isValid;
+
+      Value *memoryLocation;
+
+      Type *accumulatorType;
+
+      uint64_t sizeInBytes;
+
+      std::vector<MemoryUpdate> updates;
+
+      std::unordered_set<LoadInst *> loads;
+
+      std::unordered_set<StoreInst *> stores;
 
   };
 
@@ -76,6 +127,12 @@ namespace llvm::noelle {
 
       PHINode *getLoopEntryPHIForValueOfVariable (Value *value) const ;
 
+      /*
+       * Return the predicate P of the min/max updates of the variable: a new value x replaces the current value v of the variable when P(x, v) holds.
+       * Return BAD_ICMP_PREDICATE if the variable doesn't evolve as a min/max.
+       */
+      CmpInst::Predicate getMinMaxPredicate (void) const ;
+
     private:
 
       PDG *produceDataAndMemoryOnlyDGFromVariableDG (PDG &variableDG) const ;
@@ -170,11 +227,27 @@ namespace llvm::noelle {
       bool isSub (void) const ;
       bool isSubTransformableToAdd (void) const ;
 
+      /*
+       * A min/max update is a select that picks either the current value of the variable or a new one depending on how they compare (e.g., v = (x < v) ? x : v).
+       */
+      bool isMinMax (void) const ;
+
+      /*
+       * Return the predicate P of a min/max update: the new value x replaces the current value v when P(x, v) holds.
+       */
+      CmpInst::Predicate getMinMaxPredicate (void) const ;
+
+      /*
+       * Return the comparison of @select if @select picks one of the two values compared, nullptr otherwise.
+       */
+      static CmpInst * getComparisonOfMinMax (SelectInst *select) ;
+
     private:
 
       bool isBothUpdatesAddOrSub (const EvolutionUpdate &otherUpdate) const ;
       bool isBothUpdatesMul (const EvolutionUpdate &otherUpdate) const ;
       bool isBothUpdatesSameBitwiseLogicalOp (const EvolutionUpdate &otherUpdate) const ;
+      bool isBothUpdatesSameMinMax (const EvolutionUpdate &otherUpdate) const ;
 
       /*
        * The instruction that constitutes the update
@@ -197,6 +270,11 @@ namespace llvm::noelle {
        */
       std::unordered_set<Use *> externalValuesUsed;
 
+      /*
+       * The predicate of min/max updates, BAD_ICMP_PREDICATE for the other updates
+       */
+      CmpInst::Predicate minMaxPredicate;
+
   };
 
 }
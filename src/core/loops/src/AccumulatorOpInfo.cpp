@@ -22,7 +22,8 @@ AccumulatorOpInfo::AccumulatorOpInfo () {
     Instruction::Sub,
     Instruction::FSub,
     Instruction::Or,
-    Instruction::And
+    Instruction::And,
+    Instruction::Xor
   };
 
   this->accumOps = std::set<unsigned>(sideEffectFreeOps.begin(), sideEffectFreeOps.end());
@@ -35,7 +36,7 @@ AccumulatorOpInfo::AccumulatorOpInfo () {
     { Instruction::Sub, 0 },
     { Instruction::FSub, 0 },
     { Instruction::Or, 0 },
-    { Instruction::And, 1 }
+    { Instruction::Xor, 0 }
   };
 
   this->integerReducingOperators = {
@@ -46,7 +47,8 @@ AccumulatorOpInfo::AccumulatorOpInfo () {
     { Instruction::Sub, Instruction::Add },
     { Instruction::FSub, Instruction::Add },
     { Instruction::Or, Instruction::Or },
-    { Instruction::And, Instruction::And }
+    { Instruction::And, Instruction::And },
+    { Instruction::Xor, Instruction::Xor }
   };
 
   this->floatingReducingOperators = {
@@ -90,6 +92,15 @@ unsigned AccumulatorOpInfo::accumOpForType (unsigned op, Type *type) {
 }
 
 Value *AccumulatorOpInfo::generateIdentityFor (Instruction *accumulator, Type *castType) {
+
+  /*
+   * The identity of the bitwise and has all bits set
+   */
+  if (accumulator->getOpcode() == Instruction::And) {
+    assert(castType->isIntegerTy());
+    return Constant::getAllOnesValue(castType);
+  }
+
   Value *initVal = nullptr;
   auto opIdentity = this->opIdentities[accumulator->getOpcode()];
   if (castType->isIntegerTy()) initVal = ConstantInt::get(castType, opIdentity);
@@ -98,3 +109,60 @@ Value *AccumulatorOpInfo::generateIdentityFor (Instruction *accumulator, Type *c
   assert(initVal != nullptr);
   return initVal;
 }
+
+Value *AccumulatorOpInfo::generateIdentityForMinMax (CmpInst::Predicate predicate, Type *castType) {
+  switch (predicate) {
+
+    /*
+     * Minimums
+     */
+    case CmpInst::ICMP_SLT:
+    case CmpInst::ICMP_SLE:
+      return ConstantInt::get(castType, APInt::getSignedMaxValue(castType->getIntegerBitWidth()));
+    case CmpInst::ICMP_ULT:
+    case CmpInst::ICMP_ULE:
+      return ConstantInt::get(castType, APInt::getMaxValue(castType->getIntegerBitWidth()));
+    case CmpInst::FCMP_OLT:
+    case CmpInst::FCMP_OLE:
+    case CmpInst::FCMP_ULT:
+    case CmpInst::FCMP_ULE:
+      return ConstantFP::getInfinity(castType, false);
+
+    /*
+     * Maximums
+     */
+    case CmpInst::ICMP_SGT:
+    case CmpInst::ICMP_SGE:
+      return ConstantInt::get(castType, APInt::getSignedMinValue(castType->getIntegerBitWidth()));
+    case CmpInst::ICMP_UGT:
+    case CmpInst::ICMP_UGE:
+      return ConstantInt::get(castType, 0);
+    case CmpInst::FCMP_OGT:
+    case CmpInst::FCMP_OGE:
+    case CmpInst::FCMP_UGT:
+    case CmpInst::FCMP_UGE:
+      return ConstantFP::getInfinity(castType, true);
+
+    default:
+      assert(false
+        && "Attempting to reduce unknown min/max!");
+  }
+
+  return nullptr;
+}
+
+bool AccumulatorOpInfo::doesMinMaxKeepFirstOfEqualValues (CmpInst::Predicate predicate) {
+  switch (predicate) {
+    case CmpInst::ICMP_SLT:
+    case CmpInst::ICMP_SGT:
+    case CmpInst::ICMP_ULT:
+    case CmpInst::ICMP_UGT:
+    case CmpInst::FCMP_OLT:
+    case CmpInst::FCMP_OGT:
+    case CmpInst::FCMP_ULT:
+    case CmpInst::FCMP_UGT:
+      return true;
+    default:
+      return false;
+  }
+}
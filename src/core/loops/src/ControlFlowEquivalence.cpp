@@ -14,122 +14,261 @@ using namespace llvm;
 using namespace llvm::noelle;
 
 ControlFlowEquivalence::ControlFlowEquivalence (
-  const DominatorSummary *ds,
-  const LoopsSummary *loops,
   Function &F
-) {
-  auto functionEntry = &F.getEntryBlock();
-  startBBs.insert(functionEntry);
-  calculateControlFlowEquivalences(ds, loops);
-}
-
-ControlFlowEquivalence::ControlFlowEquivalence (
-  const DominatorSummary *ds,
-  const LoopsSummary *loops,
-  const LoopStructure *loopStructure
-) {
-  startBBs.insert(loopStructure->getHeader());
-  auto exitBlocks = loopStructure->getLoopExitBasicBlocks();
-  endBBs.insert(exitBlocks.begin(), exitBlocks.end());
-  calculateControlFlowEquivalences(ds, loops);
+) : startBB{&F.getEntryBlock()} {
+  calculateControlFlowEquivalences();
 }
 
 /*
- * Goal: Traverse DT, merging equivalent sets where
- * node n's parent in the PDT is one of n's children in the DT
+ * Goal: Compute the cycle equivalence classes of the nodes of the control flow graph
+ *
+ * Each basic block B is split into the nodes B_in and B_out connected by the edge (B_in, B_out), which represents B.
+ * A control flow edge from A to B becomes the edge (A_out, B_in), and the blocks that leave the function are connected to the node END.
+ * The edge (END, start_in) closes the graph.
+ * Two blocks are control flow equivalent if and only if the edges that represent them are in the same cycles of the (undirected) resulting graph.
  */
-void ControlFlowEquivalence::calculateControlFlowEquivalences (
-  const DominatorSummary *DS,
-  const LoopsSummary *loops
-) {
+void ControlFlowEquivalence::calculateControlFlowEquivalences (void) {
 
   /*
-   * Create trivial equivalence sets
+   * Collect the basic blocks of the code: the ones reachable from the start.
    */
+  std::vector<BasicBlock *> bbs;
+  std::unordered_map<BasicBlock *, uint32_t> bbToIndex;
   std::queue<BasicBlock *> bbWorklist;
-  std::unordered_set<BasicBlock *> bbSeen;
-  for (auto start : startBBs) bbWorklist.push(start);
+  bbWorklist.push(startBB);
+  bbToIndex[startBB] = 0;
+  bbs.push_back(startBB);
   while (!bbWorklist.empty()) {
     auto B = bbWorklist.front();
     bbWorklist.pop();
-
-    if (bbSeen.find(B) != bbSeen.end()) continue;
-    if (endBBs.find(B) != endBBs.end()) continue;
-    bbSeen.insert(B);
-    createEquivalenceSet(B);
-
     for (auto succB : successors(B)) {
+      if (bbToIndex.find(succB) != bbToIndex.end()) continue;
+      bbToIndex[succB] = bbs.size();
+      bbs.push_back(succB);
       bbWorklist.push(succB);
     }
   }
 
   /*
-   * Merge equivalence sets where:
-   *   A |- B, B -| A, A & B are in the same inner-most loop
+   * Blocks that cannot leave the code (e.g., infinite loops) do not belong to any cycle that includes END.
+   * Hence, they are equivalent only to themselves.
    */
-  std::queue<DomNodeSummary *> dtWorklist;
-  for (auto start : startBBs) dtWorklist.push(DS->DT.getNode(start));
-  while (!dtWorklist.empty()) {
-    auto dtNode = dtWorklist.front();
-    dtWorklist.pop();
+  std::vector<bool> canLeave(bbs.size(), false);
+  for (auto i = 0u; i < bbs.size(); i++) {
+    if (!succ_empty(bbs[i])) continue;
+    canLeave[i] = true;
+    bbWorklist.push(bbs[i]);
+  }
+  while (!bbWorklist.empty()) {
+    auto B = bbWorklist.front();
+    bbWorklist.pop();
+    for (auto predB : predecessors(B)) {
+      auto predIter = bbToIndex.find(predB);
+      if (predIter == bbToIndex.end()) continue;
+      if (canLeave[predIter->second]) continue;
+      canLeave[predIter->second] = true;
+      bbWorklist.push(predB);
+    }
+  }
 
-    /*
-     * Consider this block A
-     */
-    auto dtBlock = dtNode->getBlock();
-    // dtBlock->printAsOperand(errs() << "CFE: Iterating: "); errs() << "\n";
-    if (endBBs.find(dtBlock) != endBBs.end()) continue;
+  /*
+   * Build the undirected graph.
+   */
+  auto endNode = 2 * bbs.size();
+  auto numberOfNodes = endNode + 1;
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  std::vector<std::vector<uint32_t>> adjacentEdges(numberOfNodes);
+  auto addEdge = [&edges, &adjacentEdges](uint32_t from, uint32_t to) -> uint32_t {
+    auto edgeID = edges.size();
+    edges.push_back(std::make_pair(from, to));
+    adjacentEdges[from].push_back(edgeID);
+    adjacentEdges[to].push_back(edgeID);
+    return edgeID;
+  };
+  std::vector<int64_t> bbToEdge(bbs.size(), -1);
+  for (auto i = 0u; i < bbs.size(); i++) {
+    if (!canLeave[i]) continue;
+    bbToEdge[i] = addEdge(2 * i, 2 * i + 1);
+  }
+  for (auto i = 0u; i < bbs.size(); i++) {
+    if (!canLeave[i]) continue;
+    auto B = bbs[i];
+    if (succ_empty(B)) {
+      addEdge(2 * i + 1, endNode);
+      continue;
+    }
+    for (auto succB : successors(B)) {
+      auto succIndex = bbToIndex.at(succB);
+      if (!canLeave[succIndex]) continue;
+      addEdge(2 * i + 1, 2 * succIndex);
+    }
+  }
+  if (canLeave[0]) {
+    addEdge(endNode, 0);
+  }
 
-    std::unordered_set<BasicBlock *> dtChildrenBlocks{};
-    for (auto dtChildNode : dtNode->getChildren()) {
-      dtChildrenBlocks.insert(dtChildNode->getBlock());
+  /*
+   * Depth-first traversal of the undirected graph from END.
+   * Edges are either tree edges or back edges from a node to one of its ancestors.
+   */
+  const uint32_t undefined = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> dfsNumber(numberOfNodes, undefined);
+  std::vector<uint32_t> nodeOfDFSNumber;
+  std::vector<uint32_t> parentEdge(numberOfNodes, undefined);
+  std::vector<std::vector<uint32_t>> backEdgesToAncestors(numberOfNodes);
+  std::vector<std::vector<uint32_t>> backEdgesFromDescendants(numberOfNodes);
+  std::vector<std::vector<uint32_t>> children(numberOfNodes);
+  std::vector<std::pair<uint32_t, uint32_t>> dfsStack;
+  dfsNumber[endNode] = 0;
+  nodeOfDFSNumber.push_back(endNode);
+  dfsStack.push_back(std::make_pair(endNode, 0));
+  while (!dfsStack.empty()) {
+    auto node = dfsStack.back().first;
+    auto &nextEdgeIndex = dfsStack.back().second;
+    if (nextEdgeIndex == adjacentEdges[node].size()) {
+      dfsStack.pop_back();
+      continue;
     }
+    auto edgeID = adjacentEdges[node][nextEdgeIndex];
+    nextEdgeIndex++;
+    if (edgeID == parentEdge[node]) continue;
+    auto otherNode = (edges[edgeID].first == node) ? edges[edgeID].second : edges[edgeID].first;
+    if (dfsNumber[otherNode] == undefined) {
+      dfsNumber[otherNode] = nodeOfDFSNumber.size();
+      nodeOfDFSNumber.push_back(otherNode);
+      parentEdge[otherNode] = edgeID;
+      children[node].push_back(otherNode);
+      dfsStack.push_back(std::make_pair(otherNode, 0));
+      continue;
+    }
+    if (dfsNumber[otherNode] < dfsNumber[node]) {
+      backEdgesToAncestors[node].push_back(edgeID);
+      backEdgesFromDescendants[otherNode].push_back(edgeID);
+    }
+  }
 
-    auto dtBlockLoop = loops->getLoop(*dtBlock);
-    auto dtBlockInLoop = dtBlockLoop != nullptr;
+  /*
+   * Assign the equivalence classes to the edges by visiting the nodes bottom-up.
+   * Each node keeps the list of brackets (back edges from one of its descendants to one of its ancestors) of the edge that connects it to its parent.
+   * Two edges are cycle equivalent if and only if they have the same set of brackets, which is identified by the top bracket and the size of the list.
+   */
+  struct Bracket {
+    uint32_t cls;
+    uint32_t recentSize;
+    uint32_t recentClass;
+    std::list<Bracket *>::iterator position;
+  };
+  std::vector<std::unique_ptr<Bracket>> brackets;
+  auto newBracket = [&brackets, undefined](void) -> Bracket * {
+    auto bracket = std::make_unique<Bracket>();
+    bracket->cls = undefined;
+    bracket->recentSize = undefined;
+    bracket->recentClass = undefined;
+    brackets.push_back(std::move(bracket));
+    return brackets.back().get();
+  };
+  std::vector<Bracket *> edgeToBracket(edges.size(), nullptr);
+  std::vector<uint32_t> edgeClass(edges.size(), undefined);
+  std::vector<std::vector<Bracket *>> cappingBracketsOfNode(numberOfNodes);
+  std::vector<std::list<Bracket *>> bracketList(numberOfNodes);
+  std::vector<uint32_t> hi(numberOfNodes, undefined);
+  uint32_t numberOfClasses = 0;
+  for (int64_t dfsIndex = nodeOfDFSNumber.size() - 1; dfsIndex >= 0; dfsIndex--) {
+    auto node = nodeOfDFSNumber[dfsIndex];
 
     /*
-     * Iterate PDT parents of A, those that qualify for condition B -| A
+     * Compute the highest nodes reached by back edges from the node and from its sub-trees.
      */
-    auto pdtNode = DS->PDT.getNode(dtBlock);
-    auto pdtParentNode = pdtNode->getParent();
-    while (pdtParentNode != nullptr) {
-      auto pdtBlock = pdtParentNode->getBlock();
-      pdtParentNode = pdtParentNode->getParent();
-
-      /*
-       * Check if condition A |- B is not held
-       */
-      if (dtChildrenBlocks.find(pdtBlock) == dtChildrenBlocks.end()) {
-        break;
-      } else {
-        dtChildrenBlocks.clear();
-        for (auto dtChildNode : DS->DT.getNode(pdtBlock)->getChildren()) {
-          dtChildrenBlocks.insert(dtChildNode->getBlock());
-        }
+    auto hi0 = undefined;
+    for (auto edgeID : backEdgesToAncestors[node]) {
+      auto otherNode = (edges[edgeID].first == node) ? edges[edgeID].second : edges[edgeID].first;
+      hi0 = std::min(hi0, dfsNumber[otherNode]);
+    }
+    auto hi1 = undefined;
+    uint32_t hiChild = undefined;
+    for (auto child : children[node]) {
+      if (hi[child] < hi1) {
+        hi1 = hi[child];
+        hiChild = child;
       }
+    }
+    hi[node] = std::min(hi0, hi1);
+    auto hi2 = undefined;
+    for (auto child : children[node]) {
+      if (child == hiChild) continue;
+      hi2 = std::min(hi2, hi[child]);
+    }
 
-      /*
-       * Check if A and B are in the same inner-most loop
-       */
-      auto pdtBlockLoop = loops->getLoop(*pdtBlock);
-      auto pdtBlockInLoop = pdtBlockLoop != nullptr;
-      if (dtBlockInLoop ^ pdtBlockInLoop) continue;
-      if (dtBlockInLoop && pdtBlockInLoop
-          && dtBlockLoop != pdtBlockLoop) continue;
-
-      mergeEquivalenceSets(dtBlock, pdtBlock);
-      break;
+    /*
+     * Compute the bracket list of the node.
+     */
+    auto &blist = bracketList[node];
+    for (auto child : children[node]) {
+      blist.splice(blist.end(), bracketList[child]);
+    }
+    for (auto cappingBracket : cappingBracketsOfNode[node]) {
+      blist.erase(cappingBracket->position);
+    }
+    for (auto edgeID : backEdgesFromDescendants[node]) {
+      auto bracket = edgeToBracket[edgeID];
+      blist.erase(bracket->position);
+      if (bracket->cls == undefined) {
+        bracket->cls = numberOfClasses++;
+      }
+      edgeClass[edgeID] = bracket->cls;
+    }
+    for (auto edgeID : backEdgesToAncestors[node]) {
+      auto bracket = newBracket();
+      edgeToBracket[edgeID] = bracket;
+      bracket->position = blist.insert(blist.begin(), bracket);
+    }
+    if (hi2 < hi0) {
+      auto cappingBracket = newBracket();
+      cappingBracket->position = blist.insert(blist.begin(), cappingBracket);
+      cappingBracketsOfNode[nodeOfDFSNumber[hi2]].push_back(cappingBracket);
     }
 
     /*
-     * Queue all children to continue traversal
+     * Compute the class of the tree edge that connects the node to its parent.
      */
-    for (auto dtChildNode : dtNode->getChildren()) {
-      // dtChildNode->getBlock()->printAsOperand(errs() << "CFE: Going to: "); errs() << "\n";
-      dtWorklist.push(dtChildNode);
+    if (node == endNode) continue;
+    auto treeEdgeID = parentEdge[node];
+    assert(!blist.empty());
+    auto topBracket = blist.front();
+    if (topBracket->recentSize != blist.size()) {
+      topBracket->recentSize = blist.size();
+      topBracket->recentClass = numberOfClasses++;
     }
+    edgeClass[treeEdgeID] = topBracket->recentClass;
+    if (topBracket->recentSize == 1) {
+      topBracket->cls = edgeClass[treeEdgeID];
+    }
+  }
+
+  /*
+   * Create the sets of equivalent basic blocks.
+   */
+  std::unordered_map<uint32_t, std::unordered_set<BasicBlock *> *> classToSet;
+  for (auto i = 0u; i < bbs.size(); i++) {
+    auto B = bbs[i];
+    if (!canLeave[i]) {
+      auto eqSet = std::make_unique<std::unordered_set<BasicBlock *>>();
+      eqSet->insert(B);
+      bbToEquivalence[B] = equivalentBBs.insert(std::move(eqSet)).first->get();
+      continue;
+    }
+    auto cls = edgeClass[bbToEdge[i]];
+    assert(cls != undefined);
+    if (classToSet.find(cls) == classToSet.end()) {
+      auto eqSet = std::make_unique<std::unordered_set<BasicBlock *>>();
+      classToSet[cls] = equivalentBBs.insert(std::move(eqSet)).first->get();
+    }
+    auto eqSet = classToSet[cls];
+    eqSet->insert(B);
+    bbToEquivalence[B] = eqSet;
   }
+
+  return ;
 }
 
 std::unordered_set<BasicBlock *> ControlFlowEquivalence::getEquivalences (BasicBlock *bb) const {
@@ -151,26 +290,3 @@ raw_ostream & ControlFlowEquivalence::print (
   }
   return stream;
 }
-
-void
-ControlFlowEquivalence::createEquivalenceSet (
-  BasicBlock *singleB
-) {
-  auto eqSet = std::make_unique<std::unordered_set<BasicBlock *>>();
-  eqSet->insert(singleB);
-  bbToEquivalence[singleB] = equivalentBBs.insert(std::move(eqSet)).first->get();
-}
-
-void
-ControlFlowEquivalence::mergeEquivalenceSets (
-  BasicBlock *x,
-  BasicBlock *y
-) {
-  // x->printAsOperand(errs() << " CFE: Merging: ", false);
-  // y->printAsOperand(errs() << " with "); errs() << "\n";
-  auto xSet = bbToEquivalence[x];
-  bbToEquivalence[y]->insert(xSet->begin(), xSet->end());
-  for (auto v : *xSet) {
-    bbToEquivalence[v] = bbToEquivalence[y];
-  }
-}
@@ -219,27 +219,58 @@ void refinePDGWithLIDS(
   auto dfr = computeReachabilityFromInstructions(loopStructure);
 
   std::unordered_set<DGEdge<Value> *> edgesToRemove;
-  for (auto dependency : LoopCarriedDependencies::getLoopCarriedDependenciesForLoop(*loopStructure, *liSummary, *loopDG)) {
+  std::unordered_set<DGEdge<Value> *> edgesWithinTheSameIteration;
+  for (auto &loop : liSummary->loops) {
+    for (auto dependency : LoopCarriedDependencies::getLoopCarriedDependenciesForLoop(*loop, *liSummary, *loopDG)) {
+
+      /*
+      * Do not waste time on edges that aren't memory dependencies
+      */
+      if (!dependency->isMemoryDependence()) continue;
+
+      auto fromInst = dyn_cast<Instruction>(dependency->getOutgoingT());
+      auto toInst = dyn_cast<Instruction>(dependency->getIncomingT());
+      if (!fromInst || !toInst) continue;
+
+      /*
+      * Dependencies between accesses that never overlap do not exist
+      */
+      if (LIDS->areInstructionsAccessingDisjointMemoryLocations(fromInst, toInst)) {
+        edgesToRemove.insert(dependency);
+        continue;
+      }
 
-    /*
-    * Do not waste time on edges that aren't memory dependencies
-    */
-    if (!dependency->isMemoryDependence()) continue;
+      /*
+      * Loop carried dependencies are conservatively marked as such; we can only
+      * remove dependencies between a producer and consumer where we know the producer
+      * can NEVER reach the consumer during the same iteration
+      */
+      auto &afterInstructions = dfr->OUT(fromInst);
+      auto canReachDuringTheSameIteration = afterInstructions.find(toInst) != afterInstructions.end();
+
+      /*
+      * Dependencies whose distance is 0 for all loops that include both instructions are not loop carried.
+      * They are kept as dependencies within an iteration if the producer can reach the consumer during the same iteration.
+      */
+      std::vector<std::optional<int64_t>> distances;
+      if (  true
+            && LIDS->getDependenceDistanceVector(fromInst, toInst, distances)
+            && std::all_of(distances.begin(), distances.end(), [](const std::optional<int64_t> &distance) { return distance && (*distance == 0); })
+         ){
+        if (canReachDuringTheSameIteration) {
+          edgesWithinTheSameIteration.insert(dependency);
+        } else {
+          edgesToRemove.insert(dependency);
+        }
+        continue;
+      }
 
-    auto fromInst = dyn_cast<Instruction>(dependency->getOutgoingT());
-    auto toInst = dyn_cast<Instruction>(dependency->getIncomingT());
-    if (!fromInst || !toInst) continue;
+      if (loop.get() != loopStructure) continue;
+      if (canReachDuringTheSameIteration) continue;
 
-    /*
-    * Loop carried dependencies are conservatively marked as such; we can only
-    * remove dependencies between a producer and consumer where we know the producer
-    * can NEVER reach the consumer during the same iteration
-    */
-    auto &afterInstructions = dfr->OUT(fromInst);
-    if (afterInstructions.find(toInst) != afterInstructions.end()) continue;
-
-    if (LIDS->areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst)) {
-      edgesToRemove.insert(dependency);
+      if (LIDS->areInstructionsAccessingDisjointMemoryLocationsBetweenIterations(fromInst, toInst)) {
+        edgesToRemove.insert(dependency);
+      }
     }
   }
 
@@ -247,6 +278,9 @@ void refinePDGWithLIDS(
     edge->setLoopCarried(false);
     loopDG->removeEdge(edge);
   }
+  for (auto edge : edgesWithinTheSameIteration) {
+    edge->setLoopCarried(false);
+  }
 
   /*
    * Free the memory
@@ -14,6 +14,7 @@
 #include "Architecture.hpp"
 #include "LoopDependenceInfo.hpp"
 #include "LoopAwareMemDepAnalysis.hpp"
+#include <chrono>
 
 namespace llvm::noelle {
 
@@ -74,18 +75,106 @@ LoopDependenceInfo::LoopDependenceInfo(
   bool enableFloatAsReal,
   std::unordered_set<LoopDependenceInfoOptimization> optimizations,
   bool enableLoopAwareDependenceAnalyses
+) : LoopDependenceInfo{fG, l, DS, SE, maxCores, enableFloatAsReal, optimizations, enableLoopAwareDependenceAnalyses, nullptr} {
+
+  return ;
+}
+
+LoopDependenceInfo::LoopDependenceInfo(
+  PDG *fG,
+  Loop *l,
+  DominatorSummary &DS,
+  ScalarEvolution &SE,
+  uint32_t maxCores,
+  bool enableFloatAsReal,
+  std::unordered_set<LoopDependenceInfoOptimization> optimizations,
+  bool enableLoopAwareDependenceAnalyses,
+  LoopForestInvariants *forestInvariants
+) : LoopDependenceInfo{fG, l, DS, SE, maxCores, enableFloatAsReal, optimizations, enableLoopAwareDependenceAnalyses, forestInvariants, nullptr} {
+
+  /*
+   * Build all components of the loop.
+   */
+  this->buildComponents();
+
+  return ;
+}
+
+LoopDependenceInfo::LoopDependenceInfo(
+  Loop *l,
+  DominatorSummary &DS,
+  ScalarEvolution &SE,
+  uint32_t maxCores,
+  bool enableFloatAsReal,
+  std::unordered_set<LoopDependenceInfoOptimization> optimizations,
+  bool enableLoopAwareDependenceAnalyses,
+  std::function<LoopDependenceInfoInputs (void)> fetchInputs
+) : LoopDependenceInfo{nullptr, l, DS, SE, maxCores, enableFloatAsReal, optimizations, enableLoopAwareDependenceAnalyses, nullptr, fetchInputs} {
+  assert(this->fetchInputs);
+
+  /*
+   * The dominators given as input are not guaranteed to outlive this object.
+   * Hence, we keep a copy of them.
+   */
+  std::set<BasicBlock *> functionBBs;
+  for (auto &bb : *l->getHeader()->getParent()){
+    functionBBs.insert(&bb);
+  }
+  this->DS = new DominatorSummary(DS, functionBBs);
+  this->isDSOwned = true;
+
+  /*
+   * The loop and the scalar evolution given as input can be freed before the components are requested.
+   * They will be fetched again.
+   */
+  this->loop = nullptr;
+  this->SE = nullptr;
+
+  return ;
+}
+
+LoopDependenceInfo::LoopDependenceInfo(
+  PDG *fG,
+  Loop *l,
+  DominatorSummary &DS,
+  ScalarEvolution &SE,
+  uint32_t maxCores,
+  bool enableFloatAsReal,
+  std::unordered_set<LoopDependenceInfoOptimization> optimizations,
+  bool enableLoopAwareDependenceAnalyses,
+  LoopForestInvariants *forestInvariants,
+  std::function<LoopDependenceInfoInputs (void)> fetchInputs
 ) : DOALLChunkSize{8},
+    enabledOptimizations{optimizations},
+    areLoopAwareAnalysesEnabled{enableLoopAwareDependenceAnalyses},
+    loopDG{nullptr},
+    loopSCCDAG{nullptr},
+    environment{nullptr},
     maximumNumberOfCoresForTheParallelization{maxCores},
     liSummary{l},
-    enabledOptimizations{optimizations},
-    areLoopAwareAnalysesEnabled{enableLoopAwareDependenceAnalyses}
+    inductionVariables{nullptr},
+    invariantManager{nullptr},
+    loopGoverningIVAttribution{nullptr},
+    domainSpaceAnalysis{nullptr},
+    memoryCloningAnalysis{nullptr},
+    sccdagAttrs{nullptr},
+    enableFloatAsReal{enableFloatAsReal},
+    functionDG{fG},
+    loop{l},
+    DS{&DS},
+    isDSOwned{false},
+    SE{&SE},
+    forestInvariants{forestInvariants},
+    fetchInputs{fetchInputs}
   {
 
   /*
    * Assertions.
    */
-  for (auto edge : fG->getEdges()) {
-    assert(!edge->isLoopCarriedDependence() && "Flag was already set");
+  if (fG != nullptr){
+    for (auto edge : fG->getEdges()) {
+      assert(!edge->isLoopCarriedDependence() && "Flag was already set");
+    }
   }
 
   /*
@@ -94,39 +183,202 @@ LoopDependenceInfo::LoopDependenceInfo(
   this->enableAllTransformations();
 
   /*
-   * Fetch the loop dependence graph (i.e., the subset of the PDG that relates to the loop @l) and its SCCDAG.
+   * Compute the trip count of the loop.
    */
   this->fetchLoopAndBBInfo(l, SE);
-  auto ls = this->getLoopStructure();
-  auto loopExitBlocks = ls->getLoopExitBasicBlocks();
-  auto DGs = this->createDGsForLoop(l, fG, DS, SE);
+
+  return ;
+}
+
+void LoopDependenceInfo::buildComponents (void) {
+
+  /*
+   * Fetch the inputs from the current state of the program if the components are built on demand.
+   * The loop is identified by its header.
+   */
+  if (this->fetchInputs){
+    auto inputs = this->fetchInputs();
+    auto header = this->getLoopStructure()->getHeader();
+    if (  false
+          || (inputs.loop == nullptr)
+          || (inputs.loop->getHeader() != header)
+       ){
+      errs() << "LoopDependenceInfo: ERROR = the loop with header \"" << header->getName() << "\" does not exist anymore\n";
+      abort();
+    }
+    this->functionDG = inputs.functionDG;
+    this->loop = inputs.loop;
+    this->SE = inputs.SE;
+    this->forestInvariants = inputs.forestInvariants;
+  }
+
+  /*
+   * Build all components of the loop from the same inputs.
+   * Components depend on each other (e.g., the SCC manager depends on the induction variables), so they must describe the same scalar evolution.
+   */
+  this->buildDGs();
+  this->buildEnvironment();
+  this->buildInvariantManager();
+  this->buildInductionVariableManager();
+  this->buildSCCManager();
+  this->buildLoopIterationDomainSpaceAnalysis();
+
+  /*
+   * The inputs are not needed anymore.
+   */
+  this->functionDG = nullptr;
+  this->loop = nullptr;
+  this->SE = nullptr;
+  this->forestInvariants = nullptr;
+  this->fetchInputs = nullptr;
+  if (this->isDSOwned){
+    delete this->DS;
+    this->isDSOwned = false;
+  }
+  this->DS = nullptr;
+
+  return ;
+}
+
+void LoopDependenceInfo::buildDGs (void) {
+  assert(this->functionDG != nullptr);
+
+  /*
+   * Fetch the loop dependence graph (i.e., the subset of the PDG that relates to the loop @l) and its SCCDAG.
+   */
+  auto DGs = this->createDGsForLoop(this->loop, this->functionDG, *this->DS, *this->SE);
   this->loopDG = DGs.first;
-  auto loopSCCDAG = DGs.second;
+  this->loopSCCDAG = DGs.second;
+
+  return ;
+}
+
+void LoopDependenceInfo::buildEnvironment (void) {
 
   /*
    * Create the environment for the loop.
    */
-  this->environment = new LoopEnvironment(loopDG, loopExitBlocks);
+  auto loopDG = this->loopDG;
+  this->timeComponentConstruction("Environment", [this, loopDG](void) {
+    auto loopExitBlocks = this->getLoopStructure()->getLoopExitBasicBlocks();
+    this->environment = new LoopEnvironment(loopDG, loopExitBlocks);
+  });
+
+  return ;
+}
+
+void LoopDependenceInfo::buildInvariantManager (void) {
 
   /*
    * Create the invariant manager.
    */
-  auto topLoop = this->liSummary.getLoopNestingTreeRoot();
-  this->invariantManager = new InvariantManager(topLoop, this->loopDG);
+  auto loopDG = this->loopDG;
+  this->timeComponentConstruction("Invariants", [this, loopDG](void) {
+    auto topLoop = this->liSummary.getLoopNestingTreeRoot();
+    if (this->forestInvariants != nullptr){
+      this->invariantManager = new InvariantManager(topLoop, loopDG, this->forestInvariants);
+    } else {
+      this->invariantManager = new InvariantManager(topLoop, loopDG);
+    }
+  });
+
+  return ;
+}
+
+void LoopDependenceInfo::buildInductionVariableManager (void) {
+
+  /*
+   * Fetch the components the induction variables depend on.
+   */
+  auto invariantManager = this->invariantManager;
+
+  /*
+   * Identify the induction variables.
+   */
+  this->timeComponentConstruction("Induction variables", [this, invariantManager](void) {
+    this->inductionVariables = new InductionVariableManager(liSummary, *invariantManager, *this->SE, *this->loopSCCDAG, *this->environment);
+
+    /*
+     * Collect induction variable information
+     */
+    auto iv = this->inductionVariables->getLoopGoverningInductionVariable(*liSummary.getLoop(*this->loop->getHeader()));
+    if (iv != nullptr){
+      auto loopExitBlocks = this->getLoopStructure()->getLoopExitBasicBlocks();
+      this->loopGoverningIVAttribution = new LoopGoverningIVAttribution(*iv, *this->loopSCCDAG->sccOfValue(iv->getLoopEntryPHI()), loopExitBlocks);
+    }
+  });
+
+  return ;
+}
+
+void LoopDependenceInfo::buildSCCManager (void) {
+
+  /*
+   * Fetch the components the SCC manager depends on.
+   */
+  auto loopDG = this->loopDG;
+  auto inductionVariables = this->inductionVariables;
 
   /*
    * Calculate various attributes on SCCs
    */
-  this->inductionVariables = new InductionVariableManager(liSummary, *invariantManager, SE, *loopSCCDAG, *environment);
-  this->sccdagAttrs = new SCCDAGAttrs(enableFloatAsReal, loopDG, loopSCCDAG, this->liSummary, SE, *inductionVariables, DS);
-  this->domainSpaceAnalysis = new LoopIterationDomainSpaceAnalysis(liSummary, *this->inductionVariables, SE);
+  this->timeComponentConstruction("SCCDAG attributes", [this, loopDG, inductionVariables](void) {
+    this->sccdagAttrs = new SCCDAGAttrs(this->enableFloatAsReal, loopDG, this->loopSCCDAG, this->liSummary, *this->SE, *inductionVariables, *this->DS);
+  });
+
+  /*
+   * The index of a min/max (e.g., argmin) is reduced together with the min/max.
+   * Hence, the min/max must be a live-out as well.
+   */
+  std::unordered_set<SCC *> liveOutSCCs;
+  std::unordered_set<SCC *> minMaxesTrackedByLiveOuts;
+  for (auto envIndex : this->environment->getEnvIndicesOfLiveOutVars()) {
+    auto producerSCC = this->loopSCCDAG->sccOfValue(this->environment->producerAt(envIndex));
+    liveOutSCCs.insert(producerSCC);
+    auto minMaxSCC = this->sccdagAttrs->getSCCAttrs(producerSCC)->getMinMaxTrackedByIndex();
+    if (minMaxSCC != nullptr) {
+      minMaxesTrackedByLiveOuts.insert(minMaxSCC);
+    }
+  }
+  for (auto minMaxSCC : minMaxesTrackedByLiveOuts) {
+    if (liveOutSCCs.find(minMaxSCC) != liveOutSCCs.end()) {
+      continue ;
+    }
+    auto minMaxSCCInfo = this->sccdagAttrs->getSCCAttrs(minMaxSCC);
+    auto minMaxUpdate = *minMaxSCCInfo->getAccumulators().begin();
+    auto minMaxPHI = minMaxSCCInfo->getSingleLoopCarriedVariable()->getLoopEntryPHIForValueOfVariable(minMaxUpdate);
+    this->environment->addLiveOutValue(minMaxPHI);
+  }
+
+  return ;
+}
+
+void LoopDependenceInfo::buildLoopIterationDomainSpaceAnalysis (void) {
+  auto inductionVariables = this->inductionVariables;
+  this->timeComponentConstruction("Loop iteration domain space", [this, inductionVariables](void) {
+    this->domainSpaceAnalysis = new LoopIterationDomainSpaceAnalysis(liSummary, *inductionVariables, *this->SE);
+  });
+
+  return ;
+}
+
+void LoopDependenceInfo::timeComponentConstruction (
+  std::string const &componentName,
+  std::function<void (void)> buildComponent
+  ){
 
   /*
-   * Collect induction variable information
+   * The inputs must be still available.
    */
-  auto iv = this->inductionVariables->getLoopGoverningInductionVariable(*liSummary.getLoop(*l->getHeader()));
-  loopGoverningIVAttribution = iv == nullptr ? nullptr
-    : new LoopGoverningIVAttribution(*iv, *loopSCCDAG->sccOfValue(iv->getLoopEntryPHI()), loopExitBlocks);
+  if (this->SE == nullptr){
+    errs() << "LoopDependenceInfo: ERROR = the component \"" << componentName << "\" cannot be built anymore\n";
+    abort();
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  buildComponent();
+  auto end = std::chrono::steady_clock::now();
+  this->timeSpentToBuildComponents[componentName] += std::chrono::duration<double>(end - start).count();
 
   return ;
 }
@@ -187,6 +439,7 @@ std::pair<PDG *, SCCDAG *> LoopDependenceInfo::createDGsForLoop (
   for (auto edge : functionDG->getEdges()) {
     assert(!edge->isLoopCarriedDependence() && "Flag was already set");
   }
+  auto start = std::chrono::steady_clock::now();
   auto loopDG = functionDG->createLoopsSubgraph(l);
   for (auto edge : loopDG->getEdges()) {
     assert(!edge->isLoopCarriedDependence() && "Flag was already set");
@@ -196,7 +449,6 @@ std::pair<PDG *, SCCDAG *> LoopDependenceInfo::createDGsForLoop (
   for (auto internalNode : loopDG->internalNodePairs()) {
       loopInternals.push_back(internalNode.first);
   }
-  auto loopInternalDG = loopDG->createSubgraphFromValues(loopInternals, false);
 
   /*
    * Detect the loop-carried data dependences.
@@ -213,16 +465,22 @@ std::pair<PDG *, SCCDAG *> LoopDependenceInfo::createDGsForLoop (
 
   /*
    * Perform loop-aware memory dependence analysis to refine the loop dependence graph.
+   *
+   * The induction variables needed by this analysis are computed on a temporary SCCDAG, which is built only if the analysis is enabled.
    */
   auto loopStructure = liSummary.getLoopNestingTreeRoot();
-  auto loopExitBlocks = loopStructure->getLoopExitBasicBlocks();
-  auto env = LoopEnvironment(loopDG, loopExitBlocks);
-  auto preRefinedSCCDAG = SCCDAG(loopInternalDG);
-  auto invManager = InvariantManager(loopStructure, loopDG);
-  auto ivManager = InductionVariableManager(liSummary, invManager, SE, preRefinedSCCDAG, env);
-  auto domainSpace = LoopIterationDomainSpaceAnalysis(liSummary, ivManager, SE);
   if (this->areLoopAwareAnalysesEnabled){
-    refinePDGWithLoopAwareMemDepAnalysis(loopDG, l, loopStructure, &liSummary, &domainSpace);
+    auto preRefinedInternalDG = loopDG->createSubgraphFromValues(loopInternals, false);
+    {
+      auto loopExitBlocks = loopStructure->getLoopExitBasicBlocks();
+      auto env = LoopEnvironment(loopDG, loopExitBlocks);
+      auto preRefinedSCCDAG = SCCDAG(preRefinedInternalDG);
+      auto invManager = (this->forestInvariants != nullptr) ? InvariantManager(loopStructure, loopDG, this->forestInvariants) : InvariantManager(loopStructure, loopDG);
+      auto ivManager = InductionVariableManager(liSummary, invManager, SE, preRefinedSCCDAG, env);
+      auto domainSpace = LoopIterationDomainSpaceAnalysis(liSummary, ivManager, SE);
+      refinePDGWithLoopAwareMemDepAnalysis(loopDG, l, loopStructure, &liSummary, &domainSpace);
+    }
+    delete preRefinedInternalDG;
   }
 
   /*
@@ -242,8 +500,12 @@ std::pair<PDG *, SCCDAG *> LoopDependenceInfo::createDGsForLoop (
   /*
    * Build a SCCDAG of loop-internal instructions
    */
-  loopInternalDG = loopDG->createSubgraphFromValues(loopInternals, false);
+  auto loopInternalDG = loopDG->createSubgraphFromValues(loopInternals, false);
+  auto dgEnd = std::chrono::steady_clock::now();
+  this->timeSpentToBuildComponents["Dependence graph"] += std::chrono::duration<double>(dgEnd - start).count();
   auto loopSCCDAG = new SCCDAG(loopInternalDG);
+  auto sccdagEnd = std::chrono::steady_clock::now();
+  this->timeSpentToBuildComponents["SCCDAG"] += std::chrono::duration<double>(sccdagEnd - dgEnd).count();
 
   /*
    * Safety check: check that the SCCDAG includes all instructions of the loop given as input.
@@ -397,8 +659,8 @@ void LoopDependenceInfo::removeUnnecessaryDependenciesThatCloningMemoryNegates (
     }
     // producer->print(errs() << "Found alloca location for producer: "); errs() << "\n";
     // consumer->print(errs() << "Found alloca location for consumer: "); errs() << "\n";
-    // locationProducer->getAllocation()->print(errs() << "Alloca: "); errs() << "\n";
-    // locationConsumer->getAllocation()->print(errs() << "Alloca: "); errs() << "\n";
+    // locationProducer->getMemoryObject()->print(errs() << "Memory object: "); errs() << "\n";
+    // locationConsumer->getMemoryObject()->print(errs() << "Memory object: "); errs() << "\n";
 
     edgesToRemove.insert(edge);
   }
@@ -441,9 +703,24 @@ bool LoopDependenceInfo::isOptimizationEnabled (LoopDependenceInfoOptimization o
 }
 
 PDG * LoopDependenceInfo::getLoopDG (void) const {
+  if (this->loopDG == nullptr){
+    const_cast<LoopDependenceInfo *>(this)->buildComponents();
+  }
+
   return this->loopDG;
 }
 
+LoopEnvironment * LoopDependenceInfo::getEnvironment (void) const {
+
+  /*
+   * The SCC manager can add live-out values to the environment (e.g., the min/max tracked by an argmin).
+   * Hence, the environment is complete only after the SCC manager has been built.
+   */
+  this->getSCCManager();
+
+  return this->environment;
+}
+
 bool LoopDependenceInfo::iterateOverSubLoopsRecursively (
   std::function<bool (const LoopStructure &child)> funcToInvoke
   ){
@@ -484,18 +761,25 @@ LoopStructure * LoopDependenceInfo::getNestedMostLoopStructure (Instruction *I)
 }
 
 bool LoopDependenceInfo::isSCCContainedInSubloop (SCC *scc) const {
-  return this->sccdagAttrs->isSCCContainedInSubloop(this->liSummary, scc);
+  return this->getSCCManager()->isSCCContainedInSubloop(this->liSummary, scc);
 }
 
 InductionVariableManager * LoopDependenceInfo::getInductionVariableManager (void) const {
+  if (this->inductionVariables == nullptr){
+    const_cast<LoopDependenceInfo *>(this)->buildComponents();
+  }
+
   return inductionVariables;
 }
 
 LoopGoverningIVAttribution * LoopDependenceInfo::getLoopGoverningIVAttribution (void) const {
+  this->getInductionVariableManager();
+
   return loopGoverningIVAttribution;
 }
 
 MemoryCloningAnalysis * LoopDependenceInfo::getMemoryCloningAnalysis (void) const {
+  this->getLoopDG();
   assert(this->memoryCloningAnalysis != nullptr
     && "Requesting memory cloning analysis without having specified LoopDependenceInfoOptimization::MEMORY_CLONING");
   return this->memoryCloningAnalysis;
@@ -513,11 +797,26 @@ uint32_t LoopDependenceInfo::getMaximumNumberOfCores (void) const {
   return this->maximumNumberOfCoresForTheParallelization;
 }
 
+void LoopDependenceInfo::setMaximumNumberOfCores (uint32_t cores) {
+  assert(cores >= 1);
+  this->maximumNumberOfCoresForTheParallelization = cores;
+
+  return ;
+}
+
 InvariantManager * LoopDependenceInfo::getInvariantManager (void) const {
+  if (this->invariantManager == nullptr){
+    const_cast<LoopDependenceInfo *>(this)->buildComponents();
+  }
+
   return this->invariantManager;
 }
 
 LoopIterationDomainSpaceAnalysis * LoopDependenceInfo::getLoopIterationDomainSpaceAnalysis (void) const {
+  if (this->domainSpaceAnalysis == nullptr){
+    const_cast<LoopDependenceInfo *>(this)->buildComponents();
+  }
+
   return this->domainSpaceAnalysis;
 }
 
@@ -526,12 +825,24 @@ const LoopsSummary & LoopDependenceInfo::getLoopHierarchyStructures (void) const
 }
 
 SCCDAGAttrs * LoopDependenceInfo::getSCCManager (void) const {
+  if (this->sccdagAttrs == nullptr){
+    const_cast<LoopDependenceInfo *>(this)->buildComponents();
+  }
+
   return this->sccdagAttrs;
 }
 
+const std::map<std::string, double> & LoopDependenceInfo::getTimeSpentToBuildComponents (void) const {
+  return this->timeSpentToBuildComponents;
+}
+
 LoopDependenceInfo::~LoopDependenceInfo() {
-  delete this->loopDG;
-  delete this->environment;
+  if (this->loopDG){
+    delete this->loopDG;
+  }
+  if (this->environment){
+    delete this->environment;
+  }
 
   if (this->inductionVariables){
     delete this->inductionVariables;
@@ -540,10 +851,17 @@ LoopDependenceInfo::~LoopDependenceInfo() {
     delete this->loopGoverningIVAttribution;
   }
 
-  assert(this->invariantManager);
-  delete this->invariantManager;
+  if (this->invariantManager){
+    delete this->invariantManager;
+  }
+
+  if (this->domainSpaceAnalysis){
+    delete this->domainSpaceAnalysis;
+  }
 
-  delete this->domainSpaceAnalysis;
+  if (this->isDSOwned){
+    delete this->DS;
+  }
 
   return ;
 }
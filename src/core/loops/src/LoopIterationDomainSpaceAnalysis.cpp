@@ -9,6 +9,7 @@
  * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "LoopIterationDomainSpaceAnalysis.hpp"
+#include <numeric>
 
 using namespace llvm;
 using namespace llvm::noelle;
@@ -35,6 +36,11 @@ LoopIterationDomainSpaceAnalysis::LoopIterationDomainSpaceAnalysis (
   identifyIVForMemoryAccessSubscripts(SE);
   identifyNonOverlappingAccessesBetweenIterationsAcrossOneLoopInvocation(SE);
 
+  /*
+   * Compute the affine forms of the accesses needed by the dependence tests
+   */
+  computeAffineFormsOfMemoryAccessSpaces(SE);
+
   return;
 }
 
@@ -59,12 +65,41 @@ bool LoopIterationDomainSpaceAnalysis::areInstructionsAccessingDisjointMemoryLoc
   //   access->memoryAccessor->print(errs() << "Accessor that doesn't overlap: "); errs() << "\n";
   // }
 
-  if (nonOverlappingAccessesBetweenIterations.find(accessSpaceI) == nonOverlappingAccessesBetweenIterations.end()) return false;
-  // errs() << "Space I is fine\n";
-  if (nonOverlappingAccessesBetweenIterations.find(accessSpaceJ) == nonOverlappingAccessesBetweenIterations.end()) return false;
-  // errs() << "Space J is fine\n";
+  if (  true
+        && (nonOverlappingAccessesBetweenIterations.find(accessSpaceI) != nonOverlappingAccessesBetweenIterations.end())
+        && (nonOverlappingAccessesBetweenIterations.find(accessSpaceJ) != nonOverlappingAccessesBetweenIterations.end())
+        && ((accessSpaceI == accessSpaceJ) || isMemoryAccessSpaceEquivalentForTopLoopIVSubscript(accessSpaceI, accessSpaceJ))
+     ){
+    return true;
+  }
+
+  /*
+   * Check if the dependence tests prove that the accesses can overlap only within the same iteration of the outermost loop of the nest
+   */
+  auto result = testDependence(I, J);
+  if (!result.isApplicable) return false;
+  if (!result.mayDepend) return true;
+  return (result.isOnlyWithinTheSameIteration.size() > 0) && result.isOnlyWithinTheSameIteration[0];
+}
+
+bool LoopIterationDomainSpaceAnalysis::areInstructionsAccessingDisjointMemoryLocations (
+  Instruction *from,
+  Instruction *to
+) const {
+  auto result = testDependence(from, to);
+  return result.isApplicable && !result.mayDepend;
+}
+
+bool LoopIterationDomainSpaceAnalysis::getDependenceDistanceVector (
+  Instruction *from,
+  Instruction *to,
+  std::vector<std::optional<int64_t>> &distances
+) const {
+  auto result = testDependence(from, to);
+  if (!result.isApplicable || !result.mayDepend) return false;
 
-  return (accessSpaceI == accessSpaceJ) || isMemoryAccessSpaceEquivalentForTopLoopIVSubscript(accessSpaceI, accessSpaceJ);
+  distances = result.distances;
+  return true;
 }
 
 bool LoopIterationDomainSpaceAnalysis::isMemoryAccessSpaceEquivalentForTopLoopIVSubscript (
@@ -460,7 +495,7 @@ void LoopIterationDomainSpaceAnalysis::identifyIVForMemoryAccessSubscripts (Scal
 }
 
 LoopIterationDomainSpaceAnalysis::MemoryAccessSpace::MemoryAccessSpace (Instruction *memoryAccessor)
-  : memoryAccessor{memoryAccessor} {
+  : memoryAccessor{memoryAccessor}, basePointer{nullptr}, areSubscriptsUsableForDependenceTests{false}, isAccessFunctionAffine{false} {
 }
 
 LoopIterationDomainSpaceAnalysis::~LoopIterationDomainSpaceAnalysis () {
@@ -688,3 +723,642 @@ bool LoopIterationDomainSpaceAnalysis::isInnerDimensionSubscriptsBounded (
 
   return true;
 }
+
+bool LoopIterationDomainSpaceAnalysis::computeRangeOfAccessedMemoryAcrossIterations (
+  Instruction *memoryInstruction,
+  Loop *loop,
+  ScalarEvolution &SE,
+  const SCEV *&rangeStart,
+  const SCEV *&rangeEnd
+) const {
+  assert(loop != nullptr);
+  assert(loop->getHeader() == loops.getLoopNestingTreeRoot()->getHeader());
+
+  /*
+   * Fetch the pointer and the type of the accessed element.
+   */
+  Value *pointer = nullptr;
+  Type *accessedType = nullptr;
+  if (auto load = dyn_cast<LoadInst>(memoryInstruction)) {
+    pointer = load->getPointerOperand();
+    accessedType = load->getType();
+  } else if (auto store = dyn_cast<StoreInst>(memoryInstruction)) {
+    pointer = store->getPointerOperand();
+    accessedType = store->getValueOperand()->getType();
+  } else {
+    return false;
+  }
+  if (!SE.isSCEVable(pointer->getType())) {
+    return false;
+  }
+
+  /*
+   * Fetch the SCEV of the accessed address.
+   * The SCEVs of the memory access spaces belong to the scalar evolution this analysis has been built with, which may not be @SE.
+   */
+  auto pointerSCEV = SE.getSCEV(pointer);
+
+  /*
+   * Compute the lowest and the highest address accessed across all iterations of the loop nest.
+   */
+  const SCEV *minimum = nullptr;
+  const SCEV *maximum = nullptr;
+  if (!computeRangeOfSCEVAcrossIterations(pointerSCEV, loop, SE, minimum, maximum)) {
+    return false;
+  }
+
+  /*
+   * The range ends after the last byte of the element accessed at the highest address.
+   */
+  auto &DL = memoryInstruction->getModule()->getDataLayout();
+  auto intPtrType = DL.getIntPtrType(pointer->getType());
+  auto elementSize = SE.getSizeOfExpr(intPtrType, accessedType);
+  rangeStart = minimum;
+  rangeEnd = SE.getAddExpr(maximum, elementSize);
+
+  return true;
+}
+
+bool LoopIterationDomainSpaceAnalysis::computeRangeOfSCEVAcrossIterations (
+  const SCEV *scev,
+  Loop *loop,
+  ScalarEvolution &SE,
+  const SCEV *&minimum,
+  const SCEV *&maximum
+) const {
+
+  /*
+   * Values that do not change within the loop nest are a range of a single element.
+   */
+  if (SE.isLoopInvariant(scev, loop)) {
+    minimum = scev;
+    maximum = scev;
+    return true;
+  }
+
+  /*
+   * Only affine evolutions of loops of the nest are supported.
+   */
+  auto addRec = dyn_cast<SCEVAddRecExpr>(scev);
+  if (!addRec || !addRec->isAffine()) {
+    return false;
+  }
+  auto evolutionLoop = addRec->getLoop();
+  if (!loop->contains(evolutionLoop)) {
+    return false;
+  }
+
+  /*
+   * The step and the number of iterations must be known before entering the loop nest.
+   */
+  auto step = addRec->getStepRecurrence(SE);
+  if (!SE.isLoopInvariant(step, loop)) {
+    return false;
+  }
+  auto backedgeTakenCount = SE.getBackedgeTakenCount(evolutionLoop);
+  if (  false
+        || isa<SCEVCouldNotCompute>(backedgeTakenCount)
+        || !SE.isLoopInvariant(backedgeTakenCount, loop)
+     ) {
+    return false;
+  }
+
+  /*
+   * Compute the range of the start value, which can evolve in outer loops of the nest.
+   */
+  const SCEV *startMinimum = nullptr;
+  const SCEV *startMaximum = nullptr;
+  if (!computeRangeOfSCEVAcrossIterations(addRec->getStart(), loop, SE, startMinimum, startMaximum)) {
+    return false;
+  }
+
+  /*
+   * Extend the range by the distance the evolution covers within an invocation of its loop.
+   * The step can be negative, so the unsigned minimum and maximum define the range.
+   */
+  auto stepType = SE.getEffectiveSCEVType(step->getType());
+  auto distance = SE.getMulExpr(step, SE.getTruncateOrZeroExtend(backedgeTakenCount, stepType));
+  minimum = SE.getUMinExpr(startMinimum, SE.getAddExpr(startMinimum, distance));
+  maximum = SE.getUMaxExpr(startMaximum, SE.getAddExpr(startMaximum, distance));
+
+  return true;
+}
+
+void LoopIterationDomainSpaceAnalysis::computeAffineFormsOfMemoryAccessSpaces (ScalarEvolution &SE) {
+
+  for (auto &memAccessSpace : this->accessSpaces) {
+    auto space = memAccessSpace.get();
+
+    /*
+     * The base pointer must be the same in every iteration of the loop nest
+     */
+    auto basePointer = dyn_cast<SCEVUnknown>(SE.getPointerBase(space->memoryAccessorSCEV));
+    if (!basePointer || !isInvariantInTheLoopNest(basePointer)) continue;
+    space->basePointer = basePointer;
+
+    /*
+     * Compute the affine form of the offset in bytes from the base pointer
+     */
+    auto accessFunction = SE.getMinusSCEV(space->memoryAccessorSCEV, basePointer);
+    space->isAccessFunctionAffine = computeAffineForm(SE, accessFunction, space->affineAccessFunction);
+
+    /*
+     * Compute the affine forms of the subscripts
+     * They are extended to the type of the offset so they can be composed back into it
+     */
+    auto numberOfDimensions = space->subscripts.size();
+    if (numberOfDimensions == 0 || numberOfDimensions != space->sizes.size()) continue;
+    auto offsetType = SE.getEffectiveSCEVType(accessFunction->getType());
+    auto areSubscriptsAffine = true;
+    for (auto subscript : space->subscripts) {
+      AffineForm form;
+      if (!computeAffineForm(SE, SE.getTruncateOrSignExtend(subscript, offsetType), form)) {
+        areSubscriptsAffine = false;
+        break;
+      }
+      space->affineSubscripts.push_back(form);
+    }
+    if (!areSubscriptsAffine) {
+      space->affineSubscripts.clear();
+      continue;
+    }
+
+    /*
+     * The subscripts must be a delinearization of the offset: ((s0 * size0 + s1) * size1 + ... + sN) * elementSize
+     */
+    auto linearized = SE.getTruncateOrSignExtend(space->subscripts[0], offsetType);
+    for (auto i = 1; i < numberOfDimensions; ++i) {
+      auto size = SE.getTruncateOrSignExtend(space->sizes[i - 1], offsetType);
+      auto subscript = SE.getTruncateOrSignExtend(space->subscripts[i], offsetType);
+      linearized = SE.getAddExpr(SE.getMulExpr(linearized, size), subscript);
+    }
+    linearized = SE.getMulExpr(linearized, SE.getTruncateOrSignExtend(space->sizes[numberOfDimensions - 1], offsetType));
+    if (!SE.getMinusSCEV(linearized, accessFunction)->isZero()) continue;
+
+    /*
+     * The subscripts of the inner dimensions must not spill over into another dimension
+     */
+    space->areSubscriptsUsableForDependenceTests = areAffineSubscriptsWithinTheirDimensions(SE, space);
+  }
+
+  return;
+}
+
+bool LoopIterationDomainSpaceAnalysis::computeAffineForm (
+  ScalarEvolution &SE,
+  const SCEV *scev,
+  AffineForm &form
+) {
+  form.symbolic = nullptr;
+  form.constant = 0;
+  form.coefficients.clear();
+
+  /*
+   * Visit the terms of the sum that composes the SCEV
+   */
+  auto rootLoopStructure = loops.getLoopNestingTreeRoot();
+  SmallVector<const SCEV *, 4> symbolicTerms;
+  std::vector<const SCEV *> terms{ scev };
+  while (!terms.empty()) {
+    auto term = terms.back();
+    terms.pop_back();
+
+    if (auto constantTerm = dyn_cast<SCEVConstant>(term)) {
+      auto &value = constantTerm->getAPInt();
+      if (value.getMinSignedBits() > 64) return false;
+      form.constant += value.getSExtValue();
+      continue;
+    }
+
+    if (auto addTerm = dyn_cast<SCEVAddExpr>(term)) {
+      for (auto operand : addTerm->operands()) {
+        terms.push_back(operand);
+      }
+      continue;
+    }
+
+    /*
+     * Extensions of evolutions that do not wrap are evolutions of the extended start with the extended step
+     */
+    const SCEVAddRecExpr *addRecTerm = nullptr;
+    auto isSignExtended = true;
+    const SCEV *start = nullptr;
+    if (auto signExtendedTerm = dyn_cast<SCEVSignExtendExpr>(term)) {
+      auto operand = dyn_cast<SCEVAddRecExpr>(signExtendedTerm->getOperand());
+      if (operand && operand->hasNoSignedWrap()) {
+        addRecTerm = operand;
+        start = SE.getSignExtendExpr(operand->getStart(), term->getType());
+      }
+    } else if (auto zeroExtendedTerm = dyn_cast<SCEVZeroExtendExpr>(term)) {
+      auto operand = dyn_cast<SCEVAddRecExpr>(zeroExtendedTerm->getOperand());
+      if (operand && operand->hasNoUnsignedWrap()) {
+        addRecTerm = operand;
+        isSignExtended = false;
+        start = SE.getZeroExtendExpr(operand->getStart(), term->getType());
+      }
+    } else if (auto addRec = dyn_cast<SCEVAddRecExpr>(term)) {
+      addRecTerm = addRec;
+      start = addRec->getStart();
+    }
+
+    /*
+     * Evolutions of the loops of the nest must be affine with a constant step
+     */
+    if (  true
+          && (addRecTerm != nullptr)
+          && rootLoopStructure->isIncluded(addRecTerm->getLoop()->getHeader())
+       ){
+      if (!addRecTerm->isAffine()) return false;
+      auto step = dyn_cast<SCEVConstant>(addRecTerm->getStepRecurrence(SE));
+      if (!step) return false;
+      auto &stepValue = step->getAPInt();
+      if (isSignExtended ? (stepValue.getMinSignedBits() > 64) : (stepValue.getActiveBits() > 63)) return false;
+      auto loop = addRecTerm->getLoop();
+      auto header = loop->getHeader();
+      form.coefficients[header] += isSignExtended ? stepValue.getSExtValue() : (int64_t)stepValue.getZExtValue();
+
+      /*
+       * Keep track of the number of iterations of the loop for the Banerjee test
+       */
+      auto tripCount = SE.getSmallConstantMaxTripCount(loop);
+      if (tripCount > 0) {
+        maximumIterationIndexOfLoop[header] = tripCount - 1;
+      }
+
+      terms.push_back(start);
+      continue;
+    }
+
+    /*
+     * The remaining terms must not change within the loop nest
+     */
+    if (!isInvariantInTheLoopNest(term)) return false;
+    symbolicTerms.push_back(term);
+  }
+
+  /*
+   * Remove the loops that do not contribute to the sum
+   */
+  for (auto iter = form.coefficients.begin(); iter != form.coefficients.end(); ) {
+    if (iter->second == 0) {
+      iter = form.coefficients.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  if (!symbolicTerms.empty()) {
+    form.symbolic = SE.getAddExpr(symbolicTerms);
+  }
+
+  return true;
+}
+
+bool LoopIterationDomainSpaceAnalysis::isInvariantInTheLoopNest (const SCEV *scev) const {
+  auto rootLoopStructure = loops.getLoopNestingTreeRoot();
+  auto isVariant = [rootLoopStructure](const SCEV *s) -> bool {
+    if (auto addRec = dyn_cast<SCEVAddRecExpr>(s)) {
+      return rootLoopStructure->isIncluded(addRec->getLoop()->getHeader());
+    }
+    if (auto unknown = dyn_cast<SCEVUnknown>(s)) {
+      auto inst = dyn_cast<Instruction>(unknown->getValue());
+      return inst && rootLoopStructure->isIncluded(inst);
+    }
+    return false;
+  };
+
+  return !SCEVExprContains(scev, isVariant);
+}
+
+bool LoopIterationDomainSpaceAnalysis::areAffineSubscriptsWithinTheirDimensions (
+  ScalarEvolution &SE,
+  MemoryAccessSpace *space
+) {
+
+  /*
+   * The subscript of each inner dimension must be within [0, size of the dimension) in every iteration of the loop nest
+   * We assume program correctness for the outer-most dimension
+   */
+  for (auto i = 1; i < space->affineSubscripts.size(); ++i) {
+    auto &form = space->affineSubscripts[i];
+    auto size = dyn_cast<SCEVConstant>(space->sizes[i - 1]);
+    if (!size || form.symbolic != nullptr) return false;
+    if (size->getAPInt().getMinSignedBits() > 64) return false;
+
+    /*
+     * Compute the range of the subscript
+     */
+    auto minimum = form.constant;
+    auto maximum = form.constant;
+    for (auto &headerCoefficient : form.coefficients) {
+      auto iter = maximumIterationIndexOfLoop.find(headerCoefficient.first);
+      if (iter == maximumIterationIndexOfLoop.end()) return false;
+      auto coefficient = headerCoefficient.second;
+      auto maximumIterationIndex = iter->second;
+      if (std::abs(coefficient) >= (1LL << 28) || maximumIterationIndex >= (1LL << 28)) return false;
+      minimum += std::min<int64_t>(0, coefficient * maximumIterationIndex);
+      maximum += std::max<int64_t>(0, coefficient * maximumIterationIndex);
+    }
+    if (minimum < 0 || maximum >= size->getAPInt().getSExtValue()) return false;
+  }
+
+  return true;
+}
+
+LoopIterationDomainSpaceAnalysis::DependenceTestResult LoopIterationDomainSpaceAnalysis::testDependence (
+  Instruction *from,
+  Instruction *to
+) const {
+  DependenceTestResult result;
+  result.isApplicable = false;
+  result.mayDepend = true;
+
+  /*
+   * Fetch the memory access spaces of the loads or stores, which must access the memory from the same base pointer
+   */
+  auto fromPointer = getLoadStorePointerOperand(from);
+  auto toPointer = getLoadStorePointerOperand(to);
+  if (!fromPointer || !toPointer) return result;
+  auto fromSpaceIter = accessSpaceByInstruction.find(from);
+  auto toSpaceIter = accessSpaceByInstruction.find(to);
+  if (fromSpaceIter == accessSpaceByInstruction.end() || toSpaceIter == accessSpaceByInstruction.end()) return result;
+  auto fromSpace = fromSpaceIter->second;
+  auto toSpace = toSpaceIter->second;
+  if (fromSpace->memoryAccessor != fromPointer || toSpace->memoryAccessor != toPointer) return result;
+  if (fromSpace->basePointer == nullptr || fromSpace->basePointer != toSpace->basePointer) return result;
+
+  /*
+   * Fetch the loops that include both instructions, from the outermost one
+   */
+  auto rootLoopStructure = loops.getLoopNestingTreeRoot();
+  auto getLoopHeaders = [this, rootLoopStructure](Instruction *inst) -> std::vector<BasicBlock *> {
+    std::vector<BasicBlock *> headers;
+    auto loop = loops.getLoop(*inst);
+    while (loop != nullptr) {
+      headers.insert(headers.begin(), loop->getHeader());
+      if (loop == rootLoopStructure) return headers;
+      loop = loop->getParentLoop();
+    }
+    return {};
+  };
+  auto fromLoopHeaders = getLoopHeaders(from);
+  auto toLoopHeaders = getLoopHeaders(to);
+  std::vector<BasicBlock *> commonLoopHeaders;
+  for (auto i = 0; i < fromLoopHeaders.size() && i < toLoopHeaders.size(); ++i) {
+    if (fromLoopHeaders[i] != toLoopHeaders[i]) break;
+    commonLoopHeaders.push_back(fromLoopHeaders[i]);
+  }
+  if (commonLoopHeaders.empty()) return result;
+
+  /*
+   * Fetch the number of bytes accessed
+   */
+  auto &DL = from->getModule()->getDataLayout();
+  auto getAccessedType = [](Instruction *inst) -> Type * {
+    if (auto store = dyn_cast<StoreInst>(inst)) return store->getValueOperand()->getType();
+    return cast<LoadInst>(inst)->getType();
+  };
+  int64_t fromBytes = DL.getTypeStoreSize(getAccessedType(from));
+  int64_t toBytes = DL.getTypeStoreSize(getAccessedType(to));
+  if (fromBytes == 0 || toBytes == 0 || fromBytes > 64 || toBytes > 64) return result;
+
+  /*
+   * A dependence can only exist within the same iteration of a loop if and only if its distance for that loop is 0
+   */
+  auto normalize = [](DependenceTestResult &r) {
+    for (auto k = 0; k < r.distances.size(); ++k) {
+      if (r.isOnlyWithinTheSameIteration[k]) {
+        if (r.distances[k] && (*r.distances[k] != 0)) {
+          r.mayDepend = false;
+          return;
+        }
+        r.distances[k] = 0;
+      }
+      if (r.distances[k] && (*r.distances[k] == 0)) {
+        r.isOnlyWithinTheSameIteration[k] = true;
+      }
+    }
+  };
+
+  /*
+   * Test each dimension on its own if both accesses have been delinearized into elements of the same size of the same array shape.
+   * The dependence must satisfy the equations of all dimensions.
+   */
+  auto elementSize = fromSpace->elementSize ? dyn_cast<SCEVConstant>(fromSpace->elementSize) : nullptr;
+  auto isSameShape = [fromSpace, toSpace]() -> bool {
+    if (fromSpace->sizes.size() != toSpace->sizes.size()) return false;
+    for (auto i = 0; i < fromSpace->sizes.size(); ++i) {
+      if (fromSpace->sizes[i] != toSpace->sizes[i]) return false;
+    }
+    return true;
+  };
+  if (  true
+        && fromSpace->areSubscriptsUsableForDependenceTests
+        && toSpace->areSubscriptsUsableForDependenceTests
+        && isSameShape()
+        && (elementSize != nullptr)
+        && (fromSpace->elementSize == toSpace->elementSize)
+        && (elementSize->getAPInt().getSExtValue() == fromBytes)
+        && (fromBytes == toBytes)
+     ){
+    result.isApplicable = true;
+    result.isOnlyWithinTheSameIteration.assign(commonLoopHeaders.size(), false);
+    result.distances.assign(commonLoopHeaders.size(), std::nullopt);
+    for (auto d = 0; d < fromSpace->affineSubscripts.size(); ++d) {
+      auto &fromForm = fromSpace->affineSubscripts[d];
+      auto &toForm = toSpace->affineSubscripts[d];
+      if (fromForm.symbolic != toForm.symbolic) continue;
+
+      auto dimensionResult = testDependenceEquation(fromForm, toForm, 0, commonLoopHeaders);
+      if (!dimensionResult.mayDepend) {
+        result.mayDepend = false;
+        return result;
+      }
+      for (auto k = 0; k < commonLoopHeaders.size(); ++k) {
+        if (dimensionResult.isOnlyWithinTheSameIteration[k]) {
+          result.isOnlyWithinTheSameIteration[k] = true;
+        }
+        auto &distance = dimensionResult.distances[k];
+        if (!distance) continue;
+        if (result.distances[k] && (*result.distances[k] != *distance)) {
+          result.mayDepend = false;
+          return result;
+        }
+        result.distances[k] = distance;
+      }
+    }
+    normalize(result);
+    return result;
+  }
+
+  /*
+   * Test the offsets in bytes from the base pointer.
+   * The accesses overlap if and only if the offset of @from minus the one of @to is within (-toBytes, fromBytes).
+   * The dependence exists if the equation of any of these differences has a solution.
+   */
+  if (!fromSpace->isAccessFunctionAffine || !toSpace->isAccessFunctionAffine) return result;
+  auto &fromForm = fromSpace->affineAccessFunction;
+  auto &toForm = toSpace->affineAccessFunction;
+  if (fromForm.symbolic != toForm.symbolic) return result;
+  result.isApplicable = true;
+  result.mayDepend = false;
+  for (auto difference = -(toBytes - 1); difference <= (fromBytes - 1); ++difference) {
+    auto differenceResult = testDependenceEquation(fromForm, toForm, difference, commonLoopHeaders);
+    normalize(differenceResult);
+    if (!differenceResult.mayDepend) continue;
+    if (!result.mayDepend) {
+      result = differenceResult;
+      continue;
+    }
+    for (auto k = 0; k < commonLoopHeaders.size(); ++k) {
+      result.isOnlyWithinTheSameIteration[k] = result.isOnlyWithinTheSameIteration[k] && differenceResult.isOnlyWithinTheSameIteration[k];
+      if (result.distances[k] != differenceResult.distances[k]) {
+        result.distances[k] = std::nullopt;
+      }
+    }
+  }
+
+  return result;
+}
+
+LoopIterationDomainSpaceAnalysis::DependenceTestResult LoopIterationDomainSpaceAnalysis::testDependenceEquation (
+  const AffineForm &fromForm,
+  const AffineForm &toForm,
+  int64_t offset,
+  const std::vector<BasicBlock *> &commonLoopHeaders
+) const {
+  DependenceTestResult result;
+  result.isApplicable = true;
+  result.mayDepend = true;
+  result.isOnlyWithinTheSameIteration.assign(commonLoopHeaders.size(), false);
+  result.distances.assign(commonLoopHeaders.size(), std::nullopt);
+
+  /*
+   * The accesses overlap when sum(a * x) - sum(b * y) = rhs, where a and b are the coefficients of @fromForm and @toForm, and x and y are the iterations of their loops.
+   * Values that are too large to be combined without overflowing are not tested.
+   */
+  const int64_t limit = 1LL << 28;
+  if (std::abs(fromForm.constant) >= (limit << 12) || std::abs(toForm.constant) >= (limit << 12)) return result;
+  auto rhs = toForm.constant - fromForm.constant + offset;
+  std::set<BasicBlock *> headers;
+  int64_t gcd = 0;
+  for (auto form : { &fromForm, &toForm }) {
+    for (auto &headerCoefficient : form->coefficients) {
+      if (std::abs(headerCoefficient.second) >= limit) return result;
+      headers.insert(headerCoefficient.first);
+      gcd = std::gcd(gcd, headerCoefficient.second);
+    }
+  }
+  auto fetchCoefficient = [](const AffineForm &form, BasicBlock *header) -> int64_t {
+    auto iter = form.coefficients.find(header);
+    return (iter == form.coefficients.end()) ? 0 : iter->second;
+  };
+
+  /*
+   * ZIV and GCD tests
+   */
+  if (gcd == 0) {
+    result.mayDepend = (rhs == 0);
+    return result;
+  }
+  if ((rhs % gcd) != 0) {
+    result.mayDepend = false;
+    return result;
+  }
+
+  /*
+   * Banerjee test: check whether rhs is within the bounds of the left-hand side when the iterations of the loop of @constrainedHeader are related by @direction and the other ones are unconstrained.
+   * Return std::nullopt if the number of iterations of a loop is unknown.
+   */
+  enum Direction { ANY, LESS, EQUAL, GREATER };
+  auto isRightHandSideWithinBounds = [&](BasicBlock *constrainedHeader, Direction direction) -> std::optional<bool> {
+    int64_t minimum = 0;
+    int64_t maximum = 0;
+    for (auto header : headers) {
+      auto iter = maximumIterationIndexOfLoop.find(header);
+      if (iter == maximumIterationIndexOfLoop.end() || iter->second >= limit) return std::nullopt;
+      auto u = iter->second;
+      auto a = fetchCoefficient(fromForm, header);
+      auto b = fetchCoefficient(toForm, header);
+      if (header != constrainedHeader || direction == ANY) {
+        minimum += std::min<int64_t>(0, a * u) + std::min<int64_t>(0, -b * u);
+        maximum += std::max<int64_t>(0, a * u) + std::max<int64_t>(0, -b * u);
+        continue;
+      }
+
+      /*
+       * The bounds of a * x - b * y are reached at the vertices of the iteration space of (x, y)
+       */
+      std::vector<std::pair<int64_t, int64_t>> vertices;
+      if (direction == EQUAL) {
+        vertices = { {0, 0}, {u, u} };
+      } else if (u < 1) {
+        return false;
+      } else if (direction == LESS) {
+        vertices = { {0, 1}, {0, u}, {u - 1, u} };
+      } else {
+        vertices = { {1, 0}, {u, 0}, {u, u - 1} };
+      }
+      auto vertexMinimum = std::numeric_limits<int64_t>::max();
+      auto vertexMaximum = std::numeric_limits<int64_t>::min();
+      for (auto &vertex : vertices) {
+        auto value = a * vertex.first - b * vertex.second;
+        vertexMinimum = std::min(vertexMinimum, value);
+        vertexMaximum = std::max(vertexMaximum, value);
+      }
+      minimum += vertexMinimum;
+      maximum += vertexMaximum;
+    }
+    return (minimum <= rhs) && (rhs <= maximum);
+  };
+  auto isAnyWithinBounds = isRightHandSideWithinBounds(nullptr, ANY);
+  if (isAnyWithinBounds && !*isAnyWithinBounds) {
+    result.mayDepend = false;
+    return result;
+  }
+
+  /*
+   * Compute the directions of the dependence for each loop that includes both accesses
+   */
+  for (auto k = 0; k < commonLoopHeaders.size(); ++k) {
+    auto header = commonLoopHeaders[k];
+    auto a = fetchCoefficient(fromForm, header);
+    auto b = fetchCoefficient(toForm, header);
+    if (a == 0 && b == 0) continue;
+
+    /*
+     * Strong SIV test: the accesses depend only on this loop and with the same coefficient, so a * (x - y) = rhs
+     */
+    if (a == b && headers.size() == 1) {
+      if ((rhs % a) != 0) {
+        result.mayDepend = false;
+        return result;
+      }
+      auto distance = -rhs / a;
+      auto iter = maximumIterationIndexOfLoop.find(header);
+      if (iter != maximumIterationIndexOfLoop.end() && std::abs(distance) > iter->second) {
+        result.mayDepend = false;
+        return result;
+      }
+      result.distances[k] = distance;
+      result.isOnlyWithinTheSameIteration[k] = (distance == 0);
+      continue;
+    }
+
+    /*
+     * Banerjee test for the directions of the loop
+     */
+    auto isLessWithinBounds = isRightHandSideWithinBounds(header, LESS);
+    auto isGreaterWithinBounds = isRightHandSideWithinBounds(header, GREATER);
+    if (!isLessWithinBounds || !isGreaterWithinBounds) continue;
+    if (*isLessWithinBounds || *isGreaterWithinBounds) continue;
+    auto isEqualWithinBounds = isRightHandSideWithinBounds(header, EQUAL);
+    if (isEqualWithinBounds && !*isEqualWithinBounds) {
+      result.mayDepend = false;
+      return result;
+    }
+    result.isOnlyWithinTheSameIteration[k] = true;
+    result.distances[k] = 0;
+  }
+
+  return result;
+}
@@ -81,6 +81,61 @@ MemoryCloningAnalysis::MemoryCloningAnalysis (
     this->clonableMemoryLocations.insert(std::move(location));
   }
 
+  /*
+   * Check the heap objects allocated with a constant size before the loop.
+   */
+  auto header = loop->getHeader();
+  for (auto &I : instructions(function)){
+    auto call = dyn_cast<CallInst>(&I);
+    if (call == nullptr){
+      continue ;
+    }
+    auto sizeInBytes = ClonableMemoryLocation::getSizeOfHeapAllocation(call);
+    if (sizeInBytes == 0){
+      continue ;
+    }
+    if (  false
+          || loop->isIncluded(call)
+          || (!DS.DT.dominates(call->getParent(), header))
+       ){
+      continue ;
+    }
+
+    /*
+     * Check if the heap object is clonable.
+     */
+    auto location = std::make_unique<ClonableMemoryLocation>(call, nullptr, sizeInBytes * 8, loop, DS, ldg);
+    if (!location->isClonableLocation()) {
+      continue;
+    }
+    this->clonableMemoryLocations.insert(std::move(location));
+  }
+
+  /*
+   * Check the globals that only code of the current module can access.
+   */
+  for (auto &global : function->getParent()->globals()){
+    if (  false
+          || (!global.hasLocalLinkage())
+          || global.isConstant()
+          || global.isThreadLocal()
+          || (!global.getValueType()->isSized())
+       ){
+      continue ;
+    }
+
+    /*
+     * Check if the global is clonable.
+     */
+    auto globalType = global.getValueType();
+    auto sizeInBits = DL.getTypeAllocSizeInBits(globalType);
+    auto location = std::make_unique<ClonableMemoryLocation>(&global, globalType, sizeInBits, loop, DS, ldg);
+    if (!location->isClonableLocation()) {
+      continue;
+    }
+    this->clonableMemoryLocations.insert(std::move(location));
+  }
+
   return ;
 }
 
@@ -98,7 +153,7 @@ const ClonableMemoryLocation * MemoryCloningAnalysis::getClonableMemoryLocationF
    * TODO: Determine if it is worth mapping from instructions to locations
    */
   for (auto &location : this->clonableMemoryLocations) {
-    if (location->getAllocation() == I) {
+    if (location->getMemoryObject() == I) {
       return location.get();
     }
     if (location->isInstructionCastOrGEPOfLocation(I)) {
@@ -151,7 +206,7 @@ bool ClonableMemoryLocation::mustAliasAMemoryLocationWithinObject (Value *ptr) c
   /*
    * Same value.
    */
-  if (ptr == this->allocation){
+  if (ptr == this->memoryObject){
     return true;
   }
 
@@ -194,7 +249,8 @@ ClonableMemoryLocation::ClonableMemoryLocation (
   LoopStructure *loop,
   DominatorSummary &DS,
   PDG *ldg
-) : allocation{allocation}
+) : memoryObject{allocation}
+    ,allocation{allocation}
     ,sizeInBits{sizeInBits}
     ,loop{loop}
     ,isClonable{false}
@@ -250,6 +306,46 @@ ClonableMemoryLocation::ClonableMemoryLocation (
   return;
 }
 
+ClonableMemoryLocation::ClonableMemoryLocation (
+  Value *memoryObject,
+  Type *allocatedType,
+  uint64_t sizeInBits,
+  LoopStructure *loop,
+  DominatorSummary &DS,
+  PDG *ldg
+) : memoryObject{memoryObject}
+    ,allocation{nullptr}
+    ,allocatedType{allocatedType}
+    ,sizeInBits{sizeInBits}
+    ,loop{loop}
+    ,isClonable{false}
+    ,isScopeWithinLoop{false}
+{
+
+  /*
+   * Identify the instructions that access the object.
+   */
+  if (!this->identifyStoresAndOtherUsers(loop, DS)) {
+    return;
+  }
+
+  /*
+   * Heap objects and globals outlive the loop.
+   * Hence, their content must be dead at the beginning of every iteration, which is true if every read follows an overwrite of the whole object within the same iteration.
+   * Such overwrite also kills any value stored before the loop, so there is no need to check the RAW dependences from outside the loop.
+   */
+  if (!this->isEveryReadWithinLoopPrecededByAnOverwrite(loop, DS)){
+    return ;
+  }
+
+  /*
+   * The location is clonable.
+   */
+  this->isClonable = true;
+
+  return;
+}
+
 void ClonableMemoryLocation::setObjectScope (
   AllocaInst *allocation,
   LoopStructure *loop,
@@ -259,7 +355,7 @@ void ClonableMemoryLocation::setObjectScope (
   /*
    * Look for lifetime calls in the loop.
    */
-  for (auto inst : loop->getInstructions()){
+  for (auto inst : loop->instructions()){
 
     /*
      * Check if the current instruction is a call to lifetime intrinsics.
@@ -298,6 +394,26 @@ AllocaInst * ClonableMemoryLocation::getAllocation (void) const {
   return this->allocation;
 }
 
+Value * ClonableMemoryLocation::getMemoryObject (void) const {
+  return this->memoryObject;
+}
+
+uint64_t ClonableMemoryLocation::getSizeInBytes (void) const {
+  return this->sizeInBits / 8;
+}
+
+bool ClonableMemoryLocation::isStackObject (void) const {
+  return this->allocation != nullptr;
+}
+
+bool ClonableMemoryLocation::isGlobal (void) const {
+  return isa<GlobalVariable>(this->memoryObject);
+}
+
+bool ClonableMemoryLocation::isConstantCastOrGEPOfLocation (Constant *c) const {
+  return this->constantCastsAndGEPs.find(c) != this->constantCastsAndGEPs.end();
+}
+
 bool ClonableMemoryLocation::isClonableLocation (void) const {
   return this->isClonable;
 }
@@ -326,14 +442,61 @@ bool ClonableMemoryLocation::isMemCpyInstrinsicCall (CallInst *call) {
   return nameString.find("llvm.memcpy") != std::string::npos;
 }
 
+bool ClonableMemoryLocation::isMemSetInstrinsicCall (CallInst *call) {
+  auto calledFn = call->getCalledFunction();
+  if (!calledFn || !calledFn->hasName()) return false;
+  auto name = calledFn->getName();
+  std::string nameString = std::string(name.bytes_begin(), name.bytes_end());
+  return nameString.find("llvm.memset") != std::string::npos;
+}
+
+uint64_t ClonableMemoryLocation::getSizeOfHeapAllocation (CallInst *call) {
+  auto calledFn = call->getCalledFunction();
+  if (!calledFn || !calledFn->hasName()) return 0;
+
+  /*
+   * malloc(size)
+   */
+  if (  true
+        && (calledFn->getName() == "malloc")
+        && (call->getNumArgOperands() == 1)
+     ){
+    auto size = dyn_cast<ConstantInt>(call->getArgOperand(0));
+    if (size == nullptr){
+      return 0;
+    }
+    return size->getZExtValue();
+  }
+
+  /*
+   * calloc(number, size)
+   */
+  if (  true
+        && (calledFn->getName() == "calloc")
+        && (call->getNumArgOperands() == 2)
+     ){
+    auto number = dyn_cast<ConstantInt>(call->getArgOperand(0));
+    auto size = dyn_cast<ConstantInt>(call->getArgOperand(1));
+    if (  false
+          || (number == nullptr)
+          || (size == nullptr)
+       ){
+      return 0;
+    }
+    return number->getZExtValue() * size->getZExtValue();
+  }
+
+  return 0;
+}
+
 bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, DominatorSummary &DS) {
 
   /*
    * Determine all uses of the stack location.
    * Ensure they only exist within the loop provided.
    */
-  std::queue<Instruction *> allocationUses{};
-  allocationUses.push(this->allocation);
+  std::queue<Value *> allocationUses{};
+  allocationUses.push(this->memoryObject);
   while (!allocationUses.empty()) {
 
     /*
@@ -347,6 +510,25 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
      */
     for (auto user : I->users()) {
 
+      /*
+       * Heap objects and globals must be accessed only in ways that can be redirected to their private copies.
+       */
+      if (  true
+            && (!this->isStackObject())
+            && (!this->isUserOfNonStackObjectSupported(I, user, loop))
+         ){
+        return false;
+      }
+
+      /*
+       * Constant casts and GEPs of globals are not bound to any loop.
+       */
+      if (auto constantUser = dyn_cast<ConstantExpr>(user)) {
+        allocationUses.push(constantUser);
+        this->constantCastsAndGEPs.insert(constantUser);
+        continue;
+      }
+
       /*
        * Find storing and non-storing instructions
        */
@@ -395,11 +577,26 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
         }
 
         /*
-         * We consider llvm.memcpy as a storing instruction if the use is the dest (first operand) 
+         * Releasing a heap object after the loop doesn't read it.
+         */
+        if (!this->isStackObject()){
+          auto calledFn = call->getCalledFunction();
+          if (  true
+                && (calledFn != nullptr)
+                && (calledFn->getName() == "free")
+             ){
+            this->freeInstructions.insert(call);
+            continue;
+          }
+        }
+
+        /*
+         * We consider llvm.memcpy and llvm.memset as storing instructions if the use is the dest (first operand) 
          */
         auto isMemCpy = ClonableMemoryLocation::isMemCpyInstrinsicCall(call);
+        auto isMemSet = ClonableMemoryLocation::isMemSetInstrinsicCall(call);
         auto isUseTheDestinationOp = (call->getNumArgOperands() == 4) && (call->getArgOperand(0) == I);
-        if (isMemCpy && isUseTheDestinationOp) {
+        if ((isMemCpy || isMemSet) && isUseTheDestinationOp) {
           storingInstructions.insert(call);
         } else {
           this->nonStoringInstructions.insert(call);
@@ -445,6 +642,156 @@ bool ClonableMemoryLocation::identifyStoresAndOtherUsers (LoopStructure *loop, D
   return true;
 }
 
+bool ClonableMemoryLocation::isUserOfNonStackObjectSupported (Value *object, User *user, LoopStructure *loop) {
+
+  /*
+   * Only globals can have constant users.
+   */
+  if (auto constantUser = dyn_cast<ConstantExpr>(user)) {
+    return false
+           || (constantUser->getOpcode() == Instruction::BitCast)
+           || (constantUser->getOpcode() == Instruction::GetElementPtr);
+  }
+
+  /*
+   * All other users must be instructions of the function that includes the loop.
+   */
+  auto inst = dyn_cast<Instruction>(user);
+  if (  false
+        || (inst == nullptr)
+        || (inst->getFunction() != loop->getFunction())
+     ){
+    return false;
+  }
+
+  /*
+   * Aliases.
+   */
+  if (  false
+        || isa<BitCastInst>(inst)
+        || isa<GetElementPtrInst>(inst)
+     ){
+    return true;
+  }
+
+  /*
+   * Writes.
+   * Storing the pointer to the object would let other code access it.
+   */
+  if (auto store = dyn_cast<StoreInst>(inst)){
+    return store->getPointerOperand() == object;
+  }
+
+  /*
+   * Reads.
+   * The content of the object at the end of the loop is lost, so reads outside the loop are not supported.
+   */
+  if (isa<LoadInst>(inst)){
+    return loop->isIncluded(inst);
+  }
+
+  /*
+   * Calls.
+   */
+  if (auto call = dyn_cast<CallInst>(inst)){
+    if (call->isLifetimeStartOrEnd()){
+      return true;
+    }
+    auto isUseTheDestinationOp = (call->getNumArgOperands() == 4) && (call->getArgOperand(0) == object);
+    if (ClonableMemoryLocation::isMemSetInstrinsicCall(call)){
+      return isUseTheDestinationOp;
+    }
+    if (ClonableMemoryLocation::isMemCpyInstrinsicCall(call)){
+      return isUseTheDestinationOp || loop->isIncluded(call);
+    }
+    auto calledFn = call->getCalledFunction();
+    if (  true
+          && (calledFn != nullptr)
+          && (calledFn->getName() == "free")
+       ){
+      return (!this->isGlobal()) && (!loop->isIncluded(call));
+    }
+  }
+
+  return false;
+}
+
+bool ClonableMemoryLocation::isEveryReadWithinLoopPrecededByAnOverwrite (LoopStructure *loop, DominatorSummary &DS) const {
+
+  /*
+   * Fetch the overwrites of the whole object within the loop.
+   */
+  std::vector<Instruction *> overwrites;
+  for (auto storingInstruction : this->storingInstructions){
+    if (!loop->isIncluded(storingInstruction)){
+      continue ;
+    }
+    if (!this->isOverwritingTheWholeObject(storingInstruction)){
+      continue ;
+    }
+    overwrites.push_back(storingInstruction);
+  }
+
+  /*
+   * Every read must be dominated by an overwrite within the loop.
+   * Because the header of the loop dominates the overwrite, the latter executes within the same iteration of the read.
+   */
+  auto isPrecededByAnOverwrite = [&overwrites, &DS](Instruction *read) -> bool {
+    for (auto overwrite : overwrites){
+      if (overwrite == read){
+        continue ;
+      }
+      if (DS.DT.dominates(overwrite, read)){
+        return true;
+      }
+    }
+    return false;
+  };
+  for (auto reads : { &this->loadInstructions, &this->nonStoringInstructions }){
+    for (auto read : *reads){
+      if (!loop->isIncluded(read)){
+        return false;
+      }
+      if (!isPrecededByAnOverwrite(read)){
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool ClonableMemoryLocation::isOverwritingTheWholeObject (Instruction *storingInstruction) const {
+
+  /*
+   * Stores of a value as large as the object.
+   */
+  if (auto store = dyn_cast<StoreInst>(storingInstruction)){
+    if (store->getPointerOperand()->stripPointerCasts() != this->memoryObject){
+      return false;
+    }
+    auto &DL = store->getModule()->getDataLayout();
+    return DL.getTypeStoreSizeInBits(store->getValueOperand()->getType()) == this->sizeInBits;
+  }
+
+  /*
+   * llvm.memcpy and llvm.memset of the whole object.
+   */
+  auto call = dyn_cast<CallInst>(storingInstruction);
+  if (call == nullptr){
+    return false;
+  }
+  if (call->getArgOperand(0)->stripPointerCasts() != this->memoryObject){
+    return false;
+  }
+  auto bytesStoredConst = dyn_cast<ConstantInt>(call->getArgOperand(2));
+  if (!bytesStoredConst) {
+    return false;
+  }
+
+  return (bytesStoredConst->getZExtValue() * 8) == this->sizeInBits;
+}
+
 bool ClonableMemoryLocation::isThereRAWThroughMemoryFromOutsideLoop (
   LoopStructure *loop, 
   AllocaInst *al, 
@@ -678,7 +1025,10 @@ bool ClonableMemoryLocation::isOverrideSetFullyCoveringTheAllocationSpace (
       }
 
     } else if (auto call = dyn_cast<CallInst>(storingInstruction)) {
-      assert(ClonableMemoryLocation::isMemCpyInstrinsicCall(call));
+      assert(false
+        || ClonableMemoryLocation::isMemCpyInstrinsicCall(call)
+        || ClonableMemoryLocation::isMemSetInstrinsicCall(call)
+      );
 
       // call->print(errs() << "Examining llvm.memcpy call: "); errs() << "\n";
 
@@ -28,6 +28,8 @@ SCCAttrs::SCCAttrs (
     , loopCarriedVariables{}
     , isClonable{0}
     , isSCCClonableIntoLocalMemory{0}
+    , loopCarriedMemoryLocation{nullptr}
+    , minMaxTrackedByIndex{nullptr}
     , hasIV{0}
     , commutative{false}
   {
@@ -160,6 +162,18 @@ void SCCAttrs::collectPHIsAndAccumulators (LoopStructure &LS) {
         this->accumulators.insert(I);
         continue;
       }
+
+      /*
+       * Check if this is a min/max.
+       */
+      auto select = dyn_cast<SelectInst>(I);
+      if (  true
+            && (select != nullptr)
+            && (EvolutionUpdate::getComparisonOfMinMax(select) != nullptr)
+         ){
+        this->accumulators.insert(I);
+        continue;
+      }
     }
   }
 
@@ -345,14 +359,38 @@ void SCCAttrs::addClonableMemoryLocationsContainedInSCC (std::unordered_set<cons
   this->clonableMemoryLocations = locations;
 }
 
-std::unordered_set<AllocaInst *> SCCAttrs::getMemoryLocationsToClone (void) const {
-  std::unordered_set<AllocaInst *> allocations;
+std::unordered_set<Value *> SCCAttrs::getMemoryLocationsToClone (void) const {
+  std::unordered_set<Value *> allocations;
   for (auto location : clonableMemoryLocations) {
-    allocations.insert(location->getAllocation());
+    allocations.insert(location->getMemoryObject());
   }
   return allocations;
 }
 
+LoopCarriedMemoryLocation * SCCAttrs::getLoopCarriedMemoryLocation (void) const {
+  return this->loopCarriedMemoryLocation;
+}
+
+void SCCAttrs::setLoopCarriedMemoryLocation (LoopCarriedMemoryLocation *location) {
+  delete this->loopCarriedMemoryLocation;
+  this->loopCarriedMemoryLocation = location;
+}
+
+SCC * SCCAttrs::getMinMaxTrackedByIndex (void) const {
+  return this->minMaxTrackedByIndex;
+}
+
+void SCCAttrs::setSCCToBeIndexOfMinMax (SCC *minMaxSCC, SelectInst *indexUpdate) {
+  this->minMaxTrackedByIndex = minMaxSCC;
+
+  /*
+   * The update of the index is the accumulator of the SCC.
+   */
+  this->accumulators.insert(indexUpdate);
+
+  return ;
+}
+
 bool SCCAttrs::mustExecuteSequentially (void) const {
   return this->getType() == SCCAttrs::SCCType::SEQUENTIAL;
 }
@@ -377,6 +415,7 @@ SCCAttrs::~SCCAttrs () {
   for (auto var : loopCarriedVariables) {
     delete var;
   }
+  delete this->loopCarriedMemoryLocation;
 }
 
 }
@@ -14,6 +14,8 @@
 
 namespace llvm::noelle{
 
+static cl::opt<int> SCCDAGAttrsThreads("noelle-sccdag-attrs-threads", cl::ZeroOrMore, cl::Hidden, cl::init(1), cl::desc("Number of threads used to classify the SCCs of a loop (0: all logical cores)"));
+
 SCCDAGAttrs::SCCDAGAttrs (
   bool enableFloatAsReal,
   PDG *loopDG,
@@ -22,6 +24,21 @@ SCCDAGAttrs::SCCDAGAttrs (
   ScalarEvolution &SE,
   InductionVariableManager &IV,
   DominatorSummary &DS
+) : SCCDAGAttrs{enableFloatAsReal, loopDG, loopSCCDAG, LIS, SE, IV, DS, (SCCDAGAttrsThreads.getValue() > 0) ? ((uint32_t)SCCDAGAttrsThreads.getValue()) : std::thread::hardware_concurrency()}
+  {
+
+  return ;
+}
+
+SCCDAGAttrs::SCCDAGAttrs (
+  bool enableFloatAsReal,
+  PDG *loopDG,
+  SCCDAG *loopSCCDAG,
+  LoopsSummary &LIS,
+  ScalarEvolution &SE,
+  InductionVariableManager &IV,
+  DominatorSummary &DS,
+  uint32_t numberOfThreads
 ) : 
   enableFloatAsReal{enableFloatAsReal}, loopDG{loopDG}, sccdag{loopSCCDAG}, memoryCloningAnalysis{nullptr} 
   {
@@ -62,16 +79,31 @@ SCCDAGAttrs::SCCDAGAttrs (
   auto rootLoop = LIS.getLoopNestingTreeRoot();
   this->memoryCloningAnalysis = new MemoryCloningAnalysis(rootLoop, DS, loopDG);
 
+  /*
+   * Fetch the SCCs to tag.
+   * Their entries in the map of the metadata are created here, so the tagging of an SCC never changes the structure of the map and SCCs can be tagged concurrently.
+   */
+  std::vector<SCC *> sccs;
+  loopSCCDAG->iterateOverSCCs([this, &sccs](SCC *scc) -> bool {
+    sccs.push_back(scc);
+    this->sccToInfo[scc] = nullptr;
+    return false;
+  });
+
   /*
    * Tag SCCs depending on their characteristics.
+   *
+   * The tagging of an SCC only reads the dependences, the SCCDAG, the loops, and the induction variables, and it only writes the metadata of that SCC.
+   * Scalar evolution is not queried, as its cache is not thread-safe; the SCEV facts needed (e.g., the steps of the induction variables) have already been computed by the induction variable manager.
+   * Hence, the result does not depend on how many threads tag the SCCs.
    */
-  loopSCCDAG->iterateOverSCCs([this, &SE, &LIS, &ivs, &loopGoverningIVs](SCC *scc) -> bool {
+  auto tagSCC = [this, &LIS, &ivs, &loopGoverningIVs](SCC *scc) -> void {
 
     /*
      * Allocate the metadata about this SCC.
      */
     auto sccInfo = new SCCAttrs(scc, this->accumOpInfo, LIS);
-    this->sccToInfo[scc] = sccInfo;
+    this->sccToInfo.at(scc) = sccInfo;
 
     /*
      * Collect information about the current SCC.
@@ -79,7 +111,7 @@ SCCDAGAttrs::SCCDAGAttrs (
     bool doesSCCOnlyContainIV = this->checkIfSCCOnlyContainsInductionVariables(scc, LIS, ivs, loopGoverningIVs);
     sccInfo->setSCCToBeInductionVariable(doesSCCOnlyContainIV);
 
-    this->checkIfClonable(scc, SE, LIS);
+    this->checkIfClonable(scc, LIS);
 
     /*
      * Categorize the current SCC.
@@ -92,10 +124,41 @@ SCCDAGAttrs::SCCDAGAttrs (
 
     } else {
       sccInfo->setType(SCCAttrs::SCCType::SEQUENTIAL);
+      this->checkIfReducibleThroughMemory(scc, LIS);
     }
 
-    return false;
-  });
+    return ;
+  };
+  numberOfThreads = std::min<uint32_t>(numberOfThreads, sccs.size());
+  if (numberOfThreads <= 1){
+    for (auto scc : sccs){
+      tagSCC(scc);
+    }
+
+  } else {
+
+    /*
+     * Each thread of the pool tags the next SCC that has not been tagged yet until none is left.
+     */
+    std::atomic<uint64_t> nextSCCIndex{0};
+    auto tagSCCs = [&sccs, &nextSCCIndex, &tagSCC](void) -> void {
+      for (auto index = nextSCCIndex++; index < sccs.size(); index = nextSCCIndex++){
+        tagSCC(sccs[index]);
+      }
+    };
+    std::vector<std::thread> pool;
+    for (uint32_t i = 0; i < numberOfThreads; i++){
+      pool.emplace_back(tagSCCs);
+    }
+    for (auto &thread : pool){
+      thread.join();
+    }
+  }
+
+  /*
+   * Indices of min/max (e.g., argmin) can be reduced together with their min/max.
+   */
+  this->checkIfIndicesOfMinMaxAreReducible(LIS, IV);
 
   collectSCCGraphAssumingDistributedClones();
 
@@ -512,14 +575,309 @@ bool SCCDAGAttrs::checkIfReducible (SCC *scc, LoopsSummary &LIS) {
   return true;
 }
 
+void SCCDAGAttrs::checkIfReducibleThroughMemory (SCC *scc, LoopsSummary &LIS) {
+
+  /*
+   * All loop-carried data dependences must be between loads and stores of the same memory location.
+   */
+  Value *memoryLocation = nullptr;
+  for (auto dependency : this->sccToLoopCarriedDependencies.at(scc)) {
+
+    /*
+     * Ignore external control dependencies, do not allow internal ones
+     */
+    if (dependency->isControlDependence()) {
+      if (scc->isInternal(dependency->getOutgoingT())) {
+        return ;
+      }
+      continue;
+    }
+    if (!dependency->isMemoryDependence()) {
+      return ;
+    }
+
+    for (auto value : { dependency->getOutgoingT(), dependency->getIncomingT() }) {
+      auto inst = dyn_cast<Instruction>(value);
+      if (inst == nullptr) {
+        return ;
+      }
+      auto location = LoopCarriedMemoryLocation::getMemoryLocationAccessedBy(inst);
+      if (location == nullptr) {
+        return ;
+      }
+      if (memoryLocation == nullptr) {
+        memoryLocation = location;
+      }
+      if (memoryLocation != location) {
+        return ;
+      }
+    }
+  }
+  if (memoryLocation == nullptr) {
+    return ;
+  }
+
+  /*
+   * Check if the memory location only evolves through updates that can be reduced.
+   */
+  auto rootLoop = LIS.getLoopNestingTreeRoot();
+  auto location = new LoopCarriedMemoryLocation(*rootLoop, *loopDG, *scc, memoryLocation);
+  if (!location->isEvolutionReducibleAcrossLoopIterations()) {
+    delete location;
+    return ;
+  }
+  for (auto dependency : this->sccToLoopCarriedDependencies.at(scc)) {
+    if (!dependency->isMemoryDependence()) {
+      continue ;
+    }
+    if (  false
+          || (!location->isLoadOrStoreOfUpdate(cast<Instruction>(dependency->getOutgoingT())))
+          || (!location->isLoadOrStoreOfUpdate(cast<Instruction>(dependency->getIncomingT())))
+       ){
+      delete location;
+      return ;
+    }
+  }
+
+  /*
+   * Check if floating point accumulators can be considered as real numbers.
+   */
+  auto accumulatorType = location->getAccumulatorType();
+  if (  true
+        && accumulatorType->isFloatingPointTy()
+        && (!this->enableFloatAsReal)
+    ){
+    delete location;
+    return ;
+  }
+
+  /*
+   * The memory location can be reduced.
+   */
+  auto sccInfo = this->getSCCAttrs(scc);
+  sccInfo->setLoopCarriedMemoryLocation(location);
+
+  return ;
+}
+
 /*
  * The SCC is independent if it doesn't have loop carried data dependencies
  */
+void SCCDAGAttrs::checkIfIndicesOfMinMaxAreReducible (LoopsSummary &LIS, InductionVariableManager &IV) {
+
+  /*
+   * Fetch the reducible min/max variables.
+   */
+  std::vector<SCC *> minMaxSCCs;
+  for (auto &sccInfoPair : this->sccToInfo) {
+    auto sccInfo = sccInfoPair.second;
+    if (sccInfo->getType() != SCCAttrs::SCCType::REDUCIBLE) {
+      continue ;
+    }
+    auto variable = sccInfo->getSingleLoopCarriedVariable();
+    if (  false
+          || (variable == nullptr)
+          || (variable->getMinMaxPredicate() == CmpInst::BAD_ICMP_PREDICATE)
+       ){
+      continue ;
+    }
+    minMaxSCCs.push_back(sccInfoPair.first);
+  }
+
+  for (auto minMaxSCC : minMaxSCCs) {
+    auto minMaxSCCInfo = this->getSCCAttrs(minMaxSCC);
+
+    /*
+     * Fetch the values that depend on the comparisons of the min/max updates, other than the updates themselves.
+     */
+    std::unordered_set<SelectInst *> minMaxUpdates;
+    std::unordered_set<Instruction *> usersOfComparisons;
+    CmpInst *comparison = nullptr;
+    for (auto accumulator : minMaxSCCInfo->getAccumulators()) {
+      auto select = dyn_cast<SelectInst>(accumulator);
+      if (select == nullptr) {
+        continue ;
+      }
+      minMaxUpdates.insert(select);
+      comparison = cast<CmpInst>(select->getCondition());
+      for (auto user : comparison->users()) {
+        auto userInst = cast<Instruction>(user);
+        if (minMaxSCC->isInternal(userInst)) {
+          continue ;
+        }
+        usersOfComparisons.insert(userInst);
+      }
+    }
+    if (usersOfComparisons.size() == 0) {
+      continue ;
+    }
+
+    /*
+     * Each user of the comparison must be the update of an index of the min/max.
+     * Otherwise, the min/max is needed by the other iterations and it must be computed sequentially.
+     */
+    std::vector<std::pair<SCC *, SelectInst *>> indices;
+    for (auto user : usersOfComparisons) {
+      auto indexSCC = this->sccdag->sccOfValue(user);
+      SelectInst *indexUpdate = nullptr;
+      if (minMaxUpdates.size() == 1) {
+        indexUpdate = this->getIndexUpdateOfMinMax(indexSCC, minMaxSCC, comparison, LIS, IV);
+      }
+      if (indexUpdate != user) {
+        indices.clear();
+        break ;
+      }
+      indices.push_back(std::make_pair(indexSCC, indexUpdate));
+    }
+    if (indices.size() == 0) {
+      minMaxSCCInfo->setType(SCCAttrs::SCCType::SEQUENTIAL);
+      continue ;
+    }
+
+    /*
+     * The indices can be reduced together with the min/max.
+     */
+    auto rootLoop = LIS.getLoopNestingTreeRoot();
+    for (auto &index : indices) {
+      auto indexSCC = index.first;
+      auto indexUpdate = index.second;
+      auto indexPHI = indexSCC->isInternal(indexUpdate->getTrueValue()) ? cast<PHINode>(indexUpdate->getTrueValue()) : cast<PHINode>(indexUpdate->getFalseValue());
+      auto indexSCCInfo = this->getSCCAttrs(indexSCC);
+      indexSCCInfo->addLoopCarriedVariable(new LoopCarriedVariable(*rootLoop, LIS, *loopDG, *sccdag, *indexSCC, indexPHI));
+      indexSCCInfo->setSCCToBeIndexOfMinMax(minMaxSCC, indexUpdate);
+      indexSCCInfo->setType(SCCAttrs::SCCType::REDUCIBLE);
+    }
+  }
+
+  return ;
+}
+
+SelectInst * SCCDAGAttrs::getIndexUpdateOfMinMax (SCC *indexSCC, SCC *minMaxSCC, CmpInst *comparison, LoopsSummary &LIS, InductionVariableManager &IV) const {
+
+  /*
+   * The index must be a variable that is computed sequentially only because of the min/max.
+   * Its SCC must be composed of a PHI of the header of the loop and of the select that updates it.
+   */
+  auto indexSCCInfo = this->getSCCAttrs(indexSCC);
+  if (  false
+        || (indexSCCInfo->getType() != SCCAttrs::SCCType::SEQUENTIAL)
+        || (indexSCCInfo->getLoopCarriedMemoryLocation() != nullptr)
+        || (indexSCC->numberOfInstructions() != 2)
+     ){
+    return nullptr;
+  }
+  auto rootLoop = LIS.getLoopNestingTreeRoot();
+  PHINode *indexPHI = nullptr;
+  SelectInst *indexUpdate = nullptr;
+  for (auto nodePair : indexSCC->internalNodePairs()) {
+    auto value = nodePair.first;
+    if (auto phi = dyn_cast<PHINode>(value)) {
+      indexPHI = phi;
+    } else if (auto select = dyn_cast<SelectInst>(value)) {
+      indexUpdate = select;
+    }
+  }
+  if (  false
+        || (indexPHI == nullptr)
+        || (indexUpdate == nullptr)
+        || (indexPHI->getParent() != rootLoop->getHeader())
+        || (indexUpdate->getCondition() != comparison)
+     ){
+    return nullptr;
+  }
+
+  /*
+   * The index must start from a constant and it must be updated only by the select.
+   */
+  auto preHeader = rootLoop->getPreHeader();
+  ConstantInt *initialIndex = nullptr;
+  for (auto i = 0u; i < indexPHI->getNumIncomingValues(); i++) {
+    auto incomingValue = indexPHI->getIncomingValue(i);
+    if (indexPHI->getIncomingBlock(i) == preHeader) {
+      initialIndex = dyn_cast<ConstantInt>(incomingValue);
+      continue ;
+    }
+    if (incomingValue != indexUpdate) {
+      return nullptr;
+    }
+  }
+  if (initialIndex == nullptr) {
+    return nullptr;
+  }
+
+  /*
+   * The select must pick the new index when the min/max picks the new value, and keep the current index otherwise.
+   */
+  SelectInst *minMaxUpdate = nullptr;
+  for (auto user : comparison->users()) {
+    if (minMaxSCC->isInternal(user)) {
+      minMaxUpdate = cast<SelectInst>(user);
+    }
+  }
+  auto isNewValuePickedWhenTrue = !minMaxSCC->isInternal(minMaxUpdate->getTrueValue());
+  auto newIndex = isNewValuePickedWhenTrue ? indexUpdate->getTrueValue() : indexUpdate->getFalseValue();
+  auto currentIndex = isNewValuePickedWhenTrue ? indexUpdate->getFalseValue() : indexUpdate->getTrueValue();
+  if (currentIndex != indexPHI) {
+    return nullptr;
+  }
+
+  /*
+   * The new index must be the position of the current iteration.
+   * Ties between equal min/max values are broken by the position, so the induction variable must increase and it must start after the initial index.
+   */
+  if (auto extension = dyn_cast<SExtInst>(newIndex)) {
+    newIndex = extension->getOperand(0);
+  }
+  auto newIndexInst = dyn_cast<Instruction>(newIndex);
+  if (newIndexInst == nullptr) {
+    return nullptr;
+  }
+  auto iv = IV.getInductionVariable(*rootLoop, newIndexInst);
+  if (  false
+        || (iv == nullptr)
+        || (iv->getLoopEntryPHI() != newIndexInst)
+        || (!iv->isStepValuePositive())
+     ){
+    return nullptr;
+  }
+  auto startIndex = dyn_cast<ConstantInt>(iv->getStartValue());
+  if (  false
+        || (startIndex == nullptr)
+        || (initialIndex->getSExtValue() > startIndex->getSExtValue())
+     ){
+    return nullptr;
+  }
+
+  /*
+   * The index must not be used within the loop other than by its own update.
+   */
+  for (auto user : indexPHI->users()) {
+    auto userInst = cast<Instruction>(user);
+    if (  true
+          && (userInst != indexUpdate)
+          && rootLoop->isIncluded(userInst)
+       ){
+      return nullptr;
+    }
+  }
+  for (auto user : indexUpdate->users()) {
+    auto userInst = cast<Instruction>(user);
+    if (  true
+          && (userInst != indexPHI)
+          && rootLoop->isIncluded(userInst)
+       ){
+      return nullptr;
+    }
+  }
+
+  return indexUpdate;
+}
+
 bool SCCDAGAttrs::checkIfIndependent (SCC *scc) {
   return this->sccToLoopCarriedDependencies.find(scc) == this->sccToLoopCarriedDependencies.end();
 }
 
-void SCCDAGAttrs::checkIfClonable (SCC *scc, ScalarEvolution &SE, LoopsSummary &LIS) {
+void SCCDAGAttrs::checkIfClonable (SCC *scc, LoopsSummary &LIS) {
 
   /*
    * Check the simple cases.
@@ -589,7 +947,7 @@ void SCCDAGAttrs::checkIfClonableByUsingLocalMemory(SCC *scc, LoopsSummary &LIS)
     /*
      * The current loop-carried dependence can be removed by cloning.
      */
-    // location->getAllocation()->print(errs() << "Location found: "); errs() << "\n";
+    // location->getMemoryObject()->print(errs() << "Location found: "); errs() << "\n";
     locations.insert(location);
   }
 
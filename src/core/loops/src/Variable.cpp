@@ -10,6 +10,7 @@
  */
 #include "Variable.hpp"
 #include "LoopCarriedDependencies.hpp"
+#include "MemoryCloningAnalysis.hpp"
 
 using namespace llvm;
 using namespace llvm::noelle;
@@ -100,6 +101,19 @@ LoopCarriedVariable::LoopCarriedVariable (
 
     if (auto selectInst = dyn_cast<SelectInst>(value)) {
 
+      /*
+       * The condition of a min/max update compares the current value of the variable with the new one.
+       * Hence, it doesn't control which update is applied to the variable.
+       */
+      auto isTrueValueInternal = sccOfDataAndMemoryVariableValuesOnly->isInternal(selectInst->getTrueValue());
+      auto isFalseValueInternal = sccOfDataAndMemoryVariableValuesOnly->isInternal(selectInst->getFalseValue());
+      if (  true
+            && (EvolutionUpdate::getComparisonOfMinMax(selectInst) != nullptr)
+            && (isTrueValueInternal != isFalseValueInternal)
+         ){
+        continue;
+      }
+
       /*
        * Select instructions contain a condition that controls the evolution of the variable 
        * There is no need to check them for producing control dependencies, so we continue
@@ -189,7 +203,13 @@ bool LoopCarriedVariable::isEvolutionReducibleAcrossLoopIterations (void) const
     if (update->mayUpdateBeOverride()) return false;
 
     auto updateInstruction = update->getUpdateInstruction();
-    if (isa<PHINode>(updateInstruction) || isa<SelectInst>(updateInstruction)) continue;
+    if (isa<PHINode>(updateInstruction)) continue;
+    if (isa<SelectInst>(updateInstruction) && !update->isMinMax()) continue;
+
+    /*
+     * Comparisons can only be used by selects (see mayUpdateBeOverride), which are the updates that evolve the variable
+     */
+    if (isa<CmpInst>(updateInstruction)) continue;
     arithmeticUpdates.insert(update);
   }
 
@@ -266,6 +286,16 @@ PDG *LoopCarriedVariable::produceDataAndMemoryOnlyDGFromVariableDG(PDG &variable
 std::unordered_set<Value *> LoopCarriedVariable::getConsumersOfVariable (void) const {
   std::unordered_set<Value *> consumers;
 
+  /*
+   * Fetch the comparisons of the min/max updates
+   */
+  std::unordered_set<Value *> minMaxComparisons;
+  for (auto update : variableUpdates) {
+    if (!update->isMinMax()) continue;
+    auto select = cast<SelectInst>(update->getUpdateInstruction());
+    minMaxComparisons.insert(select->getCondition());
+  }
+
   for (auto externalNodePair : sccOfVariableOnly->externalNodePairs()) {
     auto value = externalNodePair.first;
     if (!isa<Instruction>(value)) continue;
@@ -281,6 +311,20 @@ std::unordered_set<Value *> LoopCarriedVariable::getConsumersOfVariable (void) c
       auto producer = edge->getOutgoingT();
       if (sccOfVariableOnly->isExternal(producer)) continue;
 
+      /*
+       * Selects that use the comparison of a min/max update only as their condition (e.g., the index of a minimum) do not consume the variable
+       * They can be reduced only together with the variable, which is checked by SCCDAGAttrs
+       */
+      auto consumerSelect = dyn_cast<SelectInst>(consumer);
+      if (  true
+            && (consumerSelect != nullptr)
+            && (minMaxComparisons.find(producer) != minMaxComparisons.end())
+            && (consumerSelect->getTrueValue() != producer)
+            && (consumerSelect->getFalseValue() != producer)
+         ){
+        continue;
+      }
+
       /*
        * This is a loop internal consumer of the variable
        */
@@ -384,6 +428,14 @@ PHINode *LoopCarriedVariable::getLoopEntryPHIForValueOfVariable (Value *value) c
   return cast<PHINode>(declarationValue);
 }
 
+CmpInst::Predicate LoopCarriedVariable::getMinMaxPredicate (void) const {
+  for (auto update : variableUpdates) {
+    if (update->isMinMax()) return update->getMinMaxPredicate();
+  }
+
+  return CmpInst::BAD_ICMP_PREDICATE;
+}
+
 bool LoopCarriedVariable::hasRoundingError (std::unordered_set<EvolutionUpdate *> &arithmeticUpdates) const {
 
   /*
@@ -422,26 +474,324 @@ bool LoopCarriedVariable::hasRoundingError (std::unordered_set<EvolutionUpdate *
  * LoopCarriedMemoryLocation implementation
  */
 
-/*
- * TODO: Implement
- */
 LoopCarriedMemoryLocation::LoopCarriedMemoryLocation (
   const LoopStructure &loop,
   PDG &loopDG,
   SCC &memoryLocationSCC,
   Value *memoryLocation
-) {}
+) : isValid{false}, memoryLocation{memoryLocation}, accumulatorType{nullptr}, sizeInBytes{0} {
+
+  /*
+   * The memory location must be the same for all iterations.
+   */
+  if (auto memoryLocationInst = dyn_cast<Instruction>(memoryLocation)) {
+    if (loop.isIncluded(memoryLocationInst)) return ;
+  }
+
+  /*
+   * Identify the updates of the memory location.
+   */
+  if (!this->identifyUpdates(loop, memoryLocationSCC)) return ;
+
+  /*
+   * Check if we know how many accumulators the memory location includes.
+   */
+  this->computeSizeOfArrayOfAccumulators();
+
+  this->isValid = true;
+}
 
 bool LoopCarriedMemoryLocation::isEvolutionReducibleAcrossLoopIterations (void) const {
+  return this->isValid;
+}
+
+Value * LoopCarriedMemoryLocation::getMemoryLocation (void) const {
+  return this->memoryLocation;
+}
+
+Type * LoopCarriedMemoryLocation::getAccumulatorType (void) const {
+  return this->accumulatorType;
+}
+
+uint64_t LoopCarriedMemoryLocation::getSizeInBytes (void) const {
+  return this->sizeInBytes;
+}
+
+const std::vector<LoopCarriedMemoryLocation::MemoryUpdate> & LoopCarriedMemoryLocation::getUpdates (void) const {
+  return this->updates;
+}
+
+bool LoopCarriedMemoryLocation::isLoadOrStoreOfUpdate (Instruction *inst) const {
+  if (auto load = dyn_cast<LoadInst>(inst)) {
+    return this->loads.find(load) != this->loads.end();
+  }
+  if (auto store = dyn_cast<StoreInst>(inst)) {
+    return this->stores.find(store) != this->stores.end();
+  }
+  return false;
+}
+
+Value * LoopCarriedMemoryLocation::getMemoryLocationAccessedBy (Instruction *memoryInstruction) {
+  Value *pointer = nullptr;
+  if (auto load = dyn_cast<LoadInst>(memoryInstruction)) {
+    pointer = load->getPointerOperand();
+  } else if (auto store = dyn_cast<StoreInst>(memoryInstruction)) {
+    pointer = store->getPointerOperand();
+  } else {
+    return nullptr;
+  }
+
+  while (true) {
+    pointer = pointer->stripPointerCasts();
+    auto gep = dyn_cast<GEPOperator>(pointer);
+    if (gep == nullptr) break;
+    pointer = gep->getPointerOperand();
+  }
+
+  return pointer;
+}
+
+bool LoopCarriedMemoryLocation::identifyUpdates (const LoopStructure &loop, SCC &memoryLocationSCC) {
+
+  /*
+   * Collect the loads and stores within the loop that access the memory location.
+   * Pointers to the memory location can only be derived through casts and GEPs, and loads and stores can only use them as pointers.
+   * Any other use within the loop could access the memory location in ways that are not updates.
+   */
+  std::queue<Value *> pointers;
+  std::unordered_set<Value *> visitedPointers;
+  pointers.push(this->memoryLocation);
+  visitedPointers.insert(this->memoryLocation);
+  while (!pointers.empty()) {
+    auto pointer = pointers.front();
+    pointers.pop();
+
+    for (auto user : pointer->users()) {
+
+      /*
+       * Constant casts and GEPs of globals.
+       */
+      if (auto constantUser = dyn_cast<ConstantExpr>(user)) {
+        if (  false
+              || (constantUser->getOpcode() == Instruction::BitCast)
+              || (constantUser->getOpcode() == Instruction::GetElementPtr)
+           ) {
+          if (visitedPointers.insert(constantUser).second) pointers.push(constantUser);
+          continue;
+        }
+        return false;
+      }
+      auto inst = dyn_cast<Instruction>(user);
+      if (inst == nullptr) return false;
+
+      /*
+       * Accesses from other functions are captured by the dependences of the calls to them.
+       */
+      if (inst->getFunction() != loop.getFunction()) continue;
+
+      /*
+       * Aliases.
+       */
+      if (isa<BitCastInst>(inst) || isa<GetElementPtrInst>(inst)) {
+        if (visitedPointers.insert(inst).second) pointers.push(inst);
+        continue;
+      }
+      if (!loop.isIncluded(inst)) continue;
+
+      /*
+       * Accesses.
+       */
+      if (auto load = dyn_cast<LoadInst>(inst)) {
+        if (!load->isSimple()) return false;
+        this->loads.insert(load);
+        continue;
+      }
+      if (auto store = dyn_cast<StoreInst>(inst)) {
+        if (  false
+              || (store->getPointerOperand() != pointer)
+              || (!store->isSimple())
+           ) {
+          return false;
+        }
+        this->stores.insert(store);
+        continue;
+      }
+      return false;
+    }
+  }
+  if (this->stores.size() == 0) return false;
+
+  /*
+   * Every store must update an element of the memory location: store(p, load(p) + v) or store(p, load(p) - v).
+   */
+  auto isTheSameAddress = [](Value *pointer1, Value *pointer2) -> bool {
+    if (pointer1 == pointer2) return true;
+    auto gep1 = dyn_cast<GetElementPtrInst>(pointer1);
+    auto gep2 = dyn_cast<GetElementPtrInst>(pointer2);
+    return gep1 && gep2 && gep1->isIdenticalTo(gep2);
+  };
+  for (auto store : this->stores) {
+
+    /*
+     * Only additive updates can be reduced.
+     */
+    auto operation = dyn_cast<BinaryOperator>(store->getValueOperand());
+    if (operation == nullptr) return false;
+    auto opcode = operation->getOpcode();
+    auto isSubtraction = (opcode == Instruction::Sub) || (opcode == Instruction::FSub);
+    if (  true
+          && (opcode != Instruction::Add)
+          && (opcode != Instruction::FAdd)
+          && (!isSubtraction)
+       ) {
+      return false;
+    }
+
+    /*
+     * Fetch the load of the element that is updated.
+     * The element must be the minuend of subtractions.
+     */
+    LoadInst *load = nullptr;
+    Value *operand = nullptr;
+    for (auto i = 0; i < 2; i++) {
+      auto candidate = dyn_cast<LoadInst>(operation->getOperand(i));
+      if (  false
+            || (candidate == nullptr)
+            || (this->loads.find(candidate) == this->loads.end())
+            || (!isTheSameAddress(candidate->getPointerOperand(), store->getPointerOperand()))
+            || (isSubtraction && (i == 1))
+         ) {
+        continue;
+      }
+      load = candidate;
+      operand = operation->getOperand(1 - i);
+      break;
+    }
+    if (load == nullptr) return false;
+
+    /*
+     * The old and the new values of the element must not be used elsewhere.
+     * Also, no other access to the memory location can happen between the load and the store.
+     */
+    if (!load->hasOneUse() || !operation->hasOneUse()) return false;
+    if (load->getParent() != store->getParent()) return false;
+    for (auto inst = load->getNextNode(); inst != store; inst = inst->getNextNode()) {
+      if (inst == nullptr) return false;
+      if (this->isLoadOrStoreOfUpdate(inst)) return false;
+    }
+
+    /*
+     * The value added to the element must not depend on the memory location.
+     */
+    if (this->isValueDependentOnLocation(loop, operand)) return false;
+
+    /*
+     * All updates must accumulate values of the same type.
+     */
+    auto type = operation->getType();
+    if (this->accumulatorType == nullptr) this->accumulatorType = type;
+    if (this->accumulatorType != type) return false;
+
+    /*
+     * All updates must belong to the SCC.
+     */
+    if (!memoryLocationSCC.isInternal(load) || !memoryLocationSCC.isInternal(store)) return false;
+
+    this->updates.push_back({ load, operation, store, operand });
+  }
+
+  /*
+   * Every load must be the one of an update.
+   */
+  if (this->updates.size() != this->loads.size()) return false;
+
+  /*
+   * Only accumulators of 8, 16, 32, or 64 bits integers, floats, and doubles are supported.
+   */
+  if (auto integerType = dyn_cast<IntegerType>(this->accumulatorType)) {
+    auto bits = integerType->getBitWidth();
+    return (bits == 8) || (bits == 16) || (bits == 32) || (bits == 64);
+  }
+  return this->accumulatorType->isFloatTy() || this->accumulatorType->isDoubleTy();
+}
+
+bool LoopCarriedMemoryLocation::isValueDependentOnLocation (const LoopStructure &loop, Value *value) const {
+  std::queue<Instruction *> toCheck;
+  std::unordered_set<Instruction *> checked;
+  if (auto inst = dyn_cast<Instruction>(value)) toCheck.push(inst);
+  while (!toCheck.empty()) {
+    auto inst = toCheck.front();
+    toCheck.pop();
+    if (!checked.insert(inst).second) continue;
+    if (!loop.isIncluded(inst)) continue;
+    if (this->isLoadOrStoreOfUpdate(inst)) return true;
+
+    for (auto &op : inst->operands()) {
+      if (auto opInst = dyn_cast<Instruction>(op.get())) toCheck.push(opInst);
+    }
+  }
+
   return false;
 }
 
+void LoopCarriedMemoryLocation::computeSizeOfArrayOfAccumulators (void) {
+  auto &DL = this->updates[0].store->getModule()->getDataLayout();
+  auto accumulatorSize = DL.getTypeAllocSize(this->accumulatorType);
+
+  /*
+   * Heap objects do not have a type, so every update must access an accumulator by indexing the object.
+   */
+  if (auto call = dyn_cast<CallInst>(this->memoryLocation)) {
+    auto heapObjectSize = ClonableMemoryLocation::getSizeOfHeapAllocation(call);
+    if (  false
+          || (heapObjectSize == 0)
+          || ((heapObjectSize % accumulatorSize) != 0)
+       ) {
+      return ;
+    }
+    for (auto &update : this->updates) {
+      auto gep = dyn_cast<GetElementPtrInst>(update.store->getPointerOperand());
+      if (  false
+            || (gep == nullptr)
+            || (gep->getNumIndices() != 1)
+            || (gep->getSourceElementType() != this->accumulatorType)
+            || (gep->getPointerOperand()->stripPointerCasts() != this->memoryLocation)
+         ) {
+        return ;
+      }
+    }
+    this->sizeInBytes = heapObjectSize;
+    return ;
+  }
+
+  /*
+   * Stack objects and globals must be (possibly multi-dimensional) arrays of accumulators.
+   */
+  Type *objectType = nullptr;
+  if (auto alloca = dyn_cast<AllocaInst>(this->memoryLocation)) {
+    if (alloca->isArrayAllocation()) return ;
+    objectType = alloca->getAllocatedType();
+  } else if (auto global = dyn_cast<GlobalVariable>(this->memoryLocation)) {
+    objectType = global->getValueType();
+  } else {
+    return ;
+  }
+  auto elementType = objectType;
+  while (auto arrayType = dyn_cast<ArrayType>(elementType)) {
+    elementType = arrayType->getElementType();
+  }
+  if (elementType != this->accumulatorType) return ;
+  this->sizeInBytes = DL.getTypeAllocSize(objectType);
+
+  return ;
+}
+
 /************************************************************************************
  * VariableUpdate implementation
  */
 
 EvolutionUpdate::EvolutionUpdate (Instruction *updateInstruction, SCC *dataMemoryVariableSCC)
-  : updateInstruction{updateInstruction} {
+  : updateInstruction{updateInstruction}, minMaxPredicate{CmpInst::BAD_ICMP_PREDICATE} {
 
   if (auto storeUpdate = dyn_cast<StoreInst>(updateInstruction)) {
 
@@ -463,9 +813,74 @@ EvolutionUpdate::EvolutionUpdate (Instruction *updateInstruction, SCC *dataMemor
       externalValuesUsed.insert(&use);
     }
   }
+
+  /*
+   * Check if this is a min/max update of a number, which picks between the current value of the variable and a new one
+   */
+  auto select = dyn_cast<SelectInst>(updateInstruction);
+  if (!select) return;
+  auto comparison = getComparisonOfMinMax(select);
+  if (!comparison) return;
+  if (!select->getType()->isIntegerTy() && !select->getType()->isFloatingPointTy()) return;
+  auto isTrueValueInternal = dataMemoryVariableSCC->isInternal(select->getTrueValue());
+  auto isFalseValueInternal = dataMemoryVariableSCC->isInternal(select->getFalseValue());
+  if (isTrueValueInternal == isFalseValueInternal) return;
+
+  /*
+   * Normalize the predicate to compare the new value against the current one, and to hold when the new value is picked
+   */
+  auto pickedValue = isTrueValueInternal ? select->getFalseValue() : select->getTrueValue();
+  auto predicate = comparison->getPredicate();
+  if (comparison->getOperand(0) != pickedValue) predicate = CmpInst::getSwappedPredicate(predicate);
+  if (isTrueValueInternal) predicate = CmpInst::getInversePredicate(predicate);
+  this->minMaxPredicate = predicate;
+}
+
+CmpInst * EvolutionUpdate::getComparisonOfMinMax (SelectInst *select) {
+
+  /*
+   * The condition must order the two values
+   */
+  auto comparison = dyn_cast<CmpInst>(select->getCondition());
+  if (!comparison) return nullptr;
+  switch (comparison->getPredicate()) {
+    case CmpInst::ICMP_SLT:
+    case CmpInst::ICMP_SLE:
+    case CmpInst::ICMP_SGT:
+    case CmpInst::ICMP_SGE:
+    case CmpInst::ICMP_ULT:
+    case CmpInst::ICMP_ULE:
+    case CmpInst::ICMP_UGT:
+    case CmpInst::ICMP_UGE:
+    case CmpInst::FCMP_OLT:
+    case CmpInst::FCMP_OLE:
+    case CmpInst::FCMP_OGT:
+    case CmpInst::FCMP_OGE:
+    case CmpInst::FCMP_ULT:
+    case CmpInst::FCMP_ULE:
+    case CmpInst::FCMP_UGT:
+    case CmpInst::FCMP_UGE:
+      break;
+    default:
+      return nullptr;
+  }
+
+  /*
+   * The select must pick one of the two values compared
+   */
+  auto trueValue = select->getTrueValue();
+  auto falseValue = select->getFalseValue();
+  auto op0 = comparison->getOperand(0);
+  auto op1 = comparison->getOperand(1);
+  if ((op0 == trueValue && op1 == falseValue) || (op0 == falseValue && op1 == trueValue)) {
+    return comparison;
+  }
+
+  return nullptr;
 }
 
 bool EvolutionUpdate::mayUpdateBeOverride (void) const {
+  if (isMinMax()) return false;
   if (isa<SelectInst>(updateInstruction) || isa<PHINode>(updateInstruction)) {
 
     /*
@@ -528,6 +943,14 @@ bool EvolutionUpdate::isMul (void) const {
     || Instruction::FMul == op;
 }
 
+bool EvolutionUpdate::isMinMax (void) const {
+  return minMaxPredicate != CmpInst::BAD_ICMP_PREDICATE;
+}
+
+CmpInst::Predicate EvolutionUpdate::getMinMaxPredicate (void) const {
+  return minMaxPredicate;
+}
+
 bool EvolutionUpdate::isSub (void) const {
   auto op = updateInstruction->getOpcode();
   return Instruction::Sub == op
@@ -548,6 +971,7 @@ bool EvolutionUpdate::isSubTransformableToAdd () const {
 bool EvolutionUpdate::isTransformablyCommutativeWithSelf (void) const {
   if (mayUpdateBeOverride()) return false;
   if (updateInstruction->isCommutative()) return true;
+  if (isMinMax()) return true;
 
   return isSubTransformableToAdd();
 }
@@ -562,6 +986,7 @@ bool EvolutionUpdate::isAssociativeWithSelf (void) const {
    */
   if (isAdd()) return true;
   if (isMul()) return true;
+  if (isMinMax()) return true;
 
   return isSubTransformableToAdd();
 }
@@ -581,10 +1006,13 @@ bool EvolutionUpdate::isTransformablyCommutativeWith (const EvolutionUpdate &oth
    * Multiplication is not mutually commutative with any other than multiplication
    * 
    * Logical operators are only mutually commutative with each other
+   * 
+   * Min/max updates are only mutually commutative with the ones that compare values the same way
    */
   if (isBothUpdatesAddOrSub(otherUpdate)) return true;
   if (isBothUpdatesMul(otherUpdate)) return true;
   if (isBothUpdatesSameBitwiseLogicalOp(otherUpdate)) return true;
+  if (isBothUpdatesSameMinMax(otherUpdate)) return true;
 
   return false;
 }
@@ -604,10 +1032,13 @@ bool EvolutionUpdate::isAssociativeWith (const EvolutionUpdate &otherUpdate) con
    * Multiplication is not mutually associative with any other than multiplication
    * 
    * Logical operators are only mutually associative with each other
+   * 
+   * Min/max updates are only mutually associative with the ones that compare values the same way
    */
   if (isBothUpdatesAddOrSub(otherUpdate)) return true;
   if (isBothUpdatesMul(otherUpdate)) return true;
   if (isBothUpdatesSameBitwiseLogicalOp(otherUpdate)) return true;
+  if (isBothUpdatesSameMinMax(otherUpdate)) return true;
 
   return false;
 }
@@ -632,6 +1063,11 @@ bool EvolutionUpdate::isBothUpdatesSameBitwiseLogicalOp (const EvolutionUpdate &
     && thisOp == otherOp;
 }
 
+bool EvolutionUpdate::isBothUpdatesSameMinMax (const EvolutionUpdate &otherUpdate) const {
+  return this->isMinMax()
+    && this->minMaxPredicate == otherUpdate.minMaxPredicate;
+}
+
 Instruction *EvolutionUpdate::getUpdateInstruction (void) const {
   return updateInstruction;
 }
@@ -25,6 +25,8 @@ namespace llvm::noelle {
 
       CallGraph * getProgramCallGraph (void) ;
 
+      void invalidateProgramCallGraph (void) ;
+
     private:
       Module &program;
       PDGAnalysis &pdgAnalysis;
@@ -18,6 +18,7 @@
 #include "DataFlow.hpp"
 #include "Scheduler.hpp"
 #include "StayConnectedNestedLoopForest.hpp"
+#include "ControlFlowEquivalence.hpp"
 #include "FunctionsManager.hpp"
 #include "TypesManager.hpp"
 #include "CompilationOptionsManager.hpp"
@@ -71,6 +72,16 @@ namespace llvm::noelle {
         double minimumHotness
       );
 
+      /*
+       * If @buildComponentsOnDemand is true, the components of the loops returned (e.g., dependence graphs) are built only when requested.
+       * The inputs needed to build them are fetched when the first component of a loop is requested, so the loop must still exist at that time.
+       */
+      std::vector<LoopDependenceInfo *> * getLoops (
+        Function *function,
+        double minimumHotness,
+        bool buildComponentsOnDemand
+      );
+
       std::unordered_map<BasicBlock *, LoopDependenceInfo *> getInnermostLoopsThatContains (
         const std::vector<LoopDependenceInfo *> &loops
         );
@@ -85,6 +96,22 @@ namespace llvm::noelle {
         BasicBlock *bb
         );
 
+      /*
+       * Return the innermost loop that contains @bb (or @inst), or nullptr if there is none.
+       * The loop returned is one of the cached loops of its function (see getLoopNestingForest).
+       */
+      LoopStructure * getInnermostLoopStructureThatContains (
+        BasicBlock *bb
+        );
+
+      LoopStructure * getInnermostLoopStructureThatContains (
+        Instruction *inst
+        );
+
+      /*
+       * Return the loops of the program (or of a function) that are hot enough.
+       * The loops are the cached ones of their functions (see getLoopNestingForest), so only the vector returned must be freed by the caller.
+       */
       std::vector<LoopStructure *> * getLoopStructures (void) ;
 
       std::vector<LoopStructure *> * getLoopStructures (
@@ -131,6 +158,19 @@ namespace llvm::noelle {
         std::vector<LoopStructure *> const & loops
         ) ;
 
+      /*
+       * Return the nesting forest of all loops of a function.
+       * The forest and its loops are cached until the CFG of the function is reported as modified (see invalidateLoopNestingForest), so they must not be freed or modified by the caller.
+       */
+      StayConnectedNestedLoopForest * getLoopNestingForest (Function *f) ;
+
+      /*
+       * Invalidate the nesting forest of the loops of a function after its CFG has been modified.
+       * The loops of the function are computed again when requested next.
+       * The ones invalidated stay allocated until NOELLE is destroyed, as callers might still hold them.
+       */
+      void invalidateLoopNestingForest (Function *f) ;
+
       void filterOutLoops (
         std::vector<LoopStructure *> & loops,
         std::function<bool (LoopStructure *)> filter
@@ -149,6 +189,13 @@ namespace llvm::noelle {
 
       PDG * getFunctionDependenceGraph (Function *f) ;
 
+      /*
+       * Invalidate the dependence graph of a function after it has been modified.
+       * LDIs of loops of the function must be freed before calling this method.
+       * If the CFG of the function has been modified, invalidateLoopNestingForest must be invoked as well.
+       */
+      void invalidateFunctionDependenceGraph (Function *f) ;
+
       DataFlowAnalysis getDataFlowAnalyses (void) const ;
 
       DataFlowEngine getDataFlowEngine (void) const ;
@@ -157,6 +204,28 @@ namespace llvm::noelle {
 
       DominatorSummary * getDominators (Function *f) ;
 
+      /*
+       * Return the control flow equivalent basic blocks of a function.
+       * The result is cached until the function is invalidated (e.g., by invalidateFunctionDependenceGraph), so it must not be freed by the caller.
+       */
+      ControlFlowEquivalence * getControlFlowEquivalence (Function *f) ;
+
+      /*
+       * Invalidate the control flow equivalent basic blocks of a function after its CFG has been modified.
+       */
+      void invalidateControlFlowEquivalence (Function *f) ;
+
+      /*
+       * Return the loop invariants of all loops of a function.
+       * The result is cached until the dependence graph of the function is invalidated, so it must not be freed by the caller.
+       */
+      LoopForestInvariants * getLoopForestInvariants (Function *f) ;
+
+      /*
+       * Invalidate the loop invariants of a function after it has been modified.
+       */
+      void invalidateLoopForestInvariants (Function *f) ;
+
       Verbosity getVerbosity (void) const ;
 
       double getMinimumHotness (void) const ;
@@ -212,6 +281,28 @@ namespace llvm::noelle {
       TypesManager *tm;
       CompilationOptionsManager *om;
       MetadataManager *mm;
+      std::unordered_map<Function *, ControlFlowEquivalence *> functionToControlFlowEquivalence;
+      std::unordered_map<Function *, LoopForestInvariants *> functionToLoopForestInvariants;
+
+      /*
+       * Loops of a function organized in their nesting forest.
+       * Basic blocks are identified by their position within the function.
+       * These IDs index the innermost loop of every basic block and the bitmap of the basic blocks (and therefore of the instructions) of every loop.
+       */
+      class FunctionLoops {
+        public:
+          std::vector<LoopStructure *> loops;
+          StayConnectedNestedLoopForest *forest;
+          DominatorSummary *dominators;
+          std::vector<BasicBlock *> basicBlocks;
+          std::unordered_map<BasicBlock *, uint32_t> basicBlockIDs;
+          std::vector<LoopStructure *> innermostLoops;
+          std::unordered_map<LoopStructure *, BitVector> loopBasicBlocks;
+      };
+      std::unordered_map<Function *, FunctionLoops> functionToLoops;
+      std::vector<LoopStructure *> invalidatedLoops;
+
+      FunctionLoops & getFunctionLoops (Function *f) ;
 
       uint32_t fetchTheNextValue (
         std::stringstream &stream
@@ -219,6 +310,11 @@ namespace llvm::noelle {
 
       bool checkToGetLoopFilteringInfo (void) ;
 
+      LoopDependenceInfoInputs fetchLoopDependenceInfoInputs (
+        Function *function,
+        BasicBlock *header
+      );
+
       LoopDependenceInfo * getLoopDependenceInfoForLoop (
         Loop *loop,
         PDG *functionPDG,
@@ -227,7 +323,8 @@ namespace llvm::noelle {
         uint32_t techniquesToDisable,
         uint32_t DOALLChunkSize,
         uint32_t maxCores,
-        std::unordered_set<LoopDependenceInfoOptimization> optimizations
+        std::unordered_set<LoopDependenceInfoOptimization> optimizations,
+        LoopForestInvariants *forestInvariants
       );
 
       bool isLoopHot (LoopStructure *loopStructure, double minimumHotness) ;
@@ -34,6 +34,13 @@ CallGraph * FunctionsManager::getProgramCallGraph (void) {
   return this->pcg;
 }
 
+void FunctionsManager::invalidateProgramCallGraph (void) {
+  this->pcg = nullptr;
+  this->pdgAnalysis.invalidateProgramCallGraph();
+
+  return ;
+}
+
 bool FunctionsManager::isTheLibraryFunctionPure (Function *libraryFunction){
 
   /*
@@ -199,6 +199,13 @@ void Noelle::linkTransformedLoopToOriginalFunction (
   endBuilder.SetInsertPoint(endOfParLoopInOriginalFunc->getTerminator());
   endBuilder.CreateStore(const0, globalBool);
 
+  /*
+   * The CFG of the original function has been modified.
+   */
+  this->invalidateControlFlowEquivalence(originalPreHeader->getParent());
+  this->invalidateLoopForestInvariants(originalPreHeader->getParent());
+  this->invalidateLoopNestingForest(originalPreHeader->getParent());
+
   return ;
 }
 
@@ -278,6 +285,22 @@ bool Noelle::shouldLoopsBeHoistToMain (void) const {
 }
 
 Noelle::~Noelle(){
+  for (auto &pair : this->functionToControlFlowEquivalence){
+    delete pair.second;
+  }
+  for (auto &pair : this->functionToLoopForestInvariants){
+    delete pair.second;
+  }
+  for (auto &pair : this->functionToLoops){
+    delete pair.second.forest;
+    delete pair.second.dominators;
+    for (auto loop : pair.second.loops){
+      delete loop;
+    }
+  }
+  for (auto loop : this->invalidatedLoops){
+    delete loop;
+  }
 
   return ;
 }
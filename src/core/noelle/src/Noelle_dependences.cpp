@@ -24,4 +24,30 @@ PDG * Noelle::getFunctionDependenceGraph (Function *f) {
   return this->pdgAnalysis->getFunctionPDG(*f);
 }
 
+void Noelle::invalidateFunctionDependenceGraph (Function *f) {
+
+  /*
+   * The PDG of the program is not valid anymore.
+   */
+  this->programDependenceGraph = nullptr;
+
+  /*
+   * Invalidate the dependences of the function.
+   */
+  this->pdgAnalysis->invalidateFunctionPDG(*f);
+
+  /*
+   * The function may have been modified, so its control flow equivalences may not be valid anymore.
+   * The nesting forest of its loops is invalidated only when its CFG is reported as modified (see invalidateLoopNestingForest).
+   */
+  this->invalidateControlFlowEquivalence(f);
+
+  /*
+   * The loop invariants of the function have been computed with its dependences.
+   */
+  this->invalidateLoopForestInvariants(f);
+
+  return ;
+}
+
 }
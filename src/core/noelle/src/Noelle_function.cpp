@@ -28,6 +28,68 @@ DominatorSummary * Noelle::getDominators (Function *f) {
 
   return ds;
 }
+
+ControlFlowEquivalence * Noelle::getControlFlowEquivalence (Function *f) {
+
+  /*
+   * Check if the equivalences have already been computed.
+   */
+  auto cfeIter = this->functionToControlFlowEquivalence.find(f);
+  if (cfeIter != this->functionToControlFlowEquivalence.end()){
+    return cfeIter->second;
+  }
+
+  /*
+   * Compute the equivalences.
+   */
+  auto cfe = new ControlFlowEquivalence(*f);
+  this->functionToControlFlowEquivalence[f] = cfe;
+
+  return cfe;
+}
+
+void Noelle::invalidateControlFlowEquivalence (Function *f) {
+  auto cfeIter = this->functionToControlFlowEquivalence.find(f);
+  if (cfeIter == this->functionToControlFlowEquivalence.end()){
+    return ;
+  }
+  delete cfeIter->second;
+  this->functionToControlFlowEquivalence.erase(cfeIter);
+
+  return ;
+}
+
+LoopForestInvariants * Noelle::getLoopForestInvariants (Function *f) {
+
+  /*
+   * Check if the invariants have already been computed.
+   */
+  auto invariantsIt = this->functionToLoopForestInvariants.find(f);
+  if (invariantsIt != this->functionToLoopForestInvariants.end()){
+    return invariantsIt->second;
+  }
+
+  /*
+   * Compute the invariants of all loops of the function at once.
+   */
+  auto forest = this->getLoopNestingForest(f);
+  auto funcPDG = this->getFunctionDependenceGraph(f);
+  auto invariants = new LoopForestInvariants(forest, funcPDG);
+  this->functionToLoopForestInvariants[f] = invariants;
+
+  return invariants;
+}
+
+void Noelle::invalidateLoopForestInvariants (Function *f) {
+  auto invariantsIt = this->functionToLoopForestInvariants.find(f);
+  if (invariantsIt == this->functionToLoopForestInvariants.end()){
+    return ;
+  }
+  delete invariantsIt->second;
+  this->functionToLoopForestInvariants.erase(invariantsIt);
+
+  return ;
+}
       
 FunctionsManager * Noelle::getFunctionsManager (void) {
   if (!this->fm){
@@ -27,32 +27,22 @@ std::vector<LoopStructure *> * Noelle::getLoopStructures (
     double minimumHotness
     ) {
 
-  /*
-   * Check if the function has loops.
-   */
-  auto allLoops = new std::vector<LoopStructure *>();
-  auto& LI = getAnalysis<LoopInfoWrapperPass>(*function).getLoopInfo();
-  if (std::distance(LI.begin(), LI.end()) == 0){
-    return allLoops;
-  }
-
   /*
    * Fetch all loops of the current function.
    */
-  auto loops = LI.getLoopsInPreorder();
-  for (auto loop : loops){
+  auto allLoops = new std::vector<LoopStructure *>();
+  auto &functionLoops = this->getFunctionLoops(function);
+  for (auto loopStructure : functionLoops.loops){
 
     /*
      * Check if the loop is hot enough.
      */
-    auto loopStructure = new LoopStructure{loop};
     if (!isLoopHot(loopStructure, minimumHotness)) {
-      delete loopStructure;
       continue;
     }
 
     /*
-     * Allocate the loop wrapper.
+     * Add the loop.
      */
     allLoops->push_back(loopStructure);
   }
@@ -113,8 +103,8 @@ std::vector<LoopStructure *> * Noelle::getLoopStructures (
     /*
      * Check if the function has loops.
      */
-    auto& LI = getAnalysis<LoopInfoWrapperPass>(*function).getLoopInfo();
-    if (std::distance(LI.begin(), LI.end()) == 0){
+    auto &functionLoops = this->getFunctionLoops(function);
+    if (functionLoops.loops.size() == 0){
       if (this->verbose >= Verbosity::Maximal){
         errs() << "Noelle:  Function \"" << function->getName() << "\" does not have loops\n";
       }
@@ -124,18 +114,15 @@ std::vector<LoopStructure *> * Noelle::getLoopStructures (
     /*
      * Consider all loops of the current function.
      */
-    auto loops = LI.getLoopsInPreorder();
-    for (auto loop : loops){
+    for (auto loopStructure : functionLoops.loops){
       auto currentLoopIndex = nextLoopIndex++;
 
       /*
        * Check if the loop is hot enough.
        */
-      auto loopStructure = new LoopStructure{loop};
       auto loopHeader = loopStructure->getHeader();
       if (!isLoopHot(loopStructure, minimumHotness)){
         errs() << "Noelle:  Disable loop \"" << currentLoopIndex << "\" as cold code\n";
-        delete loopStructure;
         continue ;
       }
 
@@ -148,7 +135,7 @@ std::vector<LoopStructure *> * Noelle::getLoopStructures (
       if (!filterLoops){
 
         /*
-         * Allocate the loop wrapper.
+         * Add the loop.
          */
         allLoops->push_back(loopStructure);
         this->loopHeaderToLoopIndexMap.insert(std::make_pair(loopHeader, currentLoopIndex));
@@ -170,7 +157,6 @@ std::vector<LoopStructure *> * Noelle::getLoopStructures (
          *
          * Jump to the next loop.
          */
-        delete loopStructure;
         continue ;
       }
 
@@ -227,6 +213,12 @@ LoopDependenceInfo * Noelle::getLoop (
   auto funcPDG = this->getFunctionDependenceGraph(function);
   auto DS = this->getDominators(function);
 
+  /*
+   * Fetch the invariants of the loops of the function.
+   * This must happen before fetching the loops and the scalar evolution of the function because computing the invariants runs the LLVM analyses again, which frees the ones fetched so far.
+   */
+  auto forestInvariants = this->getLoopForestInvariants(function);
+
   /*
    * Fetch the llvm loop corresponding to the loop structure
    */
@@ -238,7 +230,7 @@ LoopDependenceInfo * Noelle::getLoop (
    * Check of loopIndex provided is within bounds
    */
   if (this->loopHeaderToLoopIndexMap.find(header) == this->loopHeaderToLoopIndexMap.end()){
-    auto ldi = new LoopDependenceInfo(funcPDG, llvmLoop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, optimizations, this->loopAwareDependenceAnalysis);
+    auto ldi = new LoopDependenceInfo(funcPDG, llvmLoop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, optimizations, this->loopAwareDependenceAnalysis, forestInvariants);
 
     delete DS;
     return ldi;
@@ -253,7 +245,7 @@ LoopDependenceInfo * Noelle::getLoop (
    * No filter file was provided. Construct LDI without profiler configurables
    */
   if (!this->hasReadFilterFile) {
-    auto ldi = new LoopDependenceInfo(funcPDG, llvmLoop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, optimizations, this->loopAwareDependenceAnalysis);
+    auto ldi = new LoopDependenceInfo(funcPDG, llvmLoop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, optimizations, this->loopAwareDependenceAnalysis, forestInvariants);
 
     delete DS;
     return ldi;
@@ -280,7 +272,8 @@ LoopDependenceInfo * Noelle::getLoop (
       this->techniquesToDisable[loopIndex],
       this->DOALLChunkSize[loopIndex],
       maximumNumberOfCoresForTheParallelization,
-      optimizations
+      optimizations,
+      forestInvariants
       );
 
   delete DS;
@@ -302,6 +295,16 @@ std::vector<LoopDependenceInfo *> * Noelle::getLoops (
     Function *function,
     double minimumHotness
     ){
+  auto v = this->getLoops(function, minimumHotness, false);
+
+  return v;
+}
+
+std::vector<LoopDependenceInfo *> * Noelle::getLoops (
+    Function *function,
+    double minimumHotness,
+    bool buildComponentsOnDemand
+    ){
 
   /*
    * Fetch the profiles.
@@ -337,6 +340,12 @@ std::vector<LoopDependenceInfo *> * Noelle::getLoops (
    */
   auto funcPDG = this->getFunctionDependenceGraph(function);
 
+  /*
+   * Fetch the invariants of the loops of the function.
+   * This must happen before fetching the loops and the scalar evolution of the function because computing the invariants runs the LLVM analyses again, which frees the ones fetched so far.
+   */
+  auto forestInvariants = this->getLoopForestInvariants(function);
+
   /*
    * Fetch the post dominators and scalar evolutions
    */
@@ -367,7 +376,20 @@ std::vector<LoopDependenceInfo *> * Noelle::getLoops (
     for(auto edge : funcPDG->getEdges()) {
       assert(!edge->isLoopCarriedDependence() && "Flag set");
     }
-    auto ldi = new LoopDependenceInfo(funcPDG, loop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, this->loopAwareDependenceAnalysis);
+    if (buildComponentsOnDemand){
+
+      /*
+       * The inputs needed to build the components are fetched again when the first component is requested, as other analyses may have freed the current ones by then.
+       */
+      auto header = loop->getHeader();
+      auto fetchInputs = [this, function, header](void) -> LoopDependenceInfoInputs {
+        return this->fetchLoopDependenceInfoInputs(function, header);
+      };
+      auto ldi = new LoopDependenceInfo(loop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, {}, this->loopAwareDependenceAnalysis, fetchInputs);
+      allLoops->push_back(ldi);
+      continue ;
+    }
+    auto ldi = new LoopDependenceInfo(funcPDG, loop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, {}, this->loopAwareDependenceAnalysis, forestInvariants);
     allLoops->push_back(ldi);
   }
 
@@ -453,6 +475,12 @@ std::vector<LoopDependenceInfo *> * Noelle::getLoops (
      */
     auto funcPDG = this->getFunctionDependenceGraph(function);
 
+    /*
+     * Fetch the invariants of the loops of the function.
+     * This must happen before fetching the loops and the scalar evolution of the function because computing the invariants runs the LLVM analyses again, which frees the ones fetched so far.
+     */
+    auto forestInvariants = this->getLoopForestInvariants(function);
+
     /*
      * Fetch the post dominators and scalar evolutions
      */
@@ -490,7 +518,7 @@ std::vector<LoopDependenceInfo *> * Noelle::getLoops (
         /*
          * Allocate the loop wrapper.
          */
-        auto ldi = new LoopDependenceInfo(funcPDG, loop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, this->loopAwareDependenceAnalysis);
+        auto ldi = new LoopDependenceInfo(funcPDG, loop, *DS, SE, this->om->getMaximumNumberOfCores(), this->enableFloatAsReal, {}, this->loopAwareDependenceAnalysis, forestInvariants);
 
         allLoops->push_back(ldi);
         continue ;
@@ -530,7 +558,8 @@ std::vector<LoopDependenceInfo *> * Noelle::getLoops (
           this->techniquesToDisable[currentLoopIndex],
           this->DOALLChunkSize[currentLoopIndex],
           maximumNumberOfCoresForTheParallelization,
-          {}
+          {},
+          forestInvariants
           );
 
       /*
@@ -563,18 +592,22 @@ std::unordered_map<BasicBlock *, LoopDependenceInfo *> Noelle::getInnermostLoops
   for (auto ldi : loops){
 
     /*
-     * Fetch the loop structure.
+     * Fetch the cached loop of the function that corresponds to the current one.
+     * The innermost loop that contains the header of a loop is the loop itself.
      */
-    auto ls = ldi->getLoopStructure();
+    auto header = ldi->getLoopStructure()->getHeader();
+    auto &functionLoops = this->getFunctionLoops(header->getParent());
+    auto ls = functionLoops.innermostLoops[functionLoops.basicBlockIDs.at(header)];
+    assert(ls->getHeader() == header);
 
     /*
-     * Iterate over the basic blocks of the current loop and add those that do not belong to innermost loops.
+     * Iterate over the basic blocks of the current loop and add those that do not belong to its sub-loops.
      */
-    for (auto bb : ls->getBasicBlocks()){
-      auto firstInst = &*bb->begin();
-      if (ls->isIncludedInItsSubLoops(firstInst)){
+    for (auto bbID : functionLoops.loopBasicBlocks.at(ls).set_bits()){
+      if (functionLoops.innermostLoops[bbID] != ls){
         continue ;
       }
+      auto bb = functionLoops.basicBlocks[bbID];
       assert(m.find(bb) == m.end());
       m[bb] = ldi;
     }
@@ -609,31 +642,49 @@ LoopDependenceInfo * Noelle::getInnermostLoopThatContains (
   /*
    * Identify the innermost loop that contains @inst.
    */
-  for (auto ldi : loops){
+  auto ls = this->getInnermostLoopStructureThatContains(inst);
+  if (ls == nullptr){
+    return nullptr;
+  }
 
-    /*
-     * Check if @inst belongs to @ldi.
-     */
-    auto ls = ldi->getLoopStructure();
-    if (!ls->isIncluded(inst)){
-      continue ;
+  /*
+   * Check if the innermost loop is one of @loops.
+   */
+  auto header = ls->getHeader();
+  for (auto ldi : loops){
+    if (ldi->getLoopStructure()->getHeader() == header){
+      return ldi;
     }
+  }
 
-    /*
-     * The instruction @inst belongs to @ldi.
-     * Check if @inst belongs to @ldi's sublops.
-     */
-    if (ls->isIncludedInItsSubLoops(inst)){
-      continue ;
-    }
+  return nullptr;
+}
 
-    /*
-     * This is the innermost loop that contains @inst.
-     */
-    return ldi;
+LoopStructure * Noelle::getInnermostLoopStructureThatContains (
+  BasicBlock *bb
+  ){
+
+  /*
+   * Fetch the loops of the function of @bb.
+   */
+  auto &functionLoops = this->getFunctionLoops(bb->getParent());
+
+  /*
+   * Fetch the innermost loop that contains @bb.
+   */
+  auto bbIt = functionLoops.basicBlockIDs.find(bb);
+  if (bbIt == functionLoops.basicBlockIDs.end()){
+    return nullptr;
   }
+  auto ls = functionLoops.innermostLoops[bbIt->second];
 
-  return nullptr;
+  return ls;
+}
+
+LoopStructure * Noelle::getInnermostLoopStructureThatContains (
+  Instruction *inst
+  ){
+  return this->getInnermostLoopStructureThatContains(inst->getParent());
 }
 
 uint32_t Noelle::getNumberOfProgramLoops (void) {
@@ -670,14 +721,14 @@ uint32_t Noelle::getNumberOfProgramLoops (
   for (auto function : *functions){
 
     /*
-     * Fetch the loop analysis.
+     * Fetch the loops of the function.
      */
-    auto& LI = getAnalysis<LoopInfoWrapperPass>(*function).getLoopInfo();
+    auto &functionLoops = this->getFunctionLoops(function);
 
     /*
      * Check if the function has loops.
      */
-    if (std::distance(LI.begin(), LI.end()) == 0){
+    if (functionLoops.loops.size() == 0){
       continue ;
     }
 
@@ -689,20 +740,14 @@ uint32_t Noelle::getNumberOfProgramLoops (
     }
 
     /*
-     * Fetch all loops of the current function.
-     */
-    auto loops = LI.getLoopsInPreorder();
-
-    /*
-     * Consider these loops.
+     * Consider the loops of the function.
      */
-    for (auto loop : loops){
+    for (auto loopStructure : functionLoops.loops){
 
       /*
        * Check if the loop is hot enough.
        */
-      LoopStructure loopStructure{loop};
-      if (!isLoopHot(&loopStructure, minimumHotness)) {
+      if (!isLoopHot(loopStructure, minimumHotness)) {
         currentLoopIndex++;
         continue ;
       }
@@ -928,6 +973,29 @@ void Noelle::sortByStaticNumberOfInstructions (std::vector<LoopDependenceInfo *>
   return ;
 }
 
+LoopDependenceInfoInputs Noelle::fetchLoopDependenceInfoInputs (
+    Function *function,
+    BasicBlock *header
+    ) {
+  LoopDependenceInfoInputs inputs;
+
+  /*
+   * Fetch the dependences and the invariants of the function.
+   * They are fetched first because computing them runs the LLVM analyses again, which frees the loops and the scalar evolution fetched before.
+   */
+  inputs.functionDG = this->getFunctionDependenceGraph(function);
+  inputs.forestInvariants = this->getLoopForestInvariants(function);
+
+  /*
+   * Fetch the loop and the scalar evolution.
+   */
+  auto& LI = getAnalysis<LoopInfoWrapperPass>(*function).getLoopInfo();
+  inputs.SE = &getAnalysis<ScalarEvolutionWrapperPass>(*function).getSE();
+  inputs.loop = LI.getLoopFor(header);
+
+  return inputs;
+}
+
 LoopDependenceInfo * Noelle::getLoopDependenceInfoForLoop (
     Loop *loop,
     PDG *functionPDG,
@@ -936,7 +1004,8 @@ LoopDependenceInfo * Noelle::getLoopDependenceInfoForLoop (
     uint32_t techniquesToDisableForLoop,
     uint32_t DOALLChunkSizeForLoop,
     uint32_t maxCores,
-    std::unordered_set<LoopDependenceInfoOptimization> optimizations
+    std::unordered_set<LoopDependenceInfoOptimization> optimizations,
+    LoopForestInvariants *forestInvariants
     ) {
 
   /*
@@ -950,7 +1019,8 @@ LoopDependenceInfo * Noelle::getLoopDependenceInfoForLoop (
       maxCores,
       this->enableFloatAsReal, 
       optimizations, 
-      this->loopAwareDependenceAnalysis);
+      this->loopAwareDependenceAnalysis,
+      forestInvariants);
 
   /*
    * Set the loop constraints specified by INDEX_FILE.
@@ -1083,7 +1153,7 @@ noelle::StayConnectedNestedLoopForest * Noelle::organizeLoopsInTheirNestingFores
   ) {
 
   /*
-   * Compute the dominators.
+   * Fetch the dominators cached with the loops of the functions.
    */
   std::unordered_map<Function *, DominatorSummary *> doms{};
   for (auto loop : loops){
@@ -1091,7 +1161,7 @@ noelle::StayConnectedNestedLoopForest * Noelle::organizeLoopsInTheirNestingFores
     if (doms.find(f) != doms.end()){
       continue ;
     }
-    doms[f] = this->getDominators(f);
+    doms[f] = this->getFunctionLoops(f).dominators;
   }
 
   /*
@@ -1099,14 +1169,104 @@ noelle::StayConnectedNestedLoopForest * Noelle::organizeLoopsInTheirNestingFores
    */
   auto n = new noelle::StayConnectedNestedLoopForest(loops, doms);
 
+  return n;
+}
+
+StayConnectedNestedLoopForest * Noelle::getLoopNestingForest (Function *f) {
+  auto &functionLoops = this->getFunctionLoops(f);
+
+  return functionLoops.forest;
+}
+
+void Noelle::invalidateLoopNestingForest (Function *f) {
+  auto loopsIt = this->functionToLoops.find(f);
+  if (loopsIt == this->functionToLoops.end()){
+    return ;
+  }
+
   /*
-   * Free the memory.
+   * The loop invariants of the function refer to its forest.
    */
-  for (auto pair : doms){
-    delete pair.second;
+  this->invalidateLoopForestInvariants(f);
+  delete loopsIt->second.forest;
+  delete loopsIt->second.dominators;
+
+  /*
+   * Callers might still hold the loops returned so far (e.g., by getLoopStructures).
+   * Hence, they are freed only when NOELLE is destroyed.
+   */
+  for (auto loop : loopsIt->second.loops){
+    this->invalidatedLoops.push_back(loop);
   }
+  this->functionToLoops.erase(loopsIt);
 
-  return n;
+  return ;
+}
+
+Noelle::FunctionLoops & Noelle::getFunctionLoops (Function *f) {
+
+  /*
+   * Check if the loops of the function have already been organized.
+   */
+  auto loopsIt = this->functionToLoops.find(f);
+  if (loopsIt != this->functionToLoops.end()){
+    return loopsIt->second;
+  }
+  auto &functionLoops = this->functionToLoops[f];
+
+  /*
+   * Compute the dominators.
+   * This must happen before fetching the loops because computing the dominators runs the LLVM analyses again, which frees the loops fetched so far.
+   */
+  functionLoops.dominators = this->getDominators(f);
+
+  /*
+   * Assign an ID to every basic block of the function.
+   */
+  for (auto &bb : *f){
+    functionLoops.basicBlockIDs[&bb] = functionLoops.basicBlocks.size();
+    functionLoops.basicBlocks.push_back(&bb);
+  }
+  functionLoops.innermostLoops.resize(functionLoops.basicBlocks.size(), nullptr);
+
+  /*
+   * Allocate the loop structures linked to their parent and children.
+   * Loops are visited from the outermost ones, so the parent of a loop has always been allocated already.
+   * For the same reason, the innermost loop of a basic block is the last one that includes it.
+   */
+  std::unordered_map<Loop *, LoopStructure *> llvmLoopToLoopStructure;
+  auto& LI = getAnalysis<LoopInfoWrapperPass>(*f).getLoopInfo();
+  for (auto loop : LI.getLoopsInPreorder()){
+    LoopStructure *parentLoopStructure = nullptr;
+    if (auto parentLoop = loop->getParentLoop()){
+      parentLoopStructure = llvmLoopToLoopStructure.at(parentLoop);
+    }
+    auto loopStructure = new LoopStructure{loop, parentLoopStructure};
+    if (parentLoopStructure != nullptr){
+      parentLoopStructure->addChild(loopStructure);
+    }
+    llvmLoopToLoopStructure[loop] = loopStructure;
+    functionLoops.loops.push_back(loopStructure);
+
+    /*
+     * Index the basic blocks of the loop.
+     */
+    auto &loopBasicBlocks = functionLoops.loopBasicBlocks[loopStructure];
+    loopBasicBlocks.resize(functionLoops.basicBlocks.size());
+    for (auto bb : loopStructure->blocks()){
+      auto bbID = functionLoops.basicBlockIDs.at(bb);
+      loopBasicBlocks.set(bbID);
+      functionLoops.innermostLoops[bbID] = loopStructure;
+    }
+  }
+
+  /*
+   * Organize the loops in their nesting forest.
+   */
+  std::unordered_map<Function *, DominatorSummary *> doms{ {f, functionLoops.dominators} };
+  functionLoops.forest = new StayConnectedNestedLoopForest(functionLoops.loops, doms);
+
+  return functionLoops;
 }
 
 }
@@ -25,6 +25,8 @@ static cl::opt<bool> DisableDOALL("noelle-disable-doall", cl::ZeroOrMore, cl::Hi
 static cl::opt<bool> DisableDistribution("noelle-disable-loop-distribution", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the loop distribution"));
 static cl::opt<bool> DisableInvCM("noelle-disable-loop-invariant-code-motion", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the loop invariant code motion"));
 static cl::opt<bool> DisableWhilifier("noelle-disable-whilifier", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the loop whilifier"));
+static cl::opt<bool> DisableLoopVersioning("noelle-disable-loop-versioning", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the loop versioning based on runtime alias checks"));
+static cl::opt<bool> DisableLoopFusion("noelle-disable-loop-fusion", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the loop fusion"));
 static cl::opt<bool> DisableSCEVSimplification("noelle-disable-scev-simplification", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable IV related SCEV simplification"));
 static cl::opt<bool> DisableLoopAwareDependenceAnalyses("noelle-disable-loop-aware-dependence-analyses", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable loop aware dependence analyses"));
 static cl::opt<bool> DisableInliner("noelle-disable-inliner", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the function inliner"));
@@ -69,6 +71,12 @@ bool Noelle::doInitialization (Module &M) {
   if (DisableWhilifier.getNumOccurrences() > 0){
     this->enabledTransformations.erase(LOOP_WHILIFIER_ID);
   }
+  if (DisableLoopVersioning.getNumOccurrences() > 0){
+    this->enabledTransformations.erase(LOOP_VERSIONING_ID);
+  }
+  if (DisableLoopFusion.getNumOccurrences() > 0){
+    this->enabledTransformations.erase(LOOP_FUSION_ID);
+  }
   if (DisableSCEVSimplification.getNumOccurrences() > 0){
     this->enabledTransformations.erase(SCEV_SIMPLIFICATION_ID);
   }
@@ -39,10 +39,24 @@ namespace llvm::noelle {
 
       PDG * getFunctionPDG (Function &F) ;
 
+      /*
+       * Invalidate the dependences of a function that has been modified.
+       * The next request of its PDG computes the dependences from the current IR.
+       * PDGs previously returned for this function must not be used anymore.
+       */
+      void invalidateFunctionPDG (Function &F) ;
+
       PDG * getPDG (void) ;
 
       noelle::CallGraph * getProgramCallGraph (void);
 
+      /*
+       * Forget the call graph of the program after its calls have been modified.
+       * The next request computes the call graph from the current IR.
+       * The call graph previously returned is owned by its users, which must not use it anymore.
+       */
+      void invalidateProgramCallGraph (void);
+
       static bool isTheLibraryFunctionPure (Function *libraryFunction);
 
       static bool isTheLibraryFunctionThreadSafe (Function *libraryFunction);
@@ -51,6 +65,7 @@ namespace llvm::noelle {
       Module *M;
       PDG *programDependenceGraph;
       std::unordered_map<Function *, PDG *> functionToFDGMap;
+      std::unordered_set<Function *> functionsModifiedAfterAnalysis;
       AllocAA *allocAA;
       std::set<Function *> CGUnderMain;
       TalkDown *talkdown;
@@ -175,10 +175,24 @@ void PDG::copyEdgesInto (PDG *newPDG, bool linkToExternal) {
 }
 
 void PDG::copyEdgesInto (PDG *newPDG, bool linkToExternal, std::unordered_set<DGEdge<Value> *> const & edgesToIgnore) {
-  for (auto *oldEdge : allEdges) {
-    if (edgesToIgnore.find(oldEdge) != edgesToIgnore.end()) {
+
+  /*
+   * Only the edges connected to the nodes of @newPDG need to be copied.
+   * Hence, we visit the edges of these nodes rather than all the edges of this graph, which can be much larger (e.g., the PDG of the whole function when @newPDG is for a loop).
+   */
+  std::vector<Value *> newInternalValues;
+  for (auto nodePair : newPDG->internalNodePairs()) {
+    auto value = nodePair.first;
+    if (!this->isInGraph(value)) {
       continue;
     }
+    newInternalValues.push_back(value);
+  }
+
+  auto copyEdge = [this, newPDG, linkToExternal, &edgesToIgnore](DGEdge<Value> *oldEdge) {
+    if (edgesToIgnore.find(oldEdge) != edgesToIgnore.end()) {
+      return ;
+    }
 
     auto nodePair = oldEdge->getNodePair();
     auto fromT = nodePair.first->getT();
@@ -189,23 +203,38 @@ void PDG::copyEdgesInto (PDG *newPDG, bool linkToExternal, std::unordered_set<DG
      */
     auto fromInclusion = newPDG->isInternal(fromT);
     auto toInclusion = newPDG->isInternal(toT);
-    if (!fromInclusion && !toInclusion) {
-      continue;
-    }
     if (!linkToExternal && (!fromInclusion || !toInclusion)) {
-      continue;
+      return ;
     }
-    
+
     /*
      * Create appropriate external nodes and associate edge to them
      */
-    auto newFromNode = newPDG->fetchOrAddNode(fromT, fromInclusion);
-    auto newToNode = newPDG->fetchOrAddNode(toT, toInclusion);
+    newPDG->fetchOrAddNode(fromT, fromInclusion);
+    newPDG->fetchOrAddNode(toT, toInclusion);
 
     /*
      * Copy edge to match properties (mem/var, must/may, RAW/WAW/WAR/control)
      */
     newPDG->copyAddEdge(*oldEdge);
+  };
+
+  for (auto value : newInternalValues) {
+    auto oldNode = this->fetchNode(value);
+
+    /*
+     * Copy all outgoing edges.
+     * Incoming edges are copied only if they come from a node outside @newPDG, otherwise they are copied as outgoing edges of their source.
+     */
+    for (auto oldEdge : oldNode->getOutgoingEdges()) {
+      copyEdge(oldEdge);
+    }
+    for (auto oldEdge : oldNode->getIncomingEdges()) {
+      if (newPDG->isInternal(oldEdge->getOutgoingT())) {
+        continue;
+      }
+      copyEdge(oldEdge);
+    }
   }
 
   return ;
@@ -48,6 +48,7 @@ void PDGAnalysis::releaseMemory () {
     delete fdg;
   }
   this->functionToFDGMap.clear();
+  this->functionsModifiedAfterAnalysis.clear();
 
   return ;
 }
@@ -86,7 +87,28 @@ PDG * PDGAnalysis::getFunctionPDG (Function &F) {
    * Else, construct the function DG from scratch (or from metadata)
    */
   PDG *pdg = nullptr;
-  if (this->programDependenceGraph){
+  if (this->functionsModifiedAfterAnalysis.find(&F) != this->functionsModifiedAfterAnalysis.end()){
+
+    /*
+     * The function has been modified after its dependences have been computed (or embedded).
+     * Compute them again from the current IR.
+     */
+    if (this->functionToFDGMap.find(&F) == this->functionToFDGMap.end()) {
+
+      /*
+       * SVF analyzed the IR before the modification, so it does not know the new instructions.
+       */
+      auto originalDisableSVF = this->disableSVF;
+      this->disableSVF = true;
+      pdg = constructFunctionDGFromAnalysis(F);
+      this->disableSVF = originalDisableSVF;
+      this->functionToFDGMap.insert(std::make_pair(&F, pdg));
+
+    } else {
+      pdg = this->functionToFDGMap.at(&F);
+    }
+
+  } else if (this->programDependenceGraph){
 
     /*
      * Check and get/update the function cache
@@ -146,6 +168,33 @@ PDG * PDGAnalysis::getFunctionPDG (Function &F) {
   return pdg;
 }
 
+void PDGAnalysis::invalidateFunctionPDG (Function &F) {
+
+  /*
+   * The PDG of the program includes the instructions of the function before the modification.
+   * Functions not modified keep their dependences cached.
+   */
+  if (this->programDependenceGraph){
+    delete this->programDependenceGraph;
+    this->programDependenceGraph = nullptr;
+  }
+
+  /*
+   * Free the dependences of the function.
+   */
+  if (this->functionToFDGMap.find(&F) != this->functionToFDGMap.end()){
+    delete this->functionToFDGMap.at(&F);
+    this->functionToFDGMap.erase(&F);
+  }
+
+  /*
+   * Neither the embedded PDG nor the PDG of the program can be used for this function anymore.
+   */
+  this->functionsModifiedAfterAnalysis.insert(&F);
+
+  return ;
+}
+
 PDG * PDGAnalysis::getPDG (void){
 
   /*
@@ -159,8 +208,12 @@ PDG * PDGAnalysis::getPDG (void){
    * Construct the PDG
    *
    * Check if we have already done it and the PDG has been embedded in the IR.
+   * The embedded PDG does not describe functions modified after it has been embedded.
    */
-  if (this->hasPDGAsMetadata(*this->M)) {
+  if (  true
+        && this->hasPDGAsMetadata(*this->M)
+        && (this->functionsModifiedAfterAnalysis.size() == 0)
+     ) {
 
     /*
      * The PDG has been embedded in the IR.
@@ -184,8 +237,14 @@ PDG * PDGAnalysis::getPDG (void){
      * There is no PDG in the IR.
      * 
      * Compute the PDG using the dependence analyses.
+     * SVF does not know the instructions of functions modified after it has analyzed the IR.
      */
+    auto originalDisableSVF = this->disableSVF;
+    if (this->functionsModifiedAfterAnalysis.size() > 0){
+      this->disableSVF = true;
+    }
     this->programDependenceGraph = constructPDGFromAnalysis(*this->M);
+    this->disableSVF = originalDisableSVF;
 
     /*
      * Check if we should embed the PDG.
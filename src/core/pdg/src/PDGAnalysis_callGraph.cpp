@@ -25,6 +25,12 @@ noelle::CallGraph * PDGAnalysis::getProgramCallGraph (void){
   return this->noelleCG;
 }
 
+void PDGAnalysis::invalidateProgramCallGraph (void){
+  this->noelleCG = nullptr;
+
+  return ;
+}
+
 void PDGAnalysis::identifyFunctionsThatInvokeUnhandledLibrary(Module &M) {
 
   /*
@@ -10,9 +10,10 @@
 #include <utility>
 #include <vector>
 #include <assert.h>
+#include <string.h>
+#include <unistd.h>
 
 #include <ThreadSafeQueue.hpp>
-#include <ThreadSafeLockFreeQueue.hpp>
 #include <ThreadPools.hpp>
 
 #include <condition_variable>
@@ -48,18 +49,246 @@ typedef struct {
   pthread_spinlock_t endLock;
 } DOALL_args_t ;
 
+/*
+ * Bounded single-producer single-consumer queue that connects two DSWP stages.
+ *
+ * The capacity bounds the memory footprint of the queue.
+ * The producer makes pushed values visible to the consumer every batchSize pushes to amortize the synchronization cost (i.e., the transfer of the cache line that includes the tail).
+ *
+ * A stage that blocks (on a full queue or on an empty one) first publishes the pending batches of all queues it pushes to.
+ * Otherwise, a stage could wait for a value that depends on a batch it is holding (e.g., in a diamond-shaped pipeline).
+ */
+class NOELLE_DSWPQueueBase {
+  public:
+    NOELLE_DSWPQueueBase (uint64_t capacity, uint64_t batchSize)
+      : mask{capacity - 1}, batchSize{batchSize}, localTail{0}, publishedTail{0}, cachedHead{0}, hasPendingBatch{false}, localHead{0}, cachedTail{0}
+      {
+      assert((capacity & (capacity - 1)) == 0);
+      assert(batchSize < capacity);
+      this->head.store(0, std::memory_order_relaxed);
+      this->tail.store(0, std::memory_order_relaxed);
+
+      return ;
+    }
+
+    /*
+     * Make all pushed values visible to the consumer.
+     */
+    void publish (void) {
+      this->tail.store(this->localTail, std::memory_order_release);
+      this->publishedTail = this->localTail;
+
+      return ;
+    }
+
+    /*
+     * Publish all pushed values and stop tracking the queue as one with a pending batch of the current thread.
+     * This is invoked by the producer when it will not push anymore (e.g., the queue is about to be freed).
+     */
+    void flush (void) {
+      this->publish();
+      if (this->hasPendingBatch){
+        auto &pendingQueues = NOELLE_DSWPQueueBase::queuesWithPendingBatches();
+        pendingQueues.erase(std::remove(pendingQueues.begin(), pendingQueues.end(), this), pendingQueues.end());
+        this->hasPendingBatch = false;
+      }
+
+      return ;
+    }
+
+  protected:
+
+    /*
+     * Wait until there is a free slot and return its index.
+     */
+    uint64_t waitFreeSlot (void) {
+      if ((this->localTail - this->cachedHead) > this->mask){
+        NOELLE_DSWPQueueBase::publishPendingBatches();
+      }
+      while ((this->localTail - this->cachedHead) > this->mask){
+        this->publish();
+        this->cachedHead = this->head.load(std::memory_order_acquire);
+      }
+
+      return this->localTail & this->mask;
+    }
+
+    void pushed (void) {
+      this->localTail++;
+      if ((this->localTail - this->publishedTail) >= this->batchSize){
+        this->publish();
+        return ;
+      }
+
+      /*
+       * Remember that the current thread holds values that are not visible to the consumer.
+       */
+      if (!this->hasPendingBatch){
+        this->hasPendingBatch = true;
+        NOELLE_DSWPQueueBase::queuesWithPendingBatches().push_back(this);
+      }
+
+      return ;
+    }
+
+    /*
+     * Wait until there is a value to pop and return its index.
+     */
+    uint64_t waitValue (void) {
+      if (this->localHead == this->cachedTail){
+        this->cachedTail = this->tail.load(std::memory_order_acquire);
+        if (this->localHead == this->cachedTail){
+          NOELLE_DSWPQueueBase::publishPendingBatches();
+        }
+      }
+      while (this->localHead == this->cachedTail){
+        this->cachedTail = this->tail.load(std::memory_order_acquire);
+      }
+
+      return this->localHead & this->mask;
+    }
+
+    void popped (void) {
+      this->localHead++;
+      this->head.store(this->localHead, std::memory_order_release);
+
+      return ;
+    }
+
+    /*
+     * Queues the current thread pushed values to that might not be visible to their consumers yet.
+     */
+    static std::vector<NOELLE_DSWPQueueBase *> & queuesWithPendingBatches (void) {
+      static thread_local std::vector<NOELLE_DSWPQueueBase *> queues;
+
+      return queues;
+    }
+
+    static void publishPendingBatches (void) {
+      auto &pendingQueues = NOELLE_DSWPQueueBase::queuesWithPendingBatches();
+      for (auto queue : pendingQueues){
+        queue->publish();
+        queue->hasPendingBatch = false;
+      }
+      pendingQueues.clear();
+
+      return ;
+    }
+
+    const uint64_t mask;
+    const uint64_t batchSize;
+
+    /*
+     * Fields accessed by the producer.
+     */
+    alignas(CACHE_LINE_SIZE) uint64_t localTail;
+    uint64_t publishedTail;
+    uint64_t cachedHead;
+    bool hasPendingBatch;
+
+    /*
+     * Fields accessed by the consumer.
+     */
+    alignas(CACHE_LINE_SIZE) uint64_t localHead;
+    uint64_t cachedTail;
+
+    /*
+     * Fields shared between the producer and the consumer.
+     */
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head;
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> tail;
+};
+
+template <typename T>
+class NOELLE_DSWPQueue : public NOELLE_DSWPQueueBase {
+  public:
+    NOELLE_DSWPQueue (uint64_t capacity, uint64_t batchSize)
+      : NOELLE_DSWPQueueBase{capacity, batchSize}
+      {
+      this->elements = new T[capacity];
+
+      return ;
+    }
+
+    void push (T value) {
+      auto slot = this->waitFreeSlot();
+      this->elements[slot] = value;
+      this->pushed();
+
+      return ;
+    }
+
+    void waitPop (T &value) {
+      auto slot = this->waitValue();
+      value = this->elements[slot];
+      this->popped();
+
+      return ;
+    }
+
+    ~NOELLE_DSWPQueue () {
+      delete[] this->elements;
+    }
+
+  private:
+    T *elements;
+};
+
+/*
+ * Queue that connects two DSWP stages with elements that are records of values produced in the same iteration.
+ * Records are copied in and out of the queue.
+ */
+class NOELLE_DSWPRecordQueue : public NOELLE_DSWPQueueBase {
+  public:
+    NOELLE_DSWPRecordQueue (uint64_t capacity, uint64_t batchSize, uint64_t recordSize)
+      : NOELLE_DSWPQueueBase{capacity, batchSize}, recordSize{recordSize}
+      {
+      this->elements = new uint8_t[capacity * recordSize];
+
+      return ;
+    }
+
+    void push (void *record) {
+      auto slot = this->waitFreeSlot();
+      memcpy(&this->elements[slot * this->recordSize], record, this->recordSize);
+      this->pushed();
+
+      return ;
+    }
+
+    void waitPop (void *record) {
+      auto slot = this->waitValue();
+      memcpy(record, &this->elements[slot * this->recordSize], this->recordSize);
+      this->popped();
+
+      return ;
+    }
+
+    ~NOELLE_DSWPRecordQueue () {
+      delete[] this->elements;
+    }
+
+  private:
+    const uint64_t recordSize;
+    uint8_t *elements;
+};
+
 class NoelleRuntime {
   public:
     NoelleRuntime ();
 
     uint32_t reserveCores (uint32_t coresRequested);
 
+    uint32_t reserveAdditionalCores (uint32_t coresRequested);
+
     void releaseCores (uint32_t coresReleased);
 
     DOALL_args_t * getDOALLArgs (uint32_t cores, uint32_t *index);
 
     void releaseDOALLArgs (uint32_t index);
 
+    uint64_t getSharedCacheSize (void) const ;
+
     ThreadPoolForCSingleQueue *virgil;
 
     ~NoelleRuntime(void);
@@ -82,6 +311,11 @@ class NoelleRuntime {
      */
     uint32_t maxCores;
 
+    /*
+     * Size (in bytes) of the last level of cache, which is shared between cores.
+     */
+    uint64_t sharedCacheSize;
+
     mutable pthread_spinlock_t spinLock;
 };
 
@@ -95,6 +329,94 @@ uint64_t clocks_dispatch_ends[64];
 
 static NoelleRuntime runtime{};
 
+/*
+ * Number of parallel tasks the current thread is executing (e.g., a pipeline stage that invokes a DOALL loop).
+ * The core of a thread that executes a task has been reserved already by the dispatcher of that task.
+ */
+static thread_local uint32_t NOELLE_nestingLevel = 0;
+
+/*
+ * Memory used by the tasks executed by the current thread to store their private copies of heap objects and globals.
+ * Blocks are handed out in LIFO order (tasks nest) and they are kept after being released, so a worker allocates memory only the first time it needs a block at least that large rather than at every dispatch.
+ */
+class NOELLE_PrivateCopiesArena {
+  public:
+    void * allocate (uint64_t bytes) {
+      if (this->blocksInUse == this->blocks.size()){
+        this->blocks.push_back(std::make_pair(nullptr, 0));
+      }
+      auto &block = this->blocks[this->blocksInUse];
+      if (block.second < bytes){
+        free(block.first);
+        block.first = nullptr;
+        if (posix_memalign(&block.first, CACHE_LINE_SIZE, bytes) != 0){
+          fprintf(stderr, "NOELLE: ERROR = not enough memory to allocate a private copy of %llu bytes\n", (unsigned long long)bytes);
+          abort();
+        }
+        block.second = bytes;
+      }
+      this->blocksInUse++;
+
+      return block.first;
+    }
+
+    void release (uint64_t numberOfBlocks) {
+      assert(numberOfBlocks <= this->blocksInUse);
+      this->blocksInUse -= numberOfBlocks;
+
+      return ;
+    }
+
+    ~NOELLE_PrivateCopiesArena () {
+      for (auto &block : this->blocks){
+        free(block.first);
+      }
+    }
+
+  private:
+    std::vector<std::pair<void *, uint64_t>> blocks;
+    uint64_t blocksInUse = 0;
+};
+
+static thread_local NOELLE_PrivateCopiesArena NOELLE_privateCopies;
+
+/*
+ * Add the private copy of an array of accumulators to the original array.
+ * Accumulators that have not been updated by the task are skipped to avoid contending on their cache lines.
+ */
+template <typename T>
+static void NOELLE_reducePrivateCopyOfIntegers (T *original, T *privateCopy, int64_t elements){
+  for (int64_t i = 0; i < elements; i++){
+    if (privateCopy[i] == 0){
+      continue ;
+    }
+    __atomic_fetch_add(&original[i], privateCopy[i], __ATOMIC_RELAXED);
+  }
+
+  return ;
+}
+
+template <typename T, typename IntegerT>
+static void NOELLE_reducePrivateCopyOfFloatingPoints (T *original, T *privateCopy, int64_t elements){
+  static_assert(sizeof(T) == sizeof(IntegerT), "The integer type must have the size of the floating point type");
+  for (int64_t i = 0; i < elements; i++){
+    if (privateCopy[i] == 0){
+      continue ;
+    }
+    auto originalAsInteger = reinterpret_cast<IntegerT *>(&original[i]);
+    auto oldBits = __atomic_load_n(originalAsInteger, __ATOMIC_RELAXED);
+    IntegerT newBits;
+    do {
+      T oldValue;
+      memcpy(&oldValue, &oldBits, sizeof(T));
+      auto newValue = oldValue + privateCopy[i];
+      memcpy(&newBits, &newValue, sizeof(T));
+    } while (!__atomic_compare_exchange_n(originalAsInteger, &oldBits, newBits, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+  }
+
+  return ;
+}
+
 extern "C" {
 
   /******************************************** NOELLE APIs ***********************************************/
@@ -115,6 +437,27 @@ extern "C" {
     int64_t chunkSize
     );
 
+  /*
+   * Return the memory for the private copy of an object of @bytes bytes owned by the task that invokes it.
+   */
+  void * NOELLE_allocatePrivateCopy (int64_t bytes);
+
+  /*
+   * Release the last @numberOfCopies private copies allocated by the current thread.
+   */
+  void NOELLE_releasePrivateCopies (int64_t numberOfCopies);
+
+  /*
+   * Add the private copy of an array of @elements accumulators to the original array.
+   * Every task that owns a private copy invokes it when it ends, so the copies of different tasks are merged in parallel.
+   */
+  void NOELLE_reducePrivateCopyInt8 (int8_t *original, int8_t *privateCopy, int64_t elements);
+  void NOELLE_reducePrivateCopyInt16 (int16_t *original, int16_t *privateCopy, int64_t elements);
+  void NOELLE_reducePrivateCopyInt32 (int32_t *original, int32_t *privateCopy, int64_t elements);
+  void NOELLE_reducePrivateCopyInt64 (int64_t *original, int64_t *privateCopy, int64_t elements);
+  void NOELLE_reducePrivateCopyFloat (float *original, float *privateCopy, int64_t elements);
+  void NOELLE_reducePrivateCopyDouble (double *original, double *privateCopy, int64_t elements);
+
 
     #ifdef RUNTIME_PROFILE
     static __inline__ int64_t rdtsc_s(void) {
@@ -154,7 +497,7 @@ extern "C" {
     printf("Pulled: %p\n", p);
   }
 
-  void queuePush8(ThreadSafeQueue<int8_t> *queue, int8_t *val) { 
+  void queuePush8(NOELLE_DSWPQueue<int8_t> *queue, int8_t *val) { 
     queue->push(*val); 
 
     #ifdef DSWP_STATS
@@ -164,12 +507,12 @@ extern "C" {
     return ;
   }
 
-  void queuePop8(ThreadSafeQueue<int8_t> *queue, int8_t *val) { 
+  void queuePop8(NOELLE_DSWPQueue<int8_t> *queue, int8_t *val) { 
     queue->waitPop(*val); 
     return ;
   }
 
-  void queuePush16(ThreadSafeQueue<int16_t> *queue, int16_t *val) { 
+  void queuePush16(NOELLE_DSWPQueue<int16_t> *queue, int16_t *val) { 
     queue->push(*val); 
 
     #ifdef DSWP_STATS
@@ -179,11 +522,11 @@ extern "C" {
     return ;
   }
 
-  void queuePop16(ThreadSafeQueue<int16_t> *queue, int16_t *val) { 
+  void queuePop16(NOELLE_DSWPQueue<int16_t> *queue, int16_t *val) { 
     queue->waitPop(*val);
   }
 
-  void queuePush32(ThreadSafeQueue<int32_t> *queue, int32_t *val) { 
+  void queuePush32(NOELLE_DSWPQueue<int32_t> *queue, int32_t *val) { 
     queue->push(*val); 
 
     #ifdef DSWP_STATS
@@ -193,11 +536,11 @@ extern "C" {
     return ;
   }
 
-  void queuePop32(ThreadSafeQueue<int32_t> *queue, int32_t *val) { 
+  void queuePop32(NOELLE_DSWPQueue<int32_t> *queue, int32_t *val) { 
     queue->waitPop(*val);
   }
 
-  void queuePush64(ThreadSafeQueue<int64_t> *queue, int64_t *val) { 
+  void queuePush64(NOELLE_DSWPQueue<int64_t> *queue, int64_t *val) { 
     queue->push(*val); 
 
     #ifdef DSWP_STATS
@@ -207,12 +550,167 @@ extern "C" {
     return ;
   }
 
-  void queuePop64(ThreadSafeQueue<int64_t> *queue, int64_t *val) { 
+  void queuePop64(NOELLE_DSWPQueue<int64_t> *queue, int64_t *val) { 
     queue->waitPop(*val); 
 
     return ;
   }
 
+  /*
+   * Queues that connect a stage to the replicas of another stage (PS-DSWP).
+   *
+   * The non-replicated end of the queue routes values round-robin across the per-replica queues.
+   * This preserves the order of the iterations as replica i executes iterations i, i + replicas, ...
+   */
+  typedef struct {
+    void **replicaQueues;
+    int64_t numberOfReplicas;
+    int64_t bitLength;
+    int64_t next;
+    int64_t lastValue;
+  } NOELLE_RoundRobinQueue_t ;
+
+  static void * queueRoundRobinNext (NOELLE_RoundRobinQueue_t *queue){
+    auto replicaQueue = queue->replicaQueues[queue->next];
+    queue->next = (queue->next + 1) % queue->numberOfReplicas;
+    return replicaQueue;
+  }
+
+  void queuePushRoundRobin8(NOELLE_RoundRobinQueue_t *queue, int8_t *val) { 
+    queue->lastValue = *val;
+    queuePush8((NOELLE_DSWPQueue<int8_t> *)queueRoundRobinNext(queue), val);
+    return ;
+  }
+
+  void queuePopRoundRobin8(NOELLE_RoundRobinQueue_t *queue, int8_t *val) { 
+    queuePop8((NOELLE_DSWPQueue<int8_t> *)queueRoundRobinNext(queue), val);
+    return ;
+  }
+
+  void queuePushRoundRobin16(NOELLE_RoundRobinQueue_t *queue, int16_t *val) { 
+    queue->lastValue = *val;
+    queuePush16((NOELLE_DSWPQueue<int16_t> *)queueRoundRobinNext(queue), val);
+    return ;
+  }
+
+  void queuePopRoundRobin16(NOELLE_RoundRobinQueue_t *queue, int16_t *val) { 
+    queuePop16((NOELLE_DSWPQueue<int16_t> *)queueRoundRobinNext(queue), val);
+    return ;
+  }
+
+  void queuePushRoundRobin32(NOELLE_RoundRobinQueue_t *queue, int32_t *val) { 
+    queue->lastValue = *val;
+    queuePush32((NOELLE_DSWPQueue<int32_t> *)queueRoundRobinNext(queue), val);
+    return ;
+  }
+
+  void queuePopRoundRobin32(NOELLE_RoundRobinQueue_t *queue, int32_t *val) { 
+    queuePop32((NOELLE_DSWPQueue<int32_t> *)queueRoundRobinNext(queue), val);
+    return ;
+  }
+
+  void queuePushRoundRobin64(NOELLE_RoundRobinQueue_t *queue, int64_t *val) { 
+    queue->lastValue = *val;
+    queuePush64((NOELLE_DSWPQueue<int64_t> *)queueRoundRobinNext(queue), val);
+    return ;
+  }
+
+  void queuePopRoundRobin64(NOELLE_RoundRobinQueue_t *queue, int64_t *val) { 
+    queuePop64((NOELLE_DSWPQueue<int64_t> *)queueRoundRobinNext(queue), val);
+    return ;
+  }
+
+  void queuePushRecord(void *queue, void *record) { 
+    ((NOELLE_DSWPRecordQueue *)queue)->push(record);
+
+    return ;
+  }
+
+  void queuePopRecord(void *queue, void *record) { 
+    ((NOELLE_DSWPRecordQueue *)queue)->waitPop(record);
+
+    return ;
+  }
+
+  /*
+   * Push the last value pushed to every replica that did not receive it.
+   * This allows replicas waiting for an iteration that will never come to observe the end of the loop.
+   */
+  void queueFlush(void *queue) { 
+    ((NOELLE_DSWPQueueBase *)queue)->flush();
+
+    return ;
+  }
+
+  void queueFlushRoundRobin(void *rrQueue) { 
+    auto queue = (NOELLE_RoundRobinQueue_t *)rrQueue;
+    for (auto i = 1; i < queue->numberOfReplicas; i++){
+      auto replicaQueue = queueRoundRobinNext(queue);
+      switch (queue->bitLength) {
+        case 1:
+        case 8:
+          ((NOELLE_DSWPQueue<int8_t> *)replicaQueue)->push((int8_t)queue->lastValue);
+          break;
+        case 16:
+          ((NOELLE_DSWPQueue<int16_t> *)replicaQueue)->push((int16_t)queue->lastValue);
+          break;
+        case 32:
+          ((NOELLE_DSWPQueue<int32_t> *)replicaQueue)->push((int32_t)queue->lastValue);
+          break;
+        case 64:
+          ((NOELLE_DSWPQueue<int64_t> *)replicaQueue)->push((int64_t)queue->lastValue);
+          break;
+      }
+    }
+    for (auto i = 0; i < queue->numberOfReplicas; i++){
+      queueFlush(queue->replicaQueues[i]);
+    }
+
+    return ;
+  }
+
+
+  /**********************************************************************
+   *                Private copies
+   **********************************************************************/
+  void * NOELLE_allocatePrivateCopy (int64_t bytes){
+    return NOELLE_privateCopies.allocate(bytes);
+  }
+
+  void NOELLE_releasePrivateCopies (int64_t numberOfCopies){
+    NOELLE_privateCopies.release(numberOfCopies);
+
+    return ;
+  }
+
+
+  /**********************************************************************
+   *                Reductions of memory locations
+   **********************************************************************/
+  void NOELLE_reducePrivateCopyInt8 (int8_t *original, int8_t *privateCopy, int64_t elements){
+    NOELLE_reducePrivateCopyOfIntegers(original, privateCopy, elements);
+  }
+
+  void NOELLE_reducePrivateCopyInt16 (int16_t *original, int16_t *privateCopy, int64_t elements){
+    NOELLE_reducePrivateCopyOfIntegers(original, privateCopy, elements);
+  }
+
+  void NOELLE_reducePrivateCopyInt32 (int32_t *original, int32_t *privateCopy, int64_t elements){
+    NOELLE_reducePrivateCopyOfIntegers(original, privateCopy, elements);
+  }
+
+  void NOELLE_reducePrivateCopyInt64 (int64_t *original, int64_t *privateCopy, int64_t elements){
+    NOELLE_reducePrivateCopyOfIntegers(original, privateCopy, elements);
+  }
+
+  void NOELLE_reducePrivateCopyFloat (float *original, float *privateCopy, int64_t elements){
+    NOELLE_reducePrivateCopyOfFloatingPoints<float, uint32_t>(original, privateCopy, elements);
+  }
+
+  void NOELLE_reducePrivateCopyDouble (double *original, double *privateCopy, int64_t elements){
+    NOELLE_reducePrivateCopyOfFloatingPoints<double, uint64_t>(original, privateCopy, elements);
+  }
+
 
   /**********************************************************************
    *                DOALL
@@ -230,7 +728,9 @@ extern "C" {
     /*
      * Invoke
      */
+    NOELLE_nestingLevel++;
     DOALLArgs->parallelizedLoop(DOALLArgs->env, DOALLArgs->coreID, DOALLArgs->numCores, DOALLArgs->chunkSize);
+    NOELLE_nestingLevel--;
     #ifdef RUNTIME_PROFILE
     auto clocks_end = rdtsc_e();
     clocks_starts[DOALLArgs->coreID] = clocks_start;
@@ -258,8 +758,17 @@ extern "C" {
 
     /*
      * Set the number of cores to use.
+     *
+     * If the loop is nested within a parallelized one (e.g., within a pipeline stage), the core of the caller has been reserved already.
+     * Hence, only the additional cores are reserved, and the loop runs on the caller alone when no core is idle.
      */
-    auto numCores = runtime.reserveCores(maxNumberOfCores);
+    auto isNested = (NOELLE_nestingLevel > 0);
+    uint32_t numCores;
+    if (isNested){
+      numCores = 1 + runtime.reserveAdditionalCores(maxNumberOfCores - 1);
+    } else {
+      numCores = runtime.reserveCores(maxNumberOfCores);
+    }
     #ifdef RUNTIME_PRINT
     std::cerr << "Starting dispatcher: num cores " << numCores << ", chunk size: " << chunkSize << std::endl;
     #endif
@@ -310,7 +819,9 @@ extern "C" {
     /*
      * Run a task.
      */
+    NOELLE_nestingLevel++;
     parallelizedLoop(env, numCores - 1, numCores, chunkSize);
+    NOELLE_nestingLevel--;
 
     /*
      * Wait for the remaining DOALL tasks.
@@ -332,7 +843,11 @@ extern "C" {
     /*
      * Free the cores and memory.
      */
-    runtime.releaseCores(numCores);
+    if (!isNested){
+      runtime.releaseCores(numCores);
+    } else if (numCores > 1){
+      runtime.releaseCores(numCores - 1);
+    }
     runtime.releaseDOALLArgs(doallMemoryIndex);
 
     /*
@@ -423,6 +938,7 @@ extern "C" {
     /*
      * Invoke
      */
+    NOELLE_nestingLevel++;
     HELIX_args->parallelizedLoop(
       HELIX_args->env, 
       HELIX_args->loopCarriedArray, 
@@ -432,6 +948,7 @@ extern "C" {
       HELIX_args->numCores,
       HELIX_args->loopIsOverFlag
       );
+    NOELLE_nestingLevel--;
 
     pthread_mutex_unlock(&(HELIX_args->endLock));
     return ;
@@ -757,18 +1274,96 @@ extern "C" {
     /*
      * Invoke
      */
+    NOELLE_nestingLevel++;
     DSWPArgs->funcToInvoke(DSWPArgs->env, DSWPArgs->localQueues);
+    NOELLE_nestingLevel--;
 
     pthread_mutex_unlock(&(DSWPArgs->endLock));
     return ;
   }
 
+  static int64_t NOELLE_getDSWPQueueElementSize (int64_t queueSize, bool isRecord){
+    if (isRecord){
+      return queueSize / 8;
+    }
+    switch (queueSize) {
+      case 1:
+      case 8:
+        return sizeof(int8_t);
+      case 16:
+        return sizeof(int16_t);
+      case 32:
+        return sizeof(int32_t);
+      case 64:
+        return sizeof(int64_t);
+      default:
+        std::cerr << "NOELLE: Runtime: QUEUE SIZE INCORRECT" << std::endl;
+        abort();
+    }
+
+    return 0;
+  }
+
+  static void * NOELLE_allocateDSWPQueue (int64_t queueSize, bool isRecord, uint64_t capacity, uint64_t batchSize){
+    if (isRecord){
+      return new NOELLE_DSWPRecordQueue(capacity, batchSize, queueSize / 8);
+    }
+    switch (queueSize) {
+      case 1:
+        return new NOELLE_DSWPQueue<int8_t>(capacity, batchSize);
+      case 8:
+        return new NOELLE_DSWPQueue<int8_t>(capacity, batchSize);
+      case 16:
+        return new NOELLE_DSWPQueue<int16_t>(capacity, batchSize);
+      case 32:
+        return new NOELLE_DSWPQueue<int32_t>(capacity, batchSize);
+      case 64:
+        return new NOELLE_DSWPQueue<int64_t>(capacity, batchSize);
+      default:
+        std::cerr << "NOELLE: Runtime: QUEUE SIZE INCORRECT" << std::endl;
+        abort();
+    }
+
+    return nullptr;
+  }
+
+  static void NOELLE_freeDSWPQueue (void *queue, int64_t queueSize, bool isRecord){
+    if (isRecord){
+      delete (NOELLE_DSWPRecordQueue *)(queue);
+      return ;
+    }
+    switch (queueSize) {
+      case 1:
+        delete (NOELLE_DSWPQueue<int8_t> *)(queue);
+        break;
+      case 8:
+        delete (NOELLE_DSWPQueue<int8_t> *)(queue);
+        break;
+      case 16:
+        delete (NOELLE_DSWPQueue<int16_t> *)(queue);
+        break;
+      case 32:
+        delete (NOELLE_DSWPQueue<int32_t> *)(queue);
+        break;
+      case 64:
+        delete (NOELLE_DSWPQueue<int64_t> *)(queue);
+        break;
+    }
+
+    return ;
+  }
+
   DispatcherInfo NOELLE_DSWPDispatcher (
     void *env, 
     int64_t *queueSizes, 
     void *stages, 
     int64_t numberOfStages, 
-    int64_t numberOfQueues
+    int64_t numberOfQueues,
+    int64_t *stageReplicas,
+    int64_t *routedQueues,
+    int64_t *queueCapacities,
+    int64_t *queueBatchSizes,
+    int64_t *recordQueues
     ){
     #ifdef RUNTIME_PRINT
     std::cerr << "Starting dispatcher: num stages " << numberOfStages << ", num queues: " << numberOfQueues << std::endl;
@@ -779,38 +1374,98 @@ extern "C" {
      */
     auto virgil = runtime.virgil;
 
+    /*
+     * Compute the number of cores we would like to use.
+     * Every stage needs a core, and replicated stages (PS-DSWP) would like one core per replica.
+     */
+    int64_t numberOfReplicatedStages = 0;
+    int64_t maxReplicas = 1;
+    int64_t coresRequested = 0;
+    for (auto i = 0; i < numberOfStages; ++i) {
+      coresRequested += stageReplicas[i];
+      if (stageReplicas[i] > 1){
+        numberOfReplicatedStages++;
+        maxReplicas = std::max(maxReplicas, stageReplicas[i]);
+      }
+    }
+
     /*
      * Reserve the cores.
      */
-    auto numCores = runtime.reserveCores(numberOfStages);
+    auto numCores = runtime.reserveCores(coresRequested);
     assert(numCores >= 1);
 
+    /*
+     * Hand the cores left after assigning one per stage to the replicated stages.
+     * All replicated stages use the same number of replicas so that replica i of a stage can talk to replica i of the next one directly.
+     */
+    int64_t replicas = 1;
+    if (  true
+          && (numberOfReplicatedStages > 0)
+          && (numCores > numberOfStages)
+       ){
+      replicas = 1 + ((numCores - numberOfStages) / numberOfReplicatedStages);
+      replicas = std::min(replicas, maxReplicas);
+    }
+    auto numberOfStageInstances = numberOfStages + (numberOfReplicatedStages * (replicas - 1));
+    #ifdef RUNTIME_PRINT
+    std::cerr << "Replicas per replicated stage: " << replicas << ", stage instances: " << numberOfStageInstances << std::endl;
+    #endif
+
+    /*
+     * Compute the capacity of the communication queues.
+     *
+     * The capacities suggested by the compiler are bounded to let all queues fit in half of the cache shared by the cores.
+     * The other half is left to the data accessed by the stages.
+     */
+    int64_t physicalQueues = 0;
+    for (auto i = 0; i < numberOfQueues; ++i) {
+      physicalQueues += routedQueues[i] ? replicas : 1;
+    }
+    auto queueBudget = runtime.getSharedCacheSize() / (2 * std::max(physicalQueues, (int64_t)1));
+    std::vector<uint64_t> capacities(numberOfQueues);
+    std::vector<uint64_t> batchSizes(numberOfQueues);
+    for (auto i = 0; i < numberOfQueues; ++i) {
+      uint64_t capacity = queueCapacities[i];
+      auto maxCapacity = queueBudget / NOELLE_getDSWPQueueElementSize(queueSizes[i], recordQueues[i]);
+      while (  true
+               && (capacity > 2)
+               && (capacity > maxCapacity)
+            ){
+        capacity /= 2;
+      }
+      uint64_t batchSize = queueBatchSizes[i];
+      if (batchSize >= capacity){
+        batchSize = capacity / 2;
+      }
+      capacities[i] = capacity;
+      batchSizes[i] = std::max(batchSize, (uint64_t)1);
+    }
+
     /*
      * Allocate the communication queues.
+     *
+     * A queue that connects a replicated stage has one physical queue per replica.
+     * The end of the queue that is not replicated accesses them round-robin.
      */
     void *localQueues[numberOfQueues];
+    std::vector<std::vector<void *>> replicaQueues(numberOfQueues);
+    std::vector<NOELLE_RoundRobinQueue_t> roundRobinQueues(numberOfQueues);
     for (auto i = 0; i < numberOfQueues; ++i) {
-      switch (queueSizes[i]) {
-        case 1:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int8_t>();
-          break;
-        case 8:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int8_t>();
-          break;
-        case 16:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int16_t>();
-          break;
-        case 32:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int32_t>();
-          break;
-        case 64:
-          localQueues[i] = new ThreadSafeLockFreeQueue<int64_t>();
-          break;
-        default:
-          std::cerr << "NOELLE: Runtime: QUEUE SIZE INCORRECT" << std::endl;
-          abort();
-          break;
+      if (!routedQueues[i]){
+        localQueues[i] = NOELLE_allocateDSWPQueue(queueSizes[i], recordQueues[i], capacities[i], batchSizes[i]);
+        continue ;
+      }
+      for (auto r = 0; r < replicas; ++r){
+        replicaQueues[i].push_back(NOELLE_allocateDSWPQueue(queueSizes[i], recordQueues[i], capacities[i], batchSizes[i]));
       }
+      auto rrQueue = &roundRobinQueues[i];
+      rrQueue->replicaQueues = replicaQueues[i].data();
+      rrQueue->numberOfReplicas = replicas;
+      rrQueue->bitLength = queueSizes[i];
+      rrQueue->next = 0;
+      rrQueue->lastValue = 0;
+      localQueues[i] = (void *)rrQueue;
     }
     #ifdef RUNTIME_PRINT
     std::cerr << "Made queues" << std::endl;
@@ -819,32 +1474,56 @@ extern "C" {
     /*
      * Allocate the memory to store the arguments.
      */
-    auto argsForAllCores = (NOELLE_DSWP_args_t *) malloc(sizeof(NOELLE_DSWP_args_t) * numberOfStages);
+    auto argsForAllCores = (NOELLE_DSWP_args_t *) malloc(sizeof(NOELLE_DSWP_args_t) * numberOfStageInstances);
+    auto queuesForReplicas = (void **) malloc(sizeof(void *) * numberOfQueues * numberOfReplicatedStages * replicas);
 
     /*
      * Submit DSWP tasks
      */
     auto allStages = (void **)stages;
+    auto instanceID = 0;
+    auto replicatedStageID = 0;
     for (auto i = 0; i < numberOfStages; ++i) {
+      auto stageInstances = (stageReplicas[i] > 1) ? replicas : 1;
+      for (auto r = 0; r < stageInstances; ++r) {
 
-      /*
-       * Prepare the arguments.
-       */
-      auto argsPerCore = &argsForAllCores[i];
-      argsPerCore->funcToInvoke = reinterpret_cast<stageFunctionPtr_t>(reinterpret_cast<long long>(allStages[i]));
-      argsPerCore->env = env;
-      argsPerCore->localQueues = (void *) localQueues;
-      pthread_mutex_init(&(argsPerCore->endLock), NULL);
-      pthread_mutex_lock(&(argsPerCore->endLock));
+        /*
+         * Prepare the queues seen by the current stage instance.
+         * A replica sees its own physical queue of every queue that connects its stage.
+         */
+        auto queuesOfInstance = (void *) localQueues;
+        if (stageReplicas[i] > 1){
+          auto replicaLocalQueues = &queuesForReplicas[((replicatedStageID * replicas) + r) * numberOfQueues];
+          for (auto q = 0; q < numberOfQueues; ++q) {
+            replicaLocalQueues[q] = routedQueues[q] ? replicaQueues[q][r] : localQueues[q];
+          }
+          queuesOfInstance = (void *) replicaLocalQueues;
+        }
 
-      /*
-       * Submit
-       */
-      virgil->submitAndDetach(NOELLE_DSWPTrampoline, argsPerCore);
-      #ifdef RUNTIME_PRINT
-      std::cerr << "Submitted stage" << std::endl;
-      #endif
+        /*
+         * Prepare the arguments.
+         */
+        auto argsPerCore = &argsForAllCores[instanceID];
+        argsPerCore->funcToInvoke = reinterpret_cast<stageFunctionPtr_t>(reinterpret_cast<long long>(allStages[i]));
+        argsPerCore->env = env;
+        argsPerCore->localQueues = queuesOfInstance;
+        pthread_mutex_init(&(argsPerCore->endLock), NULL);
+        pthread_mutex_lock(&(argsPerCore->endLock));
+
+        /*
+         * Submit
+         */
+        virgil->submitAndDetach(NOELLE_DSWPTrampoline, argsPerCore);
+        instanceID++;
+        #ifdef RUNTIME_PRINT
+        std::cerr << "Submitted stage" << std::endl;
+        #endif
+      }
+      if (stageReplicas[i] > 1){
+        replicatedStageID++;
+      }
     }
+    assert(instanceID == numberOfStageInstances);
     #ifdef RUNTIME_PRINT
     std::cerr << "Submitted pool" << std::endl;
     #endif
@@ -852,7 +1531,7 @@ extern "C" {
     /*
      * Wait for the tasks to complete.
      */
-    for (auto i = 0; i < numberOfStages; ++i) {
+    for (auto i = 0; i < numberOfStageInstances; ++i) {
       pthread_mutex_lock(&(argsForAllCores[i].endLock));
     }
     #ifdef RUNTIME_PRINT
@@ -864,25 +1543,16 @@ extern "C" {
      */
     runtime.releaseCores(numCores);
     for (int i = 0; i < numberOfQueues; ++i) {
-      switch (queueSizes[i]) {
-        case 1:
-          delete (ThreadSafeLockFreeQueue<int8_t> *)(localQueues[i]);
-          break;
-        case 8:
-          delete (ThreadSafeLockFreeQueue<int8_t> *)(localQueues[i]);
-          break;
-        case 16:
-          delete (ThreadSafeLockFreeQueue<int16_t> *)(localQueues[i]);
-          break;
-        case 32:
-          delete (ThreadSafeLockFreeQueue<int32_t> *)(localQueues[i]);
-          break;
-        case 64:
-          delete (ThreadSafeLockFreeQueue<int64_t> *)(localQueues[i]);
-          break;
+      if (!routedQueues[i]){
+        NOELLE_freeDSWPQueue(localQueues[i], queueSizes[i], recordQueues[i]);
+        continue ;
+      }
+      for (auto replicaQueue : replicaQueues[i]){
+        NOELLE_freeDSWPQueue(replicaQueue, queueSizes[i], recordQueues[i]);
       }
     }
     free(argsForAllCores);
+    free(queuesForReplicas);
 
     #ifdef DSWP_STATS
     std::cout << "DSWP: 1 Byte pushes = " << numberOfPushes8 << std::endl;
@@ -892,7 +1562,7 @@ extern "C" {
     #endif
 
     DispatcherInfo dispatcherInfo;
-    dispatcherInfo.numberOfThreadsUsed = numberOfStages;
+    dispatcherInfo.numberOfThreadsUsed = numberOfStageInstances;
     return dispatcherInfo;
   }
 
@@ -902,6 +1572,18 @@ NoelleRuntime::NoelleRuntime() {
   this->maxCores = this->getMaximumNumberOfCores();
   this->NOELLE_idleCores = maxCores;
 
+  /*
+   * Fetch the size of the cache shared between cores.
+   */
+  auto cacheSize = sysconf(_SC_LEVEL3_CACHE_SIZE);
+  if (cacheSize <= 0){
+    cacheSize = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  }
+  if (cacheSize <= 0){
+    cacheSize = 1024 * 1024;
+  }
+  this->sharedCacheSize = cacheSize;
+
   pthread_spin_init(&this->spinLock, 0);
   pthread_spin_init(&this->doallMemoryLock, 0);
   #ifdef RUNTIME_PROFILE
@@ -983,6 +1665,10 @@ void NoelleRuntime::releaseDOALLArgs (uint32_t index){
   return ;
 }
 
+uint64_t NoelleRuntime::getSharedCacheSize (void) const {
+  return this->sharedCacheSize;
+}
+
 uint32_t NoelleRuntime::reserveCores (uint32_t coresRequested){
  
   /*
@@ -999,6 +1685,23 @@ uint32_t NoelleRuntime::reserveCores (uint32_t coresRequested){
   return numCores;
 }
     
+uint32_t NoelleRuntime::reserveAdditionalCores (uint32_t coresRequested){
+
+  /*
+   * Reserve the idle cores up to the number requested.
+   * Differently from reserveCores, no core is reserved if all of them are busy: the caller already owns one.
+   */
+  pthread_spin_lock(&this->spinLock);
+  uint32_t numCores = 0;
+  if (this->NOELLE_idleCores > 0){
+    numCores = std::min((uint32_t)this->NOELLE_idleCores, coresRequested);
+  }
+  this->NOELLE_idleCores -= numCores;
+  pthread_spin_unlock(&this->spinLock);
+
+  return numCores;
+}
+
 void NoelleRuntime::releaseCores (uint32_t coresReleased){
   assert(coresReleased > 0);
 
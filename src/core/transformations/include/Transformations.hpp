@@ -26,9 +26,11 @@ namespace llvm::noelle {
     LOOP_WHILIFIER_ID,
     SCEV_SIMPLIFICATION_ID,
     DEVIRTUALIZER_ID,
+    LOOP_VERSIONING_ID,
+    LOOP_FUSION_ID,
 
     First=DOALL_ID,
-    Last=DEVIRTUALIZER_ID
+    Last=LOOP_FUSION_ID
   };
 
   enum LoopDependenceInfoOptimization {
@@ -67,6 +67,16 @@ namespace llvm::noelle {
         Noelle &par
       );
 
+      /*
+       * Remove the loop-carried data dependences of memory locations that evolve only through updates that can be reduced.
+       * Every task accumulates into a private copy of the memory location, which it adds to the original one when it ends.
+       * Memory locations larger than maximumBytesOfPrivateCopiesToReduce, or whose size is unknown, are updated atomically instead.
+       */
+      void reduceLoopCarriedMemoryLocations (
+        LoopDependenceInfo *LDI
+      );
+      static const uint64_t maximumBytesOfPrivateCopiesToReduce = 64 * 1024;
+
       /*
        * Helpers
        */
@@ -102,7 +102,7 @@ bool DOALL::canBeAppliedToLoop (
    * The loop must have all live-out variables to be reducable.
    */
   auto sccManager = LDI->getSCCManager();
-  if (!sccManager->areAllLiveOutValuesReducable(LDI->environment)) {
+  if (!sccManager->areAllLiveOutValuesReducable(LDI->getEnvironment())) {
     if (this->verbose != Verbosity::Disabled) {
       errs() << "DOALL:   Some post environment value is not reducable\n";
     }
@@ -215,7 +215,7 @@ bool DOALL::apply (
   /*
    * Fetch the environment of the loop.
    */
-  auto loopEnvironment = LDI->environment;
+  auto loopEnvironment = LDI->getEnvironment();
 
   /*
    * Print the parallelization request.
@@ -280,6 +280,11 @@ bool DOALL::apply (
     errs() << "DOALL:  Adjusted data flow\n";
   }
 
+  /*
+   * Remove the loop-carried data dependences of memory locations that are reduced.
+   */
+  this->reduceLoopCarriedMemoryLocations(LDI);
+
   this->setReducableVariablesToBeginAtIdentityValue(LDI, 0);
   this->rewireLoopToIterateChunks(LDI);
   if (this->verbose >= Verbosity::Maximal) {
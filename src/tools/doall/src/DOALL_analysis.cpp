@@ -55,6 +55,13 @@ std::unordered_set<SCC *> DOALL::getSCCsThatBlockDOALLToBeApplicable (
       continue ;
     }
 
+    /*
+     * If the SCC is due to a memory location that only evolves through updates that can be reduced, then DOALL can reduce it.
+     */
+    if (sccInfo->getLoopCarriedMemoryLocation() != nullptr){
+      continue ;
+    }
+
     /*
      * If all loop carried data dependencies within the SCC do not overlap between
      * iterations, then DOALL can ignore them
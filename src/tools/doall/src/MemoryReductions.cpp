@@ -0,0 +1,226 @@
+/*
+ * Copyright 2016 - 2021  Angelo Matni, Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "DOALL.hpp"
+#include "DOALLTask.hpp"
+
+namespace llvm::noelle {
+
+void DOALL::reduceLoopCarriedMemoryLocations (
+  LoopDependenceInfo *LDI
+) {
+
+  /*
+   * Fetch the task and the SCC manager of the loop.
+   */
+  auto task = this->tasks[0];
+  auto sccManager = LDI->getSCCManager();
+  auto &DL = this->module.getDataLayout();
+  auto &cxt = this->module.getContext();
+  auto int8 = IntegerType::get(cxt, 8);
+  auto int64 = IntegerType::get(cxt, 64);
+
+  /*
+   * Private copies are allocated at the entry of the task, and they are merged with the original memory locations at the exit of the task.
+   * The merging code runs before the private copies of cloned memory locations are released, which have been allocated earlier.
+   */
+  auto entryBlock = task->getEntry();
+  IRBuilder<> entryBuilder(entryBlock);
+  if (auto entryTerminator = entryBlock->getTerminator()){
+    entryBuilder.SetInsertPoint(entryTerminator);
+  }
+  auto exitBlock = task->getExit();
+  IRBuilder<> exitBuilder(exitBlock, exitBlock->getFirstInsertionPt());
+
+  /*
+   * Reduce every memory location that creates loop-carried data dependences through updates that can be reduced.
+   */
+  Function *allocatePrivateCopy = nullptr;
+  Function *releasePrivateCopies = nullptr;
+  int64_t privateCopies = 0;
+  for (auto scc : sccManager->getSCCsWithLoopCarriedDataDependencies()) {
+
+    /*
+     * Fetch the memory location.
+     */
+    auto sccInfo = sccManager->getSCCAttrs(scc);
+    auto location = sccInfo->getLoopCarriedMemoryLocation();
+    if (location == nullptr){
+      continue ;
+    }
+    auto memoryLocation = location->getMemoryLocation();
+    auto accumulatorType = location->getAccumulatorType();
+
+    /*
+     * Large arrays of accumulators and memory locations of unknown size are updated in place atomically.
+     */
+    auto sizeInBytes = location->getSizeInBytes();
+    if (  false
+          || (sizeInBytes == 0)
+          || (sizeInBytes > DOALL::maximumBytesOfPrivateCopiesToReduce)
+       ){
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "DOALL:   Reduce the memory location " << *memoryLocation << " through atomic updates\n";
+      }
+      for (auto &update : location->getUpdates()){
+
+        /*
+         * Fetch the clones of the update.
+         */
+        auto loadClone = task->getCloneOfOriginalInstruction(update.load);
+        auto operationClone = task->getCloneOfOriginalInstruction(update.operation);
+        auto storeClone = cast<StoreInst>(task->getCloneOfOriginalInstruction(update.store));
+        auto operandIndex = (update.operation->getOperand(0) == update.load) ? 1 : 0;
+        auto operandClone = operationClone->getOperand(operandIndex);
+
+        /*
+         * Replace the update with an atomic one.
+         */
+        AtomicRMWInst::BinOp atomicOperation;
+        switch (update.operation->getOpcode()){
+          case Instruction::Add:
+            atomicOperation = AtomicRMWInst::Add;
+            break ;
+          case Instruction::Sub:
+            atomicOperation = AtomicRMWInst::Sub;
+            break ;
+          case Instruction::FAdd:
+            atomicOperation = AtomicRMWInst::FAdd;
+            break ;
+          case Instruction::FSub:
+            atomicOperation = AtomicRMWInst::FSub;
+            break ;
+          default:
+            errs() << "DOALL: ERROR = the update " << *update.operation << " cannot be reduced\n";
+            abort();
+        }
+        IRBuilder<> updateBuilder(storeClone);
+        auto atomicUpdate = updateBuilder.CreateAtomicRMW(atomicOperation, storeClone->getPointerOperand(), operandClone, AtomicOrdering::Monotonic);
+        task->addInstruction(update.store, atomicUpdate);
+
+        /*
+         * Remove the non-atomic update.
+         */
+        storeClone->eraseFromParent();
+        operationClone->eraseFromParent();
+        loadClone->eraseFromParent();
+        task->removeOriginalInstruction(update.operation);
+        task->removeOriginalInstruction(update.load);
+      }
+      continue ;
+    }
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DOALL:   Reduce the memory location " << *memoryLocation << " through private copies of " << sizeInBytes << " bytes\n";
+    }
+
+    /*
+     * Fetch the runtime functions.
+     */
+    if (allocatePrivateCopy == nullptr){
+      allocatePrivateCopy = this->module.getFunction("NOELLE_allocatePrivateCopy");
+      releasePrivateCopies = this->module.getFunction("NOELLE_releasePrivateCopies");
+      if (  false
+            || (allocatePrivateCopy == nullptr)
+            || (releasePrivateCopies == nullptr)
+         ){
+        errs() << "DOALL: ERROR = functions NOELLE_allocatePrivateCopy and NOELLE_releasePrivateCopies couldn't be found\n";
+        abort();
+      }
+    }
+    std::string reduceFunctionName = "NOELLE_reducePrivateCopy";
+    if (accumulatorType->isIntegerTy()){
+      reduceFunctionName += "Int" + std::to_string(accumulatorType->getIntegerBitWidth());
+    } else if (accumulatorType->isFloatTy()){
+      reduceFunctionName += "Float";
+    } else {
+      reduceFunctionName += "Double";
+    }
+    auto reducePrivateCopy = this->module.getFunction(reduceFunctionName);
+    if (reducePrivateCopy == nullptr){
+      errs() << "DOALL: ERROR = function " << reduceFunctionName << " couldn't be found\n";
+      abort();
+    }
+
+    /*
+     * Fetch the memory location within the task.
+     */
+    Value *memoryLocationInTask = nullptr;
+    if (isa<Constant>(memoryLocation)){
+      memoryLocationInTask = memoryLocation;
+
+    } else if (task->isAnOriginalLiveIn(memoryLocation)){
+      memoryLocationInTask = task->getCloneOfOriginalLiveIn(memoryLocation);
+
+    } else {
+
+      /*
+       * The memory location must become a new live-in.
+       */
+      std::unordered_set<Instruction *> consumers;
+      for (auto &update : location->getUpdates()){
+        consumers.insert(update.load);
+        consumers.insert(update.store);
+      }
+      auto envUser = this->envBuilder->getUser(0);
+      auto newLiveInEnvironmentIndex = LDI->getEnvironment()->addLiveInValue(memoryLocation, consumers);
+      this->envBuilder->addVariableToEnvironment(newLiveInEnvironmentIndex, memoryLocation->getType());
+      envUser->addLiveInIndex(newLiveInEnvironmentIndex);
+      envUser->createEnvPtr(entryBuilder, newLiveInEnvironmentIndex, memoryLocation->getType());
+      memoryLocationInTask = entryBuilder.CreateLoad(envUser->getEnvPtr(newLiveInEnvironmentIndex));
+      task->addLiveIn(memoryLocation, memoryLocationInTask);
+    }
+
+    /*
+     * Allocate the private copy and initialize its accumulators to the identity value of additions.
+     */
+    auto privateCopy = entryBuilder.CreateCall(allocatePrivateCopy, ArrayRef<Value *>({ ConstantInt::get(int64, sizeInBytes) }));
+    entryBuilder.CreateMemSet(privateCopy, ConstantInt::get(int8, 0), sizeInBytes, 1);
+    privateCopies++;
+
+    /*
+     * Redirect the updates to the private copy.
+     */
+    auto memoryLocationAddress = entryBuilder.CreatePtrToInt(memoryLocationInTask, int64);
+    for (auto &update : location->getUpdates()){
+      auto loadClone = cast<LoadInst>(task->getCloneOfOriginalInstruction(update.load));
+      auto storeClone = cast<StoreInst>(task->getCloneOfOriginalInstruction(update.store));
+      auto pointer = loadClone->getPointerOperand();
+
+      IRBuilder<> updateBuilder(loadClone);
+      auto offset = updateBuilder.CreateSub(updateBuilder.CreatePtrToInt(pointer, int64), memoryLocationAddress);
+      auto privateAddress = updateBuilder.CreateInBoundsGEP(int8, privateCopy, offset);
+      auto privatePointer = updateBuilder.CreateBitCast(privateAddress, pointer->getType());
+      loadClone->setOperand(loadClone->getPointerOperandIndex(), privatePointer);
+      storeClone->setOperand(storeClone->getPointerOperandIndex(), privatePointer);
+    }
+
+    /*
+     * Merge the private copy with the original memory location when the task ends.
+     */
+    auto accumulatorPointerType = PointerType::getUnqual(accumulatorType);
+    auto accumulators = sizeInBytes / DL.getTypeAllocSize(accumulatorType);
+    exitBuilder.CreateCall(reducePrivateCopy, ArrayRef<Value *>({
+      exitBuilder.CreateBitCast(memoryLocationInTask, accumulatorPointerType),
+      exitBuilder.CreateBitCast(privateCopy, accumulatorPointerType),
+      ConstantInt::get(int64, accumulators)
+    }));
+  }
+
+  /*
+   * Release the private copies.
+   */
+  if (privateCopies > 0){
+    exitBuilder.CreateCall(releasePrivateCopies, ArrayRef<Value *>({ ConstantInt::get(int64, privateCopies) }));
+  }
+
+  return ;
+}
+
+}
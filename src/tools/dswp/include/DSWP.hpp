@@ -34,6 +34,7 @@ namespace llvm::noelle {
         Hot &p,
         bool forceParallelization,
         bool enableSCCMerging,
+        bool enableStageReplication,
         Verbosity v
       );
 
@@ -57,6 +58,17 @@ namespace llvm::noelle {
        * CLI Options
        */
       bool enableMergingSCC;
+      bool enableReplicatingStages;
+
+      /*
+       * Queue sizing.
+       * Capacities are in elements and the synchronization cost is in instructions (see computeQueueCapacitiesAndBatchSizes).
+       */
+      static constexpr uint64_t defaultQueueCapacity = 1024;
+      static constexpr uint64_t maximumQueueCapacity = 4096;
+      static constexpr uint64_t queueCapacityForImbalancedStages = 256;
+      static constexpr uint64_t maximumQueueBatchSize = 64;
+      static constexpr double queueSynchronizationCost = 200;
 
       /*
        * Stores new pipeline execution
@@ -89,10 +101,16 @@ namespace llvm::noelle {
       void generateStagesFromPartitionedSCCs (LoopDependenceInfo *LDI);
       void addClonableSCCsToStages (LoopDependenceInfo *LDI);
       bool isCompleteAndValidStageStructure(LoopDependenceInfo *LDI) const ;
+      void identifyReplicableStages (LoopDependenceInfo *LDI, Noelle &par);
+      bool canStageBeReplicated (LoopDependenceInfo *LDI, Noelle &par, DSWPTask *task) const ;
+      bool canSCCBeReplicated (LoopDependenceInfo *LDI, SCC *scc) const ;
+      uint32_t numberOfSpareCoresForReplicas (LoopDependenceInfo *LDI) const ;
       void generateLoopSubsetForStage (LoopDependenceInfo *LDI, int taskIndex);
       void generateLoadsOfQueuePointers (Noelle &par, int taskIndex);
       void popValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex);
       void pushValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex);
+      void flushQueues (Noelle &par, int taskIndex);
+      Function * fetchQueueFunction (Noelle &par, QueueInfo *queueInfo, bool isPush) const ;
       void createPipelineFromStages (LoopDependenceInfo *LDI, Noelle &par);
       Value * createStagesArrayFromStages (
         LoopDependenceInfo *LDI,
@@ -104,6 +122,31 @@ namespace llvm::noelle {
         IRBuilder<> funcBuilder,
         Noelle &par
       );
+      Value * createStageReplicasArrayFromStages (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> funcBuilder,
+        Noelle &par
+      );
+      Value * createQueueRoutingArrayFromStages (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> funcBuilder,
+        Noelle &par
+      );
+      Value * createQueueCapacitiesArrayFromStages (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> funcBuilder,
+        Noelle &par
+      );
+      Value * createQueueBatchSizesArrayFromStages (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> funcBuilder,
+        Noelle &par
+      );
+      Value * createQueueRecordArrayFromStages (
+        LoopDependenceInfo *LDI,
+        IRBuilder<> funcBuilder,
+        Noelle &par
+      );
 
       /*
        * Recursively inline queue push/pop functions in DSWP Utils and ThreadPool API
@@ -131,6 +174,10 @@ namespace llvm::noelle {
       void collectLiveInEnvInfo (LoopDependenceInfo *LDI);
       void collectLiveOutEnvInfo (LoopDependenceInfo *LDI);
       bool areQueuesAcyclical () const ;
+      void packQueues (LoopDependenceInfo *LDI, Noelle &par);
+      bool isQueueOfScalarsSupported (Noelle &par, QueueInfo *queueInfo) const ;
+      void computeQueueCapacitiesAndBatchSizes (LoopDependenceInfo *LDI, Noelle &par);
+      double computeAverageInstructionsPerIteration (LoopDependenceInfo *LDI, Noelle &par, DSWPTask *task) const ;
 
       /*
        * Debug utilities
@@ -45,6 +45,17 @@ namespace llvm::noelle {
       std::set<SCC *> stageSCCs;
       std::set<SCC *> clonableSCCs;
 
+      /*
+       * Whether the stage can be replicated across cores (PS-DSWP).
+       * Replicas of a stage execute iterations in a round-robin fashion.
+       */
+      bool isReplicable;
+
+      /*
+       * Number of cores the stage executes on (1 if the stage is not replicated).
+       */
+      uint32_t numberOfReplicas;
+
       /*
        * Maps from producer to the queues they push to
        */
@@ -74,12 +85,36 @@ namespace llvm::noelle {
     int bitLength;
     bool isMemoryDependence;
 
+    /*
+     * Whether the producer/consumer stage of this queue is replicated.
+     * The non-replicated end of such a queue routes values round-robin across the replicas.
+     */
+    bool fromReplicatedStage;
+    bool toReplicatedStage;
+
+    /*
+     * Number of elements the queue can hold and number of elements the producer pushes before making them visible to the consumer.
+     */
+    uint64_t capacity;
+    uint64_t batchSize;
+
+    /*
+     * Queues of records carry all values produced in the same basic block that flow between two stages.
+     * Values are packed into a single element, so there is one synchronization per iteration.
+     */
+    bool isRecord;
+    std::vector<Instruction *> packedProducers;
+    uint64_t recordSize;
+
     Instruction * producer;
     std::set<Instruction *> consumers;
     unordered_map<Instruction *, int> consumerToPushIndex;
 
     QueueInfo(Instruction *p, Instruction *c, Type *type, bool isMemoryDependence)
-        : producer{p}, dependentType{type}, isMemoryDependence{isMemoryDependence} {
+        : producer{p}, dependentType{type}, isMemoryDependence{isMemoryDependence},
+          fromReplicatedStage{false}, toReplicatedStage{false},
+          capacity{0}, batchSize{1},
+          isRecord{false}, packedProducers{p}, recordSize{0} {
       consumers.insert(c);
       if (isMemoryDependence) {
         dependentType = IntegerType::get(c->getContext(), 1);
@@ -93,10 +128,20 @@ namespace llvm::noelle {
       }
     }
 
+    QueueInfo(std::vector<Instruction *> producers, std::set<Instruction *> consumers, StructType *recordType)
+        : producer{producers[0]}, dependentType{recordType}, isMemoryDependence{false},
+          fromReplicatedStage{false}, toReplicatedStage{false},
+          capacity{0}, batchSize{1},
+          isRecord{true}, packedProducers{producers}, consumers{consumers} {
+      recordSize = producer->getModule()->getDataLayout().getTypeAllocSize(recordType);
+      bitLength = recordSize * 8;
+    }
+
     raw_ostream &print (raw_ostream &stream, std::string prefixToUse = "") {
       producer->print(stream << prefixToUse
         << "From stage: " << fromStage << " To stage: " << toStage
-        << " Number of bits: " << bitLength << " Producer: ");
+        << " Number of bits: " << bitLength
+        << " Capacity: " << capacity << " Batch: " << batchSize << " Producer: ");
       return stream << "\n";
     }
   };
@@ -18,10 +18,12 @@ DSWP::DSWP (
   Hot &p,
   bool forceParallelization,
   bool enableSCCMerging,
+  bool enableStageReplication,
   Verbosity v
 ) :
   ParallelizationTechniqueForLoopsWithLoopCarriedDataDependences{module, p, forceParallelization, v},
   enableMergingSCC{enableSCCMerging},
+  enableReplicatingStages{enableStageReplication},
   queues{}, queueArrayType{nullptr},
   sccToStage{}, stageArrayType{nullptr},
   zeroIndexForBaseArray{nullptr}
@@ -100,12 +102,21 @@ bool DSWP::canBeAppliedToLoop (
 
     /*
      * Check the coverage of the SCC.
+     *
+     * SCCs that will be replicated do not bound the throughput of the pipeline.
+     * Replicas need at least one spare core besides the ones of the sequential stage and of the stage of the SCC.
      */
-    auto currentSCCTotalInsts = profiles->getTotalInstructions(currentSCC);
-    if (currentSCCTotalInsts > biggestSCC){
-      biggestSCC = currentSCCTotalInsts;
+    auto canBeReplicated = true
+      && this->enableReplicatingStages
+      && (LDI->getMaximumNumberOfCores() > 2)
+      && this->canSCCBeReplicated(LDI, currentSCC);
+    if (!canBeReplicated){
+      auto currentSCCTotalInsts = profiles->getTotalInstructions(currentSCC);
+      if (currentSCCTotalInsts > biggestSCC){
+        biggestSCC = currentSCCTotalInsts;
+      }
+      assert(biggestSCC >= currentSCCTotalInsts);
     }
-    assert(biggestSCC >= currentSCCTotalInsts);
 
     /*
      * Check if the current SCC can be removed (e.g., because it is due to induction variables).
@@ -246,14 +257,29 @@ bool DSWP::apply (
    */
   collectDataAndMemoryQueueInfo(LDI, par);
   collectControlQueueInfo(LDI, par);
+
+  /*
+   * Identify the stateless stages that can be replicated (PS-DSWP).
+   */
+  identifyReplicableStages(LDI, par);
+
+  /*
+   * Pack values that flow between the same stages in the same iteration into records.
+   */
+  packQueues(LDI, par);
+
+  /*
+   * Size the queues based on the rate of their producer and consumer stages.
+   */
+  computeQueueCapacitiesAndBatchSizes(LDI, par);
   // assert(areQueuesAcyclical());
   // writeStageQueuesAsDot(*LDI);
 
   /*
    * Collect information on stages' environments
    */
-  auto liveInVars = LDI->environment->getEnvIndicesOfLiveInVars();
-  auto liveOutVars = LDI->environment->getEnvIndicesOfLiveOutVars();
+  auto liveInVars = LDI->getEnvironment()->getEnvIndicesOfLiveInVars();
+  auto liveOutVars = LDI->getEnvironment()->getEnvIndicesOfLiveOutVars();
   std::set<int> nonReducableVars(liveInVars.begin(), liveInVars.end());
   nonReducableVars.insert(liveOutVars.begin(), liveOutVars.end());
   std::set<int> reducableVars;
@@ -262,7 +288,7 @@ bool DSWP::apply (
    * Should an exit block environment variable be necessary, register one 
    */
   if (loopSummary->numberOfExitBasicBlocks() > 1){ 
-    nonReducableVars.insert(LDI->environment->indexOfExitBlockTaken());
+    nonReducableVars.insert(LDI->getEnvironment()->indexOfExitBlockTaken());
   }
 
   initializeEnvironmentBuilder(LDI, nonReducableVars, reducableVars);
@@ -360,6 +386,12 @@ bool DSWP::apply (
     IRBuilder<> exitBuilder(task->getExit());
     exitBuilder.CreateRetVoid();
 
+    /*
+     * Make pending batches visible to the consumers.
+     * Also, let replicas that are waiting for an iteration that will never come observe the end of the loop.
+     */
+    flushQueues(par, i);
+
     /*
      * Store final results to loop live-out variables.
      * Generate a store to propagate the information about which exit block has been taken from the parallelized loop to the code outside it.
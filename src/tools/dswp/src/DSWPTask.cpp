@@ -20,7 +20,9 @@ DSWPTask::DSWPTask (
   )
   : Task{ID, taskSignature, M},
     stageSCCs{},
-    clonableSCCs{}
+    clonableSCCs{},
+    isReplicable{false},
+    numberOfReplicas{1}
   {
 
   return ;
@@ -16,10 +16,10 @@ using namespace llvm::noelle;
 void DSWP::collectLiveInEnvInfo (LoopDependenceInfo *LDI) {
   auto sccManager = LDI->getSCCManager();
   auto sccdag = sccManager->getSCCDAG();
-  for (auto envIndex : LDI->environment->getEnvIndicesOfLiveInVars()) {
-    auto producer = LDI->environment->producerAt(envIndex);
+  for (auto envIndex : LDI->getEnvironment()->getEnvIndicesOfLiveInVars()) {
+    auto producer = LDI->getEnvironment()->producerAt(envIndex);
 
-    for (auto consumer : LDI->environment->consumersOf(producer)) {
+    for (auto consumer : LDI->getEnvironment()->consumersOf(producer)) {
 
       /*
        * Clonable consumers must be loaded into every task that uses them
@@ -50,8 +50,8 @@ void DSWP::collectLiveInEnvInfo (LoopDependenceInfo *LDI) {
 void DSWP::collectLiveOutEnvInfo (LoopDependenceInfo *LDI) {
   auto sccManager = LDI->getSCCManager();
   auto sccdag = sccManager->getSCCDAG();
-  for (auto envIndex : LDI->environment->getEnvIndicesOfLiveOutVars()) {
-    auto producer = LDI->environment->producerAt(envIndex);
+  for (auto envIndex : LDI->getEnvironment()->getEnvIndicesOfLiveOutVars()) {
+    auto producer = LDI->getEnvironment()->producerAt(envIndex);
 
     /*
      * Clonable producers all produce the same live out value.
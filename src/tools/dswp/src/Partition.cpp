@@ -68,3 +68,229 @@ void DSWP::partitionSCCDAG (LoopDependenceInfo *LDI, Heuristics *h) {
 
   return ;
 }
+
+void DSWP::identifyReplicableStages (LoopDependenceInfo *LDI, Noelle &par) {
+
+  /*
+   * Check if replicating stages is enabled.
+   */
+  if (!this->enableReplicatingStages){
+    return ;
+  }
+
+  /*
+   * Check if there are cores left for replicas once every stage got its own core.
+   */
+  auto spareCores = this->numberOfSpareCoresForReplicas(LDI);
+  if (spareCores == 0){
+    return ;
+  }
+
+  /*
+   * Identify the stages that can be replicated.
+   */
+  std::vector<DSWPTask *> replicableStages;
+  for (auto techniqueTask : this->tasks) {
+    auto task = (DSWPTask *)techniqueTask;
+    task->isReplicable = this->canStageBeReplicated(LDI, par, task);
+    if (task->isReplicable){
+      replicableStages.push_back(task);
+    }
+  }
+  if (replicableStages.size() == 0){
+    return ;
+  }
+
+  /*
+   * Split the spare cores across the replicable stages.
+   * All replicated stages have the same number of replicas so that replica i of a stage can talk to replica i of the next one directly (see NOELLE_DSWPDispatcher).
+   */
+  uint32_t replicas = 1 + (spareCores / replicableStages.size());
+  for (auto task : replicableStages){
+
+    /*
+     * Stages that got no spare core are not replicated.
+     */
+    if (replicas <= 1){
+      task->isReplicable = false;
+      continue ;
+    }
+    task->numberOfReplicas = replicas;
+    if (this->verbose != Verbosity::Disabled) {
+      errs() << "DSWP:  Stage " << task->getID() << " is stateless and it will be replicated " << task->numberOfReplicas << " times\n";
+    }
+  }
+
+  /*
+   * Tag the queues that connect a replicated stage.
+   * The non-replicated end of these queues will route values round-robin across the replicas.
+   */
+  for (auto &queue : this->queues) {
+    auto fromStage = (DSWPTask *)this->tasks[queue->fromStage];
+    auto toStage = (DSWPTask *)this->tasks[queue->toStage];
+    queue->fromReplicatedStage = fromStage->isReplicable;
+    queue->toReplicatedStage = toStage->isReplicable;
+  }
+
+  return ;
+}
+
+bool DSWP::canStageBeReplicated (LoopDependenceInfo *LDI, Noelle &par, DSWPTask *task) const {
+
+  /*
+   * A replica executes only a subset of the iterations.
+   * Hence, all values used by the stage must come from queues: a clonable SCC (e.g., an induction variable) would be evolved by every replica as if it executed all iterations.
+   */
+  if (task->clonableSCCs.size() > 0){
+    return false;
+  }
+
+  /*
+   * Every SCC of the stage must be replicable.
+   */
+  for (auto scc : task->stageSCCs) {
+    if (!this->canSCCBeReplicated(LDI, scc)){
+      return false;
+    }
+  }
+
+  /*
+   * Values are routed to replicas round-robin based on the number of pushes done.
+   * Hence, every queue connected to the stage must be pushed exactly once per iteration.
+   * This is guaranteed when the producer executes in every iteration (i.e., it dominates all latches).
+   *
+   * Also, queues are routed across replicas only if they carry scalars.
+   */
+  auto loopStructure = LDI->getLoopStructure();
+  auto latches = loopStructure->getLatches();
+  for (auto &queue : this->queues) {
+    if (  true
+          && (queue->fromStage != task->getID())
+          && (queue->toStage != task->getID())
+       ){
+      continue ;
+    }
+    if (!this->isQueueOfScalarsSupported(par, queue.get())){
+      return false;
+    }
+    auto producerBB = queue->producer->getParent();
+    for (auto latch : latches){
+      if (!this->originalFunctionDS->DT.dominates(producerBB, latch)){
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool DSWP::canSCCBeReplicated (LoopDependenceInfo *LDI, SCC *scc) const {
+
+  /*
+   * The iterations of the SCC must be independent between each other.
+   */
+  auto sccManager = LDI->getSCCManager();
+  auto sccInfo = sccManager->getSCCAttrs(scc);
+  if (!sccInfo->canExecuteIndependently()){
+    return false;
+  }
+
+  /*
+   * Clonable SCCs are not stages on their own: they are copied into the stages that depend on them.
+   */
+  if (sccInfo->canBeCloned()){
+    return false;
+  }
+
+  /*
+   * The stage that includes the SCC would include every clonable SCC it depends on.
+   */
+  auto sccdag = sccManager->getSCCDAG();
+  std::set<SCC *> visitedSCCs;
+  std::queue<SCC *> sccsToCheck;
+  sccsToCheck.push(scc);
+  while (!sccsToCheck.empty()){
+    auto currentSCC = sccsToCheck.front();
+    sccsToCheck.pop();
+    for (auto sccEdge : sccdag->fetchNode(currentSCC)->getIncomingEdges()) {
+      auto fromSCC = sccEdge->getOutgoingT();
+      if (visitedSCCs.find(fromSCC) != visitedSCCs.end()){
+        continue ;
+      }
+      visitedSCCs.insert(fromSCC);
+      if (sccManager->getSCCAttrs(fromSCC)->canBeCloned()){
+        return false;
+      }
+      sccsToCheck.push(fromSCC);
+    }
+  }
+
+  /*
+   * SCCs connected by memory dependences are merged in the same stage (see partitionSCCDAG), which would then include the SCC that writes memory.
+   */
+  auto sccNode = sccdag->fetchNode(scc);
+  std::vector<DGEdge<SCC> *> sccEdges(sccNode->getIncomingEdges().begin(), sccNode->getIncomingEdges().end());
+  sccEdges.insert(sccEdges.end(), sccNode->getOutgoingEdges().begin(), sccNode->getOutgoingEdges().end());
+  for (auto sccEdge : sccEdges) {
+    for (auto subEdge : sccEdge->getSubEdges()) {
+      if (subEdge->isMemoryDependence()){
+        return false;
+      }
+    }
+  }
+
+  auto loopStructure = LDI->getLoopStructure();
+  for (auto nodePair : scc->internalNodePairs()) {
+    auto inst = dyn_cast<Instruction>(nodePair.first);
+    if (inst == nullptr){
+      continue ;
+    }
+
+    /*
+     * The stage must be stateless.
+     * This guarantees that a replica can re-execute the last iteration of the loop when the pipeline drains.
+     */
+    if (inst->mayWriteToMemory()){
+      return false;
+    }
+
+    /*
+     * The stage cannot decide when the loop ends.
+     * Replicas only observe their own iterations, so they cannot inform the others about the loop exit.
+     */
+    if (inst->isTerminator()){
+      for (auto succBB : successors(inst)){
+        if (!loopStructure->isIncluded(succBB)){
+          return false;
+        }
+      }
+    }
+  }
+
+  /*
+   * The stage cannot generate live-out values.
+   */
+  for (auto envIndex : LDI->getEnvironment()->getEnvIndicesOfLiveOutVars()) {
+    auto producer = LDI->getEnvironment()->producerAt(envIndex);
+    if (sccdag->sccOfValue(producer) == scc){
+      return false;
+    }
+  }
+
+  return true;
+}
+
+uint32_t DSWP::numberOfSpareCoresForReplicas (LoopDependenceInfo *LDI) const {
+
+  /*
+   * Every stage needs its own core.
+   * The remaining ones are available for replicas.
+   */
+  auto maxCores = LDI->getMaximumNumberOfCores();
+  auto numberOfStages = this->tasks.size();
+  if (maxCores <= numberOfStages){
+    return 0;
+  }
+
+  return maxCores - numberOfStages;
+}
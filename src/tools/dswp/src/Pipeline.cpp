@@ -144,6 +144,25 @@ void DSWP::createPipelineFromStages (LoopDependenceInfo *LDI, Noelle &par) {
    */
   auto queueSizesPtr = createQueueSizesArrayFromStages(LDI, builder, par);
 
+  /*
+   * Allocate the arrays that describe replicated stages (PS-DSWP).
+   * The first one includes the maximum number of replicas of each stage.
+   * The second one tags the queues that connect a replicated stage.
+   */
+  auto stageReplicasPtr = createStageReplicasArrayFromStages(LDI, builder, par);
+  auto queueRoutingPtr = createQueueRoutingArrayFromStages(LDI, builder, par);
+
+  /*
+   * Allocate the arrays that include the capacity and the batch size of each queue.
+   */
+  auto queueCapacitiesPtr = createQueueCapacitiesArrayFromStages(LDI, builder, par);
+  auto queueBatchSizesPtr = createQueueBatchSizesArrayFromStages(LDI, builder, par);
+
+  /*
+   * Allocate the array that tags the queues of records.
+   */
+  auto queueRecordsPtr = createQueueRecordArrayFromStages(LDI, builder, par);
+
   /*
    * Call the stage dispatcher with the environment, queues array, and stages array
    */
@@ -158,7 +177,12 @@ void DSWP::createPipelineFromStages (LoopDependenceInfo *LDI, Noelle &par) {
     queueSizesPtr,
     stagesPtr,
     stagesCount,
-    queuesCount
+    queuesCount,
+    stageReplicasPtr,
+    queueRoutingPtr,
+    queueCapacitiesPtr,
+    queueBatchSizesPtr,
+    queueRecordsPtr
   }));
   auto numThreadsUsed = builder.CreateExtractValue(runtimeCall, (uint64_t)0);
 
@@ -213,3 +237,104 @@ Value * DSWP::createQueueSizesArrayFromStages (
 
   return cast<Value>(funcBuilder.CreateBitCast(queuesAlloca, PointerType::getUnqual(par.int64)));
 }
+
+Value * DSWP::createStageReplicasArrayFromStages (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> funcBuilder,
+  Noelle &par
+) {
+  auto stagesAlloca = cast<Value>(funcBuilder.CreateAlloca(ArrayType::get(par.int64, this->numTaskInstances)));
+  for (int i = 0; i < this->numTaskInstances; ++i) {
+    auto task = (DSWPTask *)this->tasks[i];
+    auto stageIndex = cast<Value>(ConstantInt::get(par.int64, i));
+    auto stagePtr = funcBuilder.CreateInBoundsGEP(stagesAlloca, ArrayRef<Value*>({
+      this->zeroIndexForBaseArray,
+      stageIndex
+    }));
+    auto stageCast = funcBuilder.CreateBitCast(stagePtr, PointerType::getUnqual(par.int64));
+    funcBuilder.CreateStore(ConstantInt::get(par.int64, task->numberOfReplicas), stageCast);
+  }
+
+  return cast<Value>(funcBuilder.CreateBitCast(stagesAlloca, PointerType::getUnqual(par.int64)));
+}
+
+Value * DSWP::createQueueRoutingArrayFromStages (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> funcBuilder,
+  Noelle &par
+) {
+  auto queuesAlloca = cast<Value>(funcBuilder.CreateAlloca(ArrayType::get(par.int64, this->queues.size())));
+  for (int i = 0; i < this->queues.size(); ++i) {
+    auto &queue = this->queues[i];
+    auto queueIndex = cast<Value>(ConstantInt::get(par.int64, i));
+    auto queuePtr = funcBuilder.CreateInBoundsGEP(queuesAlloca, ArrayRef<Value*>({
+      this->zeroIndexForBaseArray,
+      queueIndex
+    }));
+    auto queueCast = funcBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(par.int64));
+    auto isRouted = queue->fromReplicatedStage || queue->toReplicatedStage;
+    funcBuilder.CreateStore(ConstantInt::get(par.int64, isRouted ? 1 : 0), queueCast);
+  }
+
+  return cast<Value>(funcBuilder.CreateBitCast(queuesAlloca, PointerType::getUnqual(par.int64)));
+}
+
+Value * DSWP::createQueueCapacitiesArrayFromStages (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> funcBuilder,
+  Noelle &par
+) {
+  auto queuesAlloca = cast<Value>(funcBuilder.CreateAlloca(ArrayType::get(par.int64, this->queues.size())));
+  for (int i = 0; i < this->queues.size(); ++i) {
+    auto &queue = this->queues[i];
+    auto queueIndex = cast<Value>(ConstantInt::get(par.int64, i));
+    auto queuePtr = funcBuilder.CreateInBoundsGEP(queuesAlloca, ArrayRef<Value*>({
+      this->zeroIndexForBaseArray,
+      queueIndex
+    }));
+    auto queueCast = funcBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(par.int64));
+    funcBuilder.CreateStore(ConstantInt::get(par.int64, queue->capacity), queueCast);
+  }
+
+  return cast<Value>(funcBuilder.CreateBitCast(queuesAlloca, PointerType::getUnqual(par.int64)));
+}
+
+Value * DSWP::createQueueBatchSizesArrayFromStages (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> funcBuilder,
+  Noelle &par
+) {
+  auto queuesAlloca = cast<Value>(funcBuilder.CreateAlloca(ArrayType::get(par.int64, this->queues.size())));
+  for (int i = 0; i < this->queues.size(); ++i) {
+    auto &queue = this->queues[i];
+    auto queueIndex = cast<Value>(ConstantInt::get(par.int64, i));
+    auto queuePtr = funcBuilder.CreateInBoundsGEP(queuesAlloca, ArrayRef<Value*>({
+      this->zeroIndexForBaseArray,
+      queueIndex
+    }));
+    auto queueCast = funcBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(par.int64));
+    funcBuilder.CreateStore(ConstantInt::get(par.int64, queue->batchSize), queueCast);
+  }
+
+  return cast<Value>(funcBuilder.CreateBitCast(queuesAlloca, PointerType::getUnqual(par.int64)));
+}
+
+Value * DSWP::createQueueRecordArrayFromStages (
+  LoopDependenceInfo *LDI,
+  IRBuilder<> funcBuilder,
+  Noelle &par
+) {
+  auto queuesAlloca = cast<Value>(funcBuilder.CreateAlloca(ArrayType::get(par.int64, this->queues.size())));
+  for (int i = 0; i < this->queues.size(); ++i) {
+    auto &queue = this->queues[i];
+    auto queueIndex = cast<Value>(ConstantInt::get(par.int64, i));
+    auto queuePtr = funcBuilder.CreateInBoundsGEP(queuesAlloca, ArrayRef<Value*>({
+      this->zeroIndexForBaseArray,
+      queueIndex
+    }));
+    auto queueCast = funcBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(par.int64));
+    funcBuilder.CreateStore(ConstantInt::get(par.int64, queue->isRecord ? 1 : 0), queueCast);
+  }
+
+  return cast<Value>(funcBuilder.CreateBitCast(queuesAlloca, PointerType::getUnqual(par.int64)));
+}
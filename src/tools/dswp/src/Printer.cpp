@@ -23,6 +23,9 @@ void DSWP::printStageSCCs (LoopDependenceInfo *LDI) const {
   for (auto techniqueTask : this->tasks) {
     auto task = (DSWPTask *)techniqueTask;
     errs() << "DSWP:    Stage: " << task->getID() << "\n";
+    if (task->isReplicable) {
+      errs() << "DSWP:    The stage is replicated\n";
+    }
     for (auto scc : task->stageSCCs) {
       errs() << "DSWP:    SCC\n";
       for (auto nodePair : scc->internalNodePairs()) {
@@ -71,7 +74,9 @@ void DSWP::printStageQueues (LoopDependenceInfo *LDI) const {
   int count = 0;
   for (auto &queue : this->queues) {
     errs() << "DSWP:    Queue: " << count++ << "\n";
-    queue->producer->print(errs() << "DSWP:     Producer:\t"); errs() << "\n";
+    for (auto producer : queue->packedProducers) {
+      producer->print(errs() << "DSWP:     Producer:\t"); errs() << "\n";
+    }
     for (auto consumer : queue->consumers) {
       consumer->print(errs() << "DSWP:     Consumer:\t"); errs() << "\n";
     }
@@ -94,13 +99,13 @@ void DSWP::printEnv (LoopDependenceInfo *LDI) const {
    */
   errs() << "DSWP:  Environment\n";
   int count = 1;
-  for (auto envIndex : LDI->environment->getEnvIndicesOfLiveInVars()) {
-    LDI->environment->producerAt(envIndex)->print(errs()
+  for (auto envIndex : LDI->getEnvironment()->getEnvIndicesOfLiveInVars()) {
+    LDI->getEnvironment()->producerAt(envIndex)->print(errs()
       << "DSWP:    Pre loop env " << count++ << ", producer:\t");
     errs() << "\n";
   }
-  for (auto envIndex : LDI->environment->getEnvIndicesOfLiveOutVars()) {
-    LDI->environment->producerAt(envIndex)->print(errs()
+  for (auto envIndex : LDI->getEnvironment()->getEnvIndicesOfLiveOutVars()) {
+    LDI->getEnvironment()->producerAt(envIndex)->print(errs()
       << "DSWP:    Post loop env " << count++ << ", producer:\t");
     errs() << "\n";
   }
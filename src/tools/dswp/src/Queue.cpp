@@ -40,15 +40,8 @@ void DSWP::registerQueue (
     queueInfo = this->queues[queueIndex].get();
 
     /*
-     * Confirm a new queue is of a size handled by the parallelizer
+     * NOTE: values of sizes not supported by queues of scalars are packed into records by packQueues.
      */
-    auto& queueTypes = par.queues.queueSizeToIndex;
-    bool byteSize = queueTypes.find(queueInfo->bitLength) != queueTypes.end();
-    if (!byteSize) {
-      errs() << "NOT SUPPORTED BYTE SIZE (" << queueInfo->bitLength << "): "; producer->getType()->print(errs()); errs() <<  "\n";
-      producer->print(errs() << "Producer: "); errs() << "\n";
-      abort();
-    }
   }
 
   /*
@@ -259,8 +252,10 @@ bool DSWP::areQueuesAcyclical () const {
     for (auto queueIdx : task->pushValueQueues) {
       int toTaskIdx = this->queues[queueIdx]->toStage;
       if (toTaskIdx <= i) {
-        errs() << "DSWP:  ERROR! Push queue " << queueIdx << " loops back from stage "
-          << i << " to stage " << toTaskIdx;
+        if (this->verbose >= Verbosity::Maximal) {
+          errs() << "DSWP:  Push queue " << queueIdx << " loops back from stage "
+            << i << " to stage " << toTaskIdx << "\n";
+        }
         return false;
       }
     }
@@ -268,8 +263,10 @@ bool DSWP::areQueuesAcyclical () const {
     for (auto queueIdx : task->popValueQueues) {
       int fromTaskIdx = this->queues[queueIdx]->fromStage;
       if (fromTaskIdx >= i) {
-        errs() << "DSWP:  ERROR! Pop queue " << queueIdx << " goes from stage "
-          << fromTaskIdx << " to stage " << i;
+        if (this->verbose >= Verbosity::Maximal) {
+          errs() << "DSWP:  Pop queue " << queueIdx << " goes from stage "
+            << fromTaskIdx << " to stage " << i << "\n";
+        }
         return false;
       }
     }
@@ -278,6 +275,141 @@ bool DSWP::areQueuesAcyclical () const {
   return true;
 }
 
+void DSWP::packQueues (LoopDependenceInfo *LDI, Noelle &par) {
+
+  /*
+   * Packing delays the push of a value until all values of its record are produced.
+   * This is safe only if no stage waits for a value produced by a stage it feeds.
+   */
+  auto canGroup = this->areQueuesAcyclical();
+
+  /*
+   * Group the queues that carry values produced in the same basic block between the same pair of stages.
+   * These values are produced in the same iteration, so they can be pushed (and popped) together.
+   *
+   * Queues that touch a replicated stage are not packed as they are routed across replicas.
+   */
+  std::vector<std::vector<int>> groups;
+  std::map<std::tuple<int, int, BasicBlock *>, int> groupOfKey;
+  for (int i = 0; i < this->queues.size(); ++i) {
+    auto queueInfo = this->queues[i].get();
+    if (  false
+          || !canGroup
+          || queueInfo->isMemoryDependence
+          || queueInfo->fromReplicatedStage
+          || queueInfo->toReplicatedStage
+       ){
+      groups.push_back({ i });
+      continue ;
+    }
+    auto key = std::make_tuple(queueInfo->fromStage, queueInfo->toStage, queueInfo->producer->getParent());
+    if (groupOfKey.find(key) == groupOfKey.end()){
+      groupOfKey[key] = groups.size();
+      groups.push_back({});
+    }
+    groups[groupOfKey[key]].push_back(i);
+  }
+
+  /*
+   * Create the new set of queues.
+   * A group becomes a queue of records if it includes more than one value or if its only value cannot be carried by a queue of scalars.
+   */
+  std::vector<std::unique_ptr<QueueInfo>> newQueues;
+  std::unordered_map<int, int> oldToNewQueue;
+  for (auto &group : groups) {
+    auto newIndex = (int)newQueues.size();
+    auto firstQueue = this->queues[group[0]].get();
+    if (  true
+          && (group.size() == 1)
+          && this->isQueueOfScalarsSupported(par, firstQueue)
+       ){
+      oldToNewQueue[group[0]] = newIndex;
+      newQueues.push_back(std::move(this->queues[group[0]]));
+      continue ;
+    }
+    if (  true
+          && (group.size() == 1)
+          && (  false
+                || firstQueue->isMemoryDependence
+                || firstQueue->fromReplicatedStage
+                || firstQueue->toReplicatedStage
+             )
+       ){
+      errs() << "NOT SUPPORTED BYTE SIZE (" << firstQueue->bitLength << "): "; firstQueue->producer->getType()->print(errs()); errs() <<  "\n";
+      firstQueue->producer->print(errs() << "Producer: "); errs() << "\n";
+      abort();
+    }
+
+    /*
+     * Order the fields of the record as their producers appear in their basic block.
+     */
+    auto producerBB = firstQueue->producer->getParent();
+    std::unordered_map<Instruction *, uint64_t> positionInBB;
+    uint64_t position = 0;
+    for (auto &I : *producerBB) {
+      positionInBB[&I] = position++;
+    }
+    std::vector<Instruction *> producers;
+    std::set<Instruction *> consumers;
+    for (auto queueIndex : group) {
+      auto queueInfo = this->queues[queueIndex].get();
+      producers.push_back(queueInfo->producer);
+      consumers.insert(queueInfo->consumers.begin(), queueInfo->consumers.end());
+      oldToNewQueue[queueIndex] = newIndex;
+    }
+    std::sort(producers.begin(), producers.end(), [&positionInBB](Instruction *a, Instruction *b) -> bool {
+      return positionInBB[a] < positionInBB[b];
+    });
+
+    /*
+     * Create the queue of records.
+     */
+    std::vector<Type *> fieldTypes;
+    for (auto producer : producers) {
+      fieldTypes.push_back(producer->getType());
+    }
+    auto recordType = StructType::get(producerBB->getContext(), fieldTypes);
+    auto recordQueue = std::make_unique<QueueInfo>(producers, consumers, recordType);
+    recordQueue->fromStage = firstQueue->fromStage;
+    recordQueue->toStage = firstQueue->toStage;
+    newQueues.push_back(std::move(recordQueue));
+  }
+  this->queues = std::move(newQueues);
+
+  /*
+   * Remap the queues used by the stages.
+   */
+  auto remapQueues = [&oldToNewQueue](std::set<int> &queueIndices) -> void {
+    std::set<int> newIndices;
+    for (auto queueIndex : queueIndices) {
+      newIndices.insert(oldToNewQueue.at(queueIndex));
+    }
+    queueIndices = newIndices;
+  };
+  for (auto techniqueTask : this->tasks) {
+    auto task = (DSWPTask *)techniqueTask;
+    remapQueues(task->pushValueQueues);
+    remapQueues(task->popValueQueues);
+    for (auto &producerQueues : task->producerToQueues) {
+      remapQueues(producerQueues.second);
+    }
+    for (auto &producerQueue : task->producedPopQueue) {
+      producerQueue.second = oldToNewQueue.at(producerQueue.second);
+    }
+  }
+
+  return ;
+}
+
+bool DSWP::isQueueOfScalarsSupported (Noelle &par, QueueInfo *queueInfo) const {
+  if (queueInfo->isRecord){
+    return false;
+  }
+  auto &queueTypes = par.queues.queueSizeToIndex;
+
+  return queueTypes.find(queueInfo->bitLength) != queueTypes.end();
+}
+
 void DSWP::generateLoadsOfQueuePointers (
   Noelle &par,
   int taskIndex
@@ -299,9 +431,14 @@ void DSWP::generateLoadsOfQueuePointers (
       this->zeroIndexForBaseArray,
       queueIndexValue
     }));
-    auto parQueueIndex = par.queues.queueSizeToIndex[queueInfo->bitLength];
-    auto queueType = par.queues.queueTypes[parQueueIndex];
-    auto queueElemType = par.queues.queueElementTypes[parQueueIndex];
+    auto isPush = task->pushValueQueues.find(queueIndex) != task->pushValueQueues.end();
+    auto queueFunction = this->fetchQueueFunction(par, queueInfo, isPush);
+    auto queueType = queueFunction->arg_begin()->getType();
+    Type *queueElemType = par.int8;
+    if (!queueInfo->isRecord){
+      auto parQueueIndex = par.queues.queueSizeToIndex[queueInfo->bitLength];
+      queueElemType = par.queues.queueElementTypes[parQueueIndex];
+    }
     auto queueCast = entryBuilder.CreateBitCast(queuePtr, PointerType::getUnqual(queueType));
 
     auto queueInstrs = std::make_unique<QueueInstrs>();
@@ -336,14 +473,30 @@ void DSWP::popValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex)
     auto clonedB = task->getCloneOfOriginalBasicBlock(originalB);
     Instruction *insertionPoint = clonedB->getFirstNonPHIOrDbgOrLifetime();
     IRBuilder<> builder(insertionPoint);
-    auto queuePopFunction = par.queues.queuePops[par.queues.queueSizeToIndex[queueInfo->bitLength]];
+    auto queuePopFunction = this->fetchQueueFunction(par, queueInfo.get(), false);
     queueInstrs->queueCall = builder.CreateCall(queuePopFunction, queueCallArgs);
-    queueInstrs->load = builder.CreateLoad(queueInstrs->alloca);
+    if (!queueInfo->isRecord){
+      queueInstrs->load = builder.CreateLoad(queueInstrs->alloca);
+
+      /*
+       * Map from producer to queue load 
+       */
+      task->addInstruction(queueInfo->producer, cast<Instruction>(queueInstrs->load));
+      continue ;
+    }
 
     /*
-     * Map from producer to queue load 
+     * Unpack the record: each field is mapped to its producer.
      */
-    task->addInstruction(queueInfo->producer, cast<Instruction>(queueInstrs->load));
+    for (uint32_t fieldIndex = 0; fieldIndex < queueInfo->packedProducers.size(); ++fieldIndex) {
+      auto producer = queueInfo->packedProducers[fieldIndex];
+      auto fieldPtr = builder.CreateStructGEP(queueInfo->dependentType, queueInstrs->alloca, fieldIndex);
+      auto fieldLoad = builder.CreateLoad(fieldPtr);
+      if (fieldIndex == 0){
+        queueInstrs->load = fieldLoad;
+      }
+      task->addInstruction(producer, cast<Instruction>(fieldLoad));
+    }
   }
 }
 
@@ -355,22 +508,201 @@ void DSWP::pushValueQueues (LoopDependenceInfo *LDI, Noelle &par, int taskIndex)
     auto queueInstrs = task->queueInstrMap[queueIndex].get();
     auto queueInfo = this->queues[queueIndex].get();
     auto queueCallArgs = ArrayRef<Value*>({ queueInstrs->queuePtr, queueInstrs->allocaCast });
-    auto queuePushFunction = par.queues.queuePushes[par.queues.queueSizeToIndex[queueInfo->bitLength]];
+    auto queuePushFunction = this->fetchQueueFunction(par, queueInfo, true);
 
     /*
      * Store the produced value immediately
      * Push the value immediately
+     *
+     * For records, the push happens right after the last value of the record is produced.
      */
-    auto producerBlock = queueInfo->producer->getParent();
-    auto producerClone = task->getCloneOfOriginalInstruction(queueInfo->producer);
-    auto producerCloneBlock = producerClone->getParent();
-    auto insertPoint = producerClone->getNextNode();
+    auto lastProducer = queueInfo->packedProducers.back();
+    auto lastProducerClone = task->getCloneOfOriginalInstruction(lastProducer);
+    auto producerCloneBlock = lastProducerClone->getParent();
+    auto insertPoint = lastProducerClone->getNextNode();
     if (isa<PHINode>(insertPoint)) {
       insertPoint = producerCloneBlock->getFirstNonPHIOrDbgOrLifetime();
     }
     IRBuilder<> builder(insertPoint);
-    builder.CreateStore(producerClone, queueInstrs->alloca);
+    if (!queueInfo->isRecord){
+      builder.CreateStore(lastProducerClone, queueInstrs->alloca);
+    } else {
+      for (uint32_t fieldIndex = 0; fieldIndex < queueInfo->packedProducers.size(); ++fieldIndex) {
+        auto producerClone = task->getCloneOfOriginalInstruction(queueInfo->packedProducers[fieldIndex]);
+        auto fieldPtr = builder.CreateStructGEP(queueInfo->dependentType, queueInstrs->alloca, fieldIndex);
+        builder.CreateStore(producerClone, fieldPtr);
+      }
+    }
     queueInstrs->queueCall = builder.CreateCall(queuePushFunction, queueCallArgs);
 
   }
 }
+
+void DSWP::flushQueues (Noelle &par, int taskIndex) {
+  auto task = (DSWPTask *)this->tasks[taskIndex];
+
+  /*
+   * Fetch the point where the stage returns.
+   */
+  auto exitBB = task->getExit();
+  IRBuilder<> builder(exitBB->getTerminator());
+
+  /*
+   * Flush the queues the stage pushes to.
+   *
+   * Values of a batch that has not been completed are not visible to the consumer yet.
+   * Moreover, replicas of a consumer stage that do not execute the last iteration are still waiting for values: the last value pushed is pushed to them so they can observe the end of the loop.
+   */
+  for (auto queueIndex : task->pushValueQueues) {
+    auto queueInfo = this->queues[queueIndex].get();
+    auto isRoundRobin = queueInfo->toReplicatedStage && (!queueInfo->fromReplicatedStage);
+    if (  true
+          && (!isRoundRobin)
+          && (queueInfo->batchSize <= 1)
+       ){
+      continue ;
+    }
+    auto flushFunction = isRoundRobin ? par.queues.queueRoundRobinFlush : par.queues.queueFlush;
+    auto flushArgType = flushFunction->arg_begin()->getType();
+    auto queueInstrs = task->queueInstrMap[queueIndex].get();
+    auto queuePtr = builder.CreateBitCast(queueInstrs->queuePtr, flushArgType);
+    builder.CreateCall(flushFunction, ArrayRef<Value *>({ queuePtr }));
+  }
+
+  return ;
+}
+
+void DSWP::computeQueueCapacitiesAndBatchSizes (LoopDependenceInfo *LDI, Noelle &par) {
+
+  /*
+   * Capacity used when we have no information about the producer and consumer stages.
+   * The runtime further bounds capacities to let all queues fit in the cache shared by the stages.
+   */
+  auto defaultCapacity = DSWP::defaultQueueCapacity;
+  auto maximumCapacity = DSWP::maximumQueueCapacity;
+  auto capacityForImbalancedStages = DSWP::queueCapacityForImbalancedStages;
+  auto maximumBatchSize = DSWP::maximumQueueBatchSize;
+
+  /*
+   * Number of instructions a stage should execute between two synchronizations to amortize the transfer of a cache line between cores.
+   */
+  auto synchronizationCost = DSWP::queueSynchronizationCost;
+
+  /*
+   * Batching values can deadlock when a stage waits for a value produced by a stage it feeds.
+   */
+  auto canBatch = this->areQueuesAcyclical();
+
+  /*
+   * Fetch the profiles.
+   */
+  auto profiles = par.getProfiles();
+  auto loopStructure = LDI->getLoopStructure();
+  auto hasProfiles = true
+                     && profiles->isAvailable()
+                     && (profiles->getIterations(loopStructure) > 0);
+
+  for (auto &queue : this->queues) {
+    queue->capacity = defaultCapacity;
+    queue->batchSize = 1;
+    if (!hasProfiles){
+      continue ;
+    }
+
+    /*
+     * The queue never holds more elements than the iterations of a loop invocation.
+     */
+    auto iterations = profiles->getAverageLoopIterationsPerInvocation(loopStructure);
+    auto capacity = (uint64_t)PowerOf2Ceil((uint64_t)iterations + 1);
+    capacity = std::min(capacity, maximumCapacity);
+
+    /*
+     * When the rates of the two stages differ significantly, the queue is either always full or always empty.
+     * Additional slots would only increase the memory footprint of the queue.
+     */
+    auto fromStage = (DSWPTask *)this->tasks[queue->fromStage];
+    auto toStage = (DSWPTask *)this->tasks[queue->toStage];
+    auto producerInsts = this->computeAverageInstructionsPerIteration(LDI, par, fromStage);
+    auto consumerInsts = this->computeAverageInstructionsPerIteration(LDI, par, toStage);
+    auto slowest = std::max(producerInsts, consumerInsts);
+    auto fastest = std::max(std::min(producerInsts, consumerInsts), 1.0);
+    if ((slowest / fastest) > 2){
+      capacity = std::min(capacity, capacityForImbalancedStages);
+    }
+
+    /*
+     * Batch the values pushed by producers that execute few instructions per iteration.
+     */
+    uint64_t batchSize = 1;
+    if (  true
+          && canBatch
+          && (producerInsts > 0)
+          && (producerInsts < synchronizationCost)
+       ){
+      batchSize = (uint64_t)(synchronizationCost / producerInsts);
+      batchSize = std::min(batchSize, maximumBatchSize);
+      batchSize = std::min(batchSize, capacity / 4);
+      batchSize = std::max(batchSize, (uint64_t)1);
+    }
+
+    queue->capacity = std::max(capacity, (uint64_t)2);
+    queue->batchSize = batchSize;
+  }
+
+  return ;
+}
+
+double DSWP::computeAverageInstructionsPerIteration (LoopDependenceInfo *LDI, Noelle &par, DSWPTask *task) const {
+  auto profiles = par.getProfiles();
+  auto iterations = profiles->getIterations(LDI->getLoopStructure());
+  if (iterations == 0){
+    return 0;
+  }
+
+  /*
+   * Sum the instructions executed by the SCCs of the stage, including the ones it clones.
+   */
+  uint64_t insts = 0;
+  for (auto scc : task->stageSCCs) {
+    insts += profiles->getTotalInstructions(scc);
+  }
+  for (auto scc : task->clonableSCCs) {
+    insts += profiles->getTotalInstructions(scc);
+  }
+
+  return ((double)insts) / ((double)iterations);
+}
+
+Function * DSWP::fetchQueueFunction (Noelle &par, QueueInfo *queueInfo, bool isPush) const {
+
+  /*
+   * Records are copied in and out of their queue.
+   * Queues of records never connect a replicated stage.
+   */
+  if (queueInfo->isRecord){
+    return isPush ? par.queues.queueRecordPush : par.queues.queueRecordPop;
+  }
+  auto parQueueIndex = par.queues.queueSizeToIndex[queueInfo->bitLength];
+
+  /*
+   * The stage that is not replicated distributes (or collects) values across the replicas of the other end round-robin.
+   * Replicas, instead, see only their own queue.
+   */
+  if (isPush){
+    if (  true
+          && queueInfo->toReplicatedStage
+          && (!queueInfo->fromReplicatedStage)
+       ){
+      return par.queues.queueRoundRobinPushes[parQueueIndex];
+    }
+    return par.queues.queuePushes[parQueueIndex];
+  }
+  if (  true
+        && queueInfo->fromReplicatedStage
+        && (!queueInfo->toReplicatedStage)
+     ){
+    return par.queues.queueRoundRobinPops[parQueueIndex];
+  }
+
+  return par.queues.queuePops[parQueueIndex];
+}
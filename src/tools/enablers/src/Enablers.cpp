@@ -20,7 +20,8 @@ bool EnablersManager::applyEnablers (
     LoopUnroll &loopUnroll,
     LoopWhilifier &loopWhilifier,
     LoopInvariantCodeMotion &loopInvariantCodeMotion,
-    SCEVSimplification &scevSimplification
+    SCEVSimplification &scevSimplification,
+    LoopVersioner &loopVersioner
     ){
 
   /*
@@ -51,6 +52,11 @@ bool EnablersManager::applyEnablers (
       errs() << "EnablersManager:     Some calls have been devirtualized\n";
       return true;
     }
+    errs() << "EnablersManager:   Try to speculatively devirtualize indirect calls\n";
+    if (this->applySpeculativeDevirtualizer(LDI, par)){
+      errs() << "EnablersManager:     Some calls have been speculatively devirtualized\n";
+      return true;
+    }
   }
 
   /*
@@ -94,6 +100,17 @@ bool EnablersManager::applyEnablers (
     }
     }
 
+    /*
+     * Version the loop to check at runtime the memory dependences that block DOALL.
+     */
+    if (par.isTransformationEnabled(Transformation::LOOP_VERSIONING_ID)){
+      errs() << "EnablersManager:   Try to version the loop with runtime alias checks\n";
+      if (this->applyLoopVersioning(LDI, par, loopVersioner)){
+        errs() << "EnablersManager:     The loop has been versioned\n";
+        return true;
+      }
+    }
+
     return false;
   }
 
@@ -128,12 +145,158 @@ bool EnablersManager::applyEnablers (
     return modified;
   }
 
+  bool EnablersManager::applyLoopFusion (
+      std::vector<LoopDependenceInfo *> const &functionLoops,
+      Noelle &par,
+      LoopFusion &loopFusion
+      ){
+
+    /*
+     * Fusion is meant to reduce the number of parallel loops to dispatch.
+     * Hence, it is only useful if DOALL can parallelize the fused loop.
+     */
+    if (!par.isTransformationEnabled(Transformation::DOALL_ID)){
+      return false;
+    }
+
+    /*
+     * We fuse loops only if we know they are executed.
+     */
+    auto profiles = par.getProfiles();
+    if (!profiles->isAvailable()){
+      return false;
+    }
+    if (functionLoops.size() < 2){
+      return false;
+    }
+
+    /*
+     * Fetch the dependence graph of the function.
+     */
+    auto f = functionLoops[0]->getLoopStructure()->getFunction();
+    auto fPDG = par.getFunctionDependenceGraph(f);
+
+    /*
+     * Identify the executed loops that DOALL can parallelize.
+     * The fusion only allows dependences between the two loops that are within the same iteration, so fusing two DOALL loops generates a DOALL loop.
+     */
+    std::unordered_set<LoopDependenceInfo *> candidates;
+    for (auto LDI : functionLoops){
+      auto ls = LDI->getLoopStructure();
+      if (  false
+            || (profiles->getTotalInstructions(ls) == 0)
+            || (DOALL::getSCCsThatBlockDOALLToBeApplicable(LDI, par).size() > 0)
+         ){
+        continue ;
+      }
+      candidates.insert(LDI);
+    }
+    if (candidates.size() < 2){
+      return false;
+    }
+
+    /*
+     * Estimate the time spent in a loop that is parallelized only if this pays off its dispatch at every invocation.
+     */
+    auto estimateTime = [this](double loopTime, double invocations, uint32_t cores) -> double {
+      auto parallelTime = (loopTime / ((double)cores)) + (invocations * this->parallelLoopInvocationCost);
+      return std::min(loopTime, parallelTime);
+    };
+
+    /*
+     * Look for adjacent loops that can be fused.
+     */
+    for (auto firstLDI : functionLoops){
+      if (candidates.find(firstLDI) == candidates.end()){
+        continue ;
+      }
+      for (auto secondLDI : functionLoops){
+        if (candidates.find(secondLDI) == candidates.end()){
+          continue ;
+        }
+        if (!loopFusion.canFuseLoops(*firstLDI, *secondLDI, fPDG)){
+          continue ;
+        }
+
+        /*
+         * Check the profiles.
+         * The fused loop dispatches its iterations once per invocation instead of twice, which can also make parallelizing loops that are too small on their own pay off.
+         */
+        auto firstLS = firstLDI->getLoopStructure();
+        auto secondLS = secondLDI->getLoopStructure();
+        auto firstTime = (double)profiles->getTotalInstructions(firstLS);
+        auto secondTime = (double)profiles->getTotalInstructions(secondLS);
+        auto invocations = (double)profiles->getInvocations(firstLS);
+        auto cores = std::min(firstLDI->getMaximumNumberOfCores(), secondLDI->getMaximumNumberOfCores());
+        auto separateTime = estimateTime(firstTime, invocations, cores) + estimateTime(secondTime, invocations, cores);
+        auto fusedTime = estimateTime(firstTime + secondTime, invocations, cores);
+        errs() << "EnablersManager:     Fusion: loops " << firstLDI->getID() << " and " << secondLDI->getID() << ", estimated time of the separate loops = " << separateTime << ", estimated time of the fused loop = " << fusedTime << "\n";
+        if (fusedTime >= separateTime){
+          continue ;
+        }
+
+        /*
+         * Fuse the loops.
+         */
+        std::set<Instruction *> instsRemoved;
+        if (loopFusion.fuseLoops(*firstLDI, *secondLDI, fPDG, instsRemoved)){
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  bool EnablersManager::applyLoopVersioning (
+      LoopDependenceInfo *LDI,
+      Noelle &par,
+      LoopVersioner &loopVersioner
+      ){
+    assert(LDI != nullptr);
+
+    /*
+     * Check if DOALL is enabled.
+     */
+    if (!par.isTransformationEnabled(Transformation::DOALL_ID)){
+      return false;
+    }
+
+    /*
+     * Fetch the SCCs that block DOALL.
+     * If there is none, then the loop does not need to be versioned.
+     */
+    auto SCCsToRemove = DOALL::getSCCsThatBlockDOALLToBeApplicable(LDI, par);
+    if (SCCsToRemove.size() == 0){
+      return false;
+    }
+
+    /*
+     * Version the loop.
+     */
+    auto &loopFunction = *LDI->getLoopStructure()->getFunction();
+    auto& LI = getAnalysis<LoopInfoWrapperPass>(loopFunction).getLoopInfo();
+    auto& DT = getAnalysis<DominatorTreeWrapperPass>(loopFunction).getDomTree();
+    auto& SE = getAnalysis<ScalarEvolutionWrapperPass>(loopFunction).getSE();
+    auto modified = loopVersioner.versionLoopToRemoveMemoryDependences(*LDI, SCCsToRemove, LI, DT, SE);
+
+    return modified;
+  }
+
   bool EnablersManager::applyLoopDistribution (
       LoopDependenceInfo *LDI,
       Noelle &par,
       LoopDistribution &loopDist
       ){
 
+    /*
+     * Use the profiles, if available, to decide whether distributing the loop pays off.
+     */
+    auto profiles = par.getProfiles();
+    if (profiles->isAvailable()){
+      return this->applyProfileGuidedLoopDistribution(LDI, par, loopDist);
+    }
+
     /*
      * Fetch the SCC manager.
      */
@@ -206,6 +369,91 @@ bool EnablersManager::applyEnablers (
     return false;
   }
 
+  bool EnablersManager::applyProfileGuidedLoopDistribution (
+      LoopDependenceInfo *LDI,
+      Noelle &par,
+      LoopDistribution &loopDist
+      ){
+
+    /*
+     * Distribution is meant to isolate the SCCs that block DOALL.
+     */
+    if (!par.isTransformationEnabled(Transformation::DOALL_ID)){
+      return false;
+    }
+    auto SCCsToPullOut = DOALL::getSCCsThatBlockDOALLToBeApplicable(LDI, par);
+    if (SCCsToPullOut.size() == 0){
+      return false;
+    }
+
+    /*
+     * Fetch the time spent in the loop.
+     */
+    auto profiles = par.getProfiles();
+    auto ls = LDI->getLoopStructure();
+    auto loopTime = profiles->getTotalInstructions(ls);
+    if (loopTime == 0){
+      return false;
+    }
+
+    /*
+     * Fetch the instructions that both loops would execute after the split (e.g., the control flow).
+     * These are recomputed in both loops rather than stored in temporaries.
+     */
+    std::set<SCC *> SCCs(SCCsToPullOut.begin(), SCCsToPullOut.end());
+    std::set<Instruction *> instsToClone;
+    if (!loopDist.collectInstructionsToClone(*LDI, SCCs, instsToClone)){
+      return false;
+    }
+    uint64_t replicatedTime = 0;
+    for (auto inst : instsToClone){
+      replicatedTime += profiles->getTotalInstructions(inst);
+    }
+
+    /*
+     * Compute the time spent in the SCCs that would run in the sequential loop.
+     */
+    uint64_t sequentialTime = 0;
+    for (auto scc : SCCs){
+      for (auto node : scc->getNodes()){
+        auto inst = dyn_cast<Instruction>(node->getT());
+        if (  false
+              || (inst == nullptr)
+              || (instsToClone.find(inst) != instsToClone.end())
+           ){
+          continue ;
+        }
+        sequentialTime += profiles->getTotalInstructions(inst);
+      }
+    }
+    if (sequentialTime + replicatedTime >= loopTime){
+      return false;
+    }
+
+    /*
+     * Estimate the gain of parallelizing the rest of the loop.
+     * The cost of the split is the extra execution of the replicated instructions and the dispatch of the parallel loop at every invocation.
+     */
+    auto cores = LDI->getMaximumNumberOfCores();
+    auto parallelTime = (double)(loopTime - sequentialTime - replicatedTime);
+    auto gain = parallelTime - (parallelTime / ((double)cores));
+    auto cost = ((double)replicatedTime) + ((double)profiles->getInvocations(ls)) * this->parallelLoopInvocationCost;
+    errs() << "EnablersManager:     Distribution: loop time = " << loopTime << ", sequential SCCs time = " << sequentialTime << ", replicated time = " << replicatedTime << "\n";
+    errs() << "EnablersManager:     Distribution: estimated gain = " << gain << ", estimated cost = " << cost << "\n";
+    if (gain <= cost){
+      return false;
+    }
+
+    /*
+     * Bring the sequential SCCs outside the loop.
+     */
+    std::set<Instruction *> instsRemoved;
+    std::set<Instruction *> instsAdded;
+    auto splitted = loopDist.splitLoop(*LDI, SCCs, instsRemoved, instsAdded);
+
+    return splitted;
+  }
+
   bool EnablersManager::applyDevirtualizer (
       LoopDependenceInfo *LDI,
       Noelle &par,
@@ -305,6 +553,126 @@ bool EnablersManager::applyEnablers (
     auto& SE = getAnalysis<ScalarEvolutionWrapperPass>(loopFunction).getSE();
     auto& AC = getAnalysis<AssumptionCacheTracker>().getAssumptionCache(loopFunction);
     auto modified = loopUnroll.fullyUnrollLoop(*LDI, LS, DT, SE, AC);
+    if (modified){
+      this->calleesChanged = true;
+    }
+
+    return modified;
+  }
+
+  bool EnablersManager::applySpeculativeDevirtualizer (
+      LoopDependenceInfo *LDI,
+      Noelle &par
+      ){
+
+    /*
+     * Indirect calls are dependent on every memory instruction of the loop because their callees are unknown.
+     * If the profiles show that few callees are invoked by an indirect call, then we can invoke them directly.
+     * For example:
+     *    (*functionPtr)(...)
+     * becomes
+     *    if (functionPtr == f1) f1(...)
+     *    else (*functionPtr)(...)
+     * The dependences of the direct calls are then computed by using what we know about their callees.
+     */
+    auto profiles = par.getProfiles();
+    if (!profiles->isAvailable()){
+      return false;
+    }
+    auto ls = LDI->getLoopStructure();
+    if (profiles->getInvocations(ls) == 0){
+      return false;
+    }
+
+    /*
+     * Collect the indirect calls of the loop that have been executed.
+     */
+    std::vector<CallInst *> indirectCalls;
+    for (auto inst : ls->instructions()){
+      auto callInst = dyn_cast<CallInst>(inst);
+      if (  false
+            || (callInst == nullptr)
+            || (callInst->getCalledFunction() != nullptr)
+            || (callInst->isInlineAsm())
+            || (profiles->getIndirectCallTargets(callInst).size() == 0)
+         ){
+        continue ;
+      }
+      indirectCalls.push_back(callInst);
+    }
+
+    /*
+     * Invoke the dominant callees directly.
+     */
+    auto modified = false;
+    for (auto callInst : indirectCalls){
+      auto targets = profiles->getIndirectCallTargets(callInst);
+      uint64_t targetsCount = 0;
+      for (auto &target : targets){
+        targetsCount += target.second;
+      }
+      auto remainingCount = std::max(profiles->getInvocations(callInst), targetsCount);
+
+      /*
+       * Targets are sorted from the most invoked one.
+       * Hence, once a target isn't dominant among the invocations that are not covered by the direct calls already generated, neither are the following ones.
+       * Targets that are not promoted stay with the fallback indirect call.
+       */
+      std::vector<std::pair<Function *, uint64_t>> remainingTargets;
+      auto promoted = false;
+      for (auto targetIt = targets.begin(); targetIt != targets.end(); targetIt++){
+        auto callee = targetIt->first;
+        auto count = targetIt->second;
+        if ((count * 100) < (remainingCount * this->dominantIndirectCallTargetPercentage)){
+          remainingTargets.insert(remainingTargets.end(), targetIt, targets.end());
+          break ;
+        }
+        if (!isLegalToPromote(CallSite(callInst), callee)){
+          remainingTargets.push_back(*targetIt);
+          continue ;
+        }
+        errs() << "EnablersManager:     Call " << callee->getName() << " directly (" << count << " out of " << remainingCount << " invocations)\n";
+
+        /*
+         * Branch weights are 32 bits.
+         */
+        auto scale = (remainingCount / std::numeric_limits<uint32_t>::max()) + 1;
+        MDBuilder mdBuilder(callInst->getContext());
+        auto branchWeights = mdBuilder.createBranchWeights(count / scale, (remainingCount - count) / scale);
+
+        /*
+         * Invoke the callee directly.
+         * The indirect call is kept as fallback.
+         */
+        auto blockCount = profiles->getInvocations(callInst->getParent());
+        auto directCall = promoteCallWithIfThenElse(CallSite(callInst), callee, branchWeights);
+        directCall->setMetadata(LLVMContext::MD_prof, nullptr);
+
+        /*
+         * Set the invocations of the new basic blocks.
+         * The block of the direct call runs for the invocations of the callee, the block of the fallback runs for the other ones, and the code after the call runs as many times as the original call did.
+         */
+        auto directCallBB = directCall->getParent();
+        profiles->setBasicBlockInvocations(directCallBB, count);
+        profiles->setBasicBlockInvocations(callInst->getParent(), (blockCount > count) ? (blockCount - count) : 0);
+        profiles->setBasicBlockInvocations(directCallBB->getSingleSuccessor(), blockCount);
+        remainingCount -= count;
+        promoted = true;
+      }
+
+      /*
+       * Drop the promoted targets from the fallback so its callees are not promoted again.
+       * This holds both for the profiles embedded in the IR and for the ones loaded in memory, which the next invocations of this enabler will query.
+       */
+      if (promoted){
+        callInst->setMetadata(LLVMContext::MD_prof, nullptr);
+        profiles->setIndirectCallTargets(callInst, remainingTargets);
+        modified = true;
+      }
+    }
+    if (modified){
+      this->calleesChanged = true;
+    }
 
     return modified;
   }
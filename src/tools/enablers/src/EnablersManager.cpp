@@ -43,10 +43,12 @@ bool EnablersManager::runOnModule (Module &M) {
    * Create the enablers.
    */
   auto loopDist = LoopDistribution();
+  auto loopFusion = LoopFusion();
   auto loopUnroll = LoopUnroll();
   auto loopWhilify = LoopWhilifier(noelle);
   auto loopInvariantCodeMotion = LoopInvariantCodeMotion(noelle);
   auto scevSimplification = SCEVSimplification(noelle);
+  auto loopVersioner = LoopVersioner(noelle);
 
   /*
    * Fetch all the loops we want to parallelize.
@@ -55,10 +57,49 @@ bool EnablersManager::runOnModule (Module &M) {
   errs() << "EnablersManager:  Try to improve all " << loopsToParallelize->size() << " loops, one at a time\n";
 
   /*
-   * Parallelize the loops selected.
+   * Check if the enablers need to run until a fixed point is reached within this invocation.
+   */
+  if (this->inProcessFixedPoint){
+    auto modified = this->applyEnablersUntilFixedPoint(
+        *loopsToParallelize,
+        noelle,
+        loopDist,
+        loopFusion,
+        loopUnroll,
+        loopWhilify,
+        loopInvariantCodeMotion,
+        scevSimplification,
+        loopVersioner
+        );
+    delete loopsToParallelize;
+
+    errs() << "EnablersManager: Exit\n";
+    return modified;
+  }
+
+  /*
+   * Fuse adjacent loops of the same function.
    */
   auto modified = false;
   std::unordered_map<Function *, bool> modifiedFunctions;
+  if (noelle.isTransformationEnabled(Transformation::LOOP_FUSION_ID)){
+    std::unordered_map<Function *, std::vector<LoopDependenceInfo *>> functionLoops;
+    for (auto loop : *loopsToParallelize){
+      functionLoops[loop->getLoopStructure()->getFunction()].push_back(loop);
+    }
+    for (auto &pair : functionLoops){
+      errs() << "EnablersManager:   Try to fuse the loops of the function " << pair.first->getName() << "\n";
+      if (this->applyLoopFusion(pair.second, noelle, loopFusion)){
+        errs() << "EnablersManager:     Loops have been fused\n";
+        modifiedFunctions[pair.first] = true;
+        modified = true;
+      }
+    }
+  }
+
+  /*
+   * Parallelize the loops selected.
+   */
   for (auto loopToImprove : *loopsToParallelize){
 
     /*
@@ -85,7 +126,8 @@ bool EnablersManager::runOnModule (Module &M) {
         loopUnroll,
         loopWhilify,
         loopInvariantCodeMotion,
-        scevSimplification
+        scevSimplification,
+        loopVersioner
         );
     modified |= modifiedFunctions[f];
   }
@@ -98,3 +140,171 @@ bool EnablersManager::runOnModule (Module &M) {
   errs() << "EnablersManager: Exit\n";
   return modified;
 }
+
+bool EnablersManager::applyEnablersUntilFixedPoint (
+  std::vector<LoopDependenceInfo *> const &loops,
+  Noelle &noelle,
+  LoopDistribution &loopDist,
+  LoopFusion &loopFusion,
+  LoopUnroll &loopUnroll,
+  LoopWhilifier &loopWhilify,
+  LoopInvariantCodeMotion &loopInvariantCodeMotion,
+  SCEVSimplification &scevSimplification,
+  LoopVersioner &loopVersioner
+  ){
+
+  /*
+   * Group the loops per function.
+   * The worklist keeps the order in which the functions have been given.
+   */
+  std::deque<Function *> worklist;
+  std::unordered_map<Function *, std::vector<LoopDependenceInfo *>> functionLoops;
+  for (auto loop : loops){
+    auto f = loop->getLoopStructure()->getFunction();
+    if (functionLoops.find(f) == functionLoops.end()){
+      worklist.push_back(f);
+    }
+    functionLoops[f].push_back(loop);
+  }
+
+  /*
+   * Apply the enablers until none of them modifies the code.
+   */
+  auto modified = false;
+  std::unordered_map<Function *, uint32_t> functionModifications;
+  while (worklist.size() > 0){
+    auto f = worklist.front();
+    worklist.pop_front();
+    this->calleesChanged = false;
+
+    /*
+     * Try to improve the loops of the function, one at a time.
+     * Stop at the first modification because it invalidates the abstractions of all loops of the function.
+     */
+    auto &currentLoops = functionLoops[f];
+    auto changed = false;
+    if (noelle.isTransformationEnabled(Transformation::LOOP_FUSION_ID)){
+      changed = this->applyLoopFusion(currentLoops, noelle, loopFusion);
+    }
+    for (auto loopToImprove : currentLoops){
+      if (changed){
+        break ;
+      }
+      if (this->applyEnablers(
+            loopToImprove,
+            noelle,
+            loopDist,
+            loopUnroll,
+            loopWhilify,
+            loopInvariantCodeMotion,
+            scevSimplification,
+            loopVersioner
+            )){
+        changed = true;
+        break ;
+      }
+    }
+    if (!changed){
+
+      /*
+       * The function reached its fixed point.
+       */
+      continue ;
+    }
+    modified = true;
+
+    /*
+     * Invalidate the abstractions of the modified function.
+     */
+    for (auto loop : currentLoops){
+      delete loop;
+    }
+    currentLoops.clear();
+    noelle.invalidateFunctionDependenceGraph(f);
+    noelle.invalidateLoopNestingForest(f);
+
+    /*
+     * Enablers that change the callees of the function (e.g., devirtualization) change what is known about the memory accessed by its invocations.
+     * Hence, the dependences of the functions that (transitively) invoke it are invalidated as well, and their loops are analyzed again.
+     * The other enablers only restructure the code of the function, so the abstractions of the other functions are still valid.
+     */
+    if (this->calleesChanged){
+      std::unordered_set<Function *> callers;
+      std::queue<Function *> calleesToCheck;
+      calleesToCheck.push(f);
+      while (!calleesToCheck.empty()){
+        auto callee = calleesToCheck.front();
+        calleesToCheck.pop();
+        for (auto user : callee->users()){
+          auto callInst = dyn_cast<CallBase>(user);
+          if (  false
+                || (callInst == nullptr)
+                || (callInst->getCalledFunction() != callee)
+             ){
+            continue ;
+          }
+          auto caller = callInst->getFunction();
+          if (  false
+                || (caller == f)
+                || (callers.find(caller) != callers.end())
+             ){
+            continue ;
+          }
+          callers.insert(caller);
+          calleesToCheck.push(caller);
+        }
+      }
+      for (auto caller : callers){
+        noelle.invalidateFunctionDependenceGraph(caller);
+        if (functionLoops.find(caller) == functionLoops.end()){
+          continue ;
+        }
+        auto &callerLoops = functionLoops[caller];
+        for (auto loop : callerLoops){
+          delete loop;
+        }
+        callerLoops.clear();
+        auto newCallerLoops = noelle.getLoops(caller);
+        if (newCallerLoops != nullptr){
+          callerLoops = *newCallerLoops;
+          delete newCallerLoops;
+        }
+        if (std::find(worklist.begin(), worklist.end(), caller) == worklist.end()){
+          worklist.push_back(caller);
+        }
+      }
+    }
+
+    /*
+     * Check if the enablers keep modifying the function.
+     */
+    functionModifications[f]++;
+    if (functionModifications[f] >= this->maximumFixedPointIterations){
+      errs() << "EnablersManager:   The function " << f->getName() << " did not reach a fixed point after " << functionModifications[f] << " modifications\n";
+      continue ;
+    }
+
+    /*
+     * Compute the loops of the modified function and try to improve them again.
+     */
+    auto newLoops = noelle.getLoops(f);
+    if (newLoops == nullptr){
+      continue ;
+    }
+    currentLoops = *newLoops;
+    delete newLoops;
+    worklist.push_back(f);
+  }
+  errs() << "EnablersManager:  The fixed point has been reached after modifying " << functionModifications.size() << " functions\n";
+
+  /*
+   * Free the memory.
+   */
+  for (auto &functionAndLoops : functionLoops){
+    for (auto loop : functionAndLoops.second){
+      delete loop;
+    }
+  }
+
+  return modified;
+}
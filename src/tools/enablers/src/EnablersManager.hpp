@@ -11,6 +11,9 @@
 #pragma once
 
 #include "SystemHeaders.hpp"
+#include "llvm/IR/CallSite.h"
+#include "llvm/IR/MDBuilder.h"
+#include "llvm/Transforms/Utils/CallPromotionUtils.h"
 
 #include "LoopDependenceInfo.hpp"
 #include "PDG.hpp"
@@ -19,10 +22,13 @@
 #include "PDGAnalysis.hpp"
 #include "Noelle.hpp"
 #include "LoopDistribution.hpp"
+#include "LoopFusion.hpp"
 #include "LoopUnroll.hpp"
 #include "LoopWhilify.hpp"
 #include "LoopInvariantCodeMotion.hpp"
 #include "SCEVSimplification.hpp"
+#include "LoopVersioner.hpp"
+#include "DOALL.hpp"
 
 namespace llvm::noelle {
 
@@ -48,6 +54,15 @@ namespace llvm::noelle {
        * Fields
        */
       bool enableEnablers;
+      bool inProcessFixedPoint;
+      uint32_t maximumFixedPointIterations;
+      double parallelLoopInvocationCost;
+      uint32_t dominantIndirectCallTargetPercentage;
+
+      /*
+       * Whether the last enabler applied changed the callees of the modified function (e.g., devirtualization).
+       */
+      bool calleesChanged;
 
       /*
        * Methods
@@ -57,6 +72,18 @@ namespace llvm::noelle {
           Noelle &par
         );
 
+      bool applyEnablersUntilFixedPoint (
+        std::vector<LoopDependenceInfo *> const &loops,
+        Noelle &par,
+        LoopDistribution &loopDist,
+        LoopFusion &loopFusion,
+        LoopUnroll &loopUnroll,
+        LoopWhilifier &LoopWhilifier,
+        LoopInvariantCodeMotion &loopInvariantCodeMotion,
+        SCEVSimplification &scevSimplification,
+        LoopVersioner &loopVersioner
+        );
+
       bool applyEnablers (
         LoopDependenceInfo *LDI,
         Noelle &par,
@@ -64,7 +91,8 @@ namespace llvm::noelle {
         LoopUnroll &loopUnroll,
         LoopWhilifier &LoopWhilifier,
         LoopInvariantCodeMotion &loopInvariantCodeMotion,
-        SCEVSimplification &scevSimplification
+        SCEVSimplification &scevSimplification,
+        LoopVersioner &loopVersioner
         );
 
       bool applyLoopWhilifier (
@@ -79,11 +107,34 @@ namespace llvm::noelle {
           LoopDistribution &loopDist
         );
 
+      bool applyProfileGuidedLoopDistribution (
+          LoopDependenceInfo *LDI,
+          Noelle &par,
+          LoopDistribution &loopDist
+        );
+
+      bool applyLoopFusion (
+          std::vector<LoopDependenceInfo *> const &functionLoops,
+          Noelle &par,
+          LoopFusion &loopFusion
+        );
+
+      bool applyLoopVersioning (
+          LoopDependenceInfo *LDI,
+          Noelle &par,
+          LoopVersioner &loopVersioner
+        );
+
       bool applyDevirtualizer (
         LoopDependenceInfo *LDI,
         Noelle &par,
         LoopUnroll &loopUnroll
         );
+
+      bool applySpeculativeDevirtualizer (
+        LoopDependenceInfo *LDI,
+        Noelle &par
+        );
   };
 
 }
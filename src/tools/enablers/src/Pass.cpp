@@ -18,9 +18,18 @@ using namespace llvm;
 using namespace llvm::noelle;
 
 static cl::opt<bool> DisableEnablers("noelle-disable-enablers", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable all enablers"));
+static cl::opt<bool> InProcessFixedPoint("noelle-enablers-fixed-point", cl::ZeroOrMore, cl::Hidden, cl::desc("Apply the enablers until a fixed point is reached within this invocation"));
+static cl::opt<int> ParallelLoopInvocationCost("noelle-enablers-parallel-loop-invocation-cost", cl::ZeroOrMore, cl::Hidden, cl::init(10000), cl::desc("Estimated number of instructions spent to dispatch and join a parallelized loop"));
+static cl::opt<int> DominantIndirectCallTargetPercentage("noelle-enablers-dominant-indirect-call-target", cl::ZeroOrMore, cl::Hidden, cl::init(30), cl::desc("Minimum percentage of the invocations of an indirect call that a callee must receive to be called directly"));
+static cl::opt<int> MaximumFixedPointIterations("noelle-enablers-fixed-point-max-iterations", cl::ZeroOrMore, cl::Hidden, cl::init(100), cl::desc("Maximum number of times the enablers can modify a function when they run until a fixed point"));
 
 bool EnablersManager::doInitialization (Module &M) {
   this->enableEnablers = (DisableEnablers.getNumOccurrences() == 0) ? true : false;
+  this->inProcessFixedPoint = (InProcessFixedPoint.getNumOccurrences() > 0) ? true : false;
+  this->maximumFixedPointIterations = MaximumFixedPointIterations.getValue();
+  this->parallelLoopInvocationCost = ParallelLoopInvocationCost.getValue();
+  this->dominantIndirectCallTargetPercentage = DominantIndirectCallTargetPercentage.getValue();
+  this->calleesChanged = false;
 
   return false; 
 }
@@ -59,6 +59,12 @@ namespace llvm::noelle {
 
       Function * getTaskFunction (void) const ;
 
+      /*
+       * Lower the number of cores the parallelized loop asks the runtime for.
+       * The number of cores cannot grow as the environment has been allocated for the cores the loop has been parallelized for.
+       */
+      void limitNumberOfCores (Noelle &par, uint32_t cores);
+
       void reset () override ;
 
     protected:
@@ -161,12 +167,7 @@ namespace llvm::noelle {
       bool enableInliner;
       Function *taskDispatcherSS;
       Function *taskDispatcherCS;
-
-      void squeezeSequentialSegment (
-        LoopDependenceInfo *LDI,
-        DataFlowResult *reachabilityDFR,
-        SequentialSegment *ss
-      );
+      CallInst *dispatcherCall;
 
       DataFlowResult *computeReachabilityFromInstructions (LoopDependenceInfo *LDI) ;
 
@@ -23,7 +23,8 @@ HELIX::HELIX (
     loopCarriedEnvBuilder{nullptr}, 
     taskFunctionDG{nullptr},
     lastIterationExecutionBlock{nullptr},
-    enableInliner{true}
+    enableInliner{true},
+    dispatcherCall{nullptr}
   {
 
   /*
@@ -87,6 +88,7 @@ void HELIX::reset () {
     lastIterationExecutionBlock = nullptr;
   }
   lastIterationExecutionDuplicateMap.clear();
+  dispatcherCall = nullptr;
 
 }
 
@@ -249,8 +251,8 @@ void HELIX::createParallelizableTask (
   /*
    * Fetch the indices of live-in and live-out variables of the loop being parallelized.
    */
-  auto liveInVars = LDI->environment->getEnvIndicesOfLiveInVars();
-  auto liveOutVars = LDI->environment->getEnvIndicesOfLiveOutVars();
+  auto liveInVars = LDI->getEnvironment()->getEnvIndicesOfLiveInVars();
+  auto liveOutVars = LDI->getEnvironment()->getEnvIndicesOfLiveOutVars();
 
   /*
    * Add all live-in and live-out variables as variables to be included in the environment.
@@ -258,7 +260,7 @@ void HELIX::createParallelizableTask (
   std::set<int> nonReducableVars(liveInVars.begin(), liveInVars.end());
   std::set<int> reducableVars{};
   for (auto liveOutIndex : liveOutVars) {
-    auto producer = LDI->environment->producerAt(liveOutIndex);
+    auto producer = LDI->getEnvironment()->producerAt(liveOutIndex);
     auto scc = sccManager->getSCCDAG()->sccOfValue(producer);
     auto sccInfo = sccManager->getSCCAttrs(scc);
     if (sccInfo->getType() == SCCAttrs::SCCType::REDUCIBLE) {
@@ -273,7 +275,7 @@ void HELIX::createParallelizableTask (
    * This location exists only if there is more than one loop exit.
    */
   if (loopStructure->numberOfExitBasicBlocks() > 1){ 
-    nonReducableVars.insert(LDI->environment->indexOfExitBlockTaken());
+    nonReducableVars.insert(LDI->getEnvironment()->indexOfExitBlockTaken());
   }
 
   /*
@@ -294,10 +296,10 @@ void HELIX::createParallelizableTask (
    * Store final results to loop live-out variables.
    */
   auto envUser = this->envBuilder->getUser(0);
-  for (auto envIndex : LDI->environment->getEnvIndicesOfLiveInVars()) {
+  for (auto envIndex : LDI->getEnvironment()->getEnvIndicesOfLiveInVars()) {
     envUser->addLiveInIndex(envIndex);
   }
-  for (auto envIndex : LDI->environment->getEnvIndicesOfLiveOutVars()) {
+  for (auto envIndex : LDI->getEnvironment()->getEnvIndicesOfLiveOutVars()) {
     envUser->addLiveOutIndex(envIndex);
   }
   this->generateCodeToLoadLiveInVariables(LDI, 0);
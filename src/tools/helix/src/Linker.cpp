@@ -65,6 +65,7 @@ void HELIX::addChunkFunctionExecutionAsideOriginalLoop (
     numCores,
     numOfSS
   }));
+  this->dispatcherCall = runtimeCall;
   auto numThreadsUsed = helixBuilder.CreateExtractValue(runtimeCall, (uint64_t)0);
 
   /*
@@ -77,3 +78,18 @@ void HELIX::addChunkFunctionExecutionAsideOriginalLoop (
 
   return ;
 }
+
+void HELIX::limitNumberOfCores (Noelle &par, uint32_t cores){
+  assert(this->dispatcherCall != nullptr);
+
+  /*
+   * The number of cores is the fourth argument of the dispatcher.
+   */
+  auto numCores = cast<ConstantInt>(this->dispatcherCall->getArgOperand(3));
+  if (cores >= numCores->getZExtValue()){
+    return ;
+  }
+  this->dispatcherCall->setArgOperand(3, ConstantInt::get(par.int64, cores));
+
+  return ;
+}
@@ -15,31 +15,6 @@
 using namespace llvm;
 using namespace llvm::noelle;
 
-/*
- * Heuristic used: push furthest outlier instructions closer to the rest of the sequential segment
- * by moving between control flow equivalent sets of basic blocks
- */
-void HELIX::squeezeSequentialSegment (
-  LoopDependenceInfo *LDI,
-  DataFlowResult *reachabilityDFR,
-  SequentialSegment *ss
-  ){
-
-  /*
-   * Fetch ControlFlowEquivalence and dependence graph
-   * TODO: Move this to LDI
-   */
-  auto loops = LDI->getLoopHierarchyStructures();
-  auto rootLoop = loops.getLoopNestingTreeRoot();
-  auto taskFunction = rootLoop->getHeader()->getParent();
-  auto taskDG = LDI->getLoopDG();
-  DominatorTree taskDT(*taskFunction);
-  PostDominatorTree taskPDT(*taskFunction);
-  DominatorSummary taskDS(taskDT, taskPDT);
-  ControlFlowEquivalence cfe(&taskDS, &loops, rootLoop);
-
-}
-
 void HELIX::squeezeSequentialSegments (
   LoopDependenceInfo *LDI,
   std::vector<SequentialSegment *> *sss,
@@ -40,6 +40,22 @@ namespace llvm::noelle {
 
       void getAnalysisUsage(AnalysisUsage &AU) const override ;
 
+      /*
+       * Progress of the inliner across its invocations.
+       * By default, it is kept in files of the current directory (see noelle-inline).
+       * A driver that invokes the inliner within its own process can keep it in memory instead.
+       */
+      struct Progress {
+        bool hoistLoopsToMain;
+        bool shouldInvokeAgain;
+        bool hasFunctionsToHoist;
+        std::vector<int> functionsToHoist;
+
+        Progress () : hoistLoopsToMain{false}, shouldInvokeAgain{false}, hasFunctionsToHoist{false} {}
+      };
+
+      void setProgress (Progress *progress) ;
+
     private:
 
       /*
@@ -61,6 +77,25 @@ namespace llvm::noelle {
 
       bool inlineFnsOfLoopsToCGRoot (Hot *p) ;
 
+      bool shouldHoistLoopsToMain (void) const ;
+
+      void requestAnotherInvocation (void) ;
+
+      /*
+       * Profile-guided inlining procedure
+       */
+      struct InliningCandidate {
+        CallInst *call;
+        double benefit;
+        uint64_t cost;
+      };
+
+      bool inlineCallsWithinBudget (Noelle &noelle, noelle::CallGraph *pcg, Hot *profiles) ;
+
+      std::vector<InliningCandidate> getInliningCandidates (Noelle &noelle, noelle::CallGraph *pcg, Hot *profiles) ;
+
+      void updateProfiles (Function *F, Hot *profiles) ;
+
       /*
        * Inline tracking
        */
@@ -126,6 +161,8 @@ namespace llvm::noelle {
        */
       std::set<LoopStructure *> loopSummaries;
       Verbosity verbose;
+      uint32_t codeGrowthBudget;
+      Progress *progress;
     };
 
 }
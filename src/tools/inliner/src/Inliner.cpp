@@ -14,7 +14,7 @@ using namespace llvm;
 using namespace llvm::noelle;
 
 Inliner::Inliner ()
-  : ModulePass{ID}, fnsAffected{}, parentFns{}, childrenFns{}, loopsToCheck{}, depthOrderedFns{}, preOrderedLoops{}
+  : ModulePass{ID}, fnsAffected{}, parentFns{}, childrenFns{}, loopsToCheck{}, depthOrderedFns{}, preOrderedLoops{}, progress{nullptr}
 {
 
   return ;
@@ -79,12 +79,6 @@ bool Inliner::runOnModule (Module &M) {
   };
   printFnInfo();
 
-  auto writeToContinueFile = []() -> void {
-    ofstream continuefile("dgsimplify_continue.txt");
-    continuefile << "1\n";
-    continuefile.close();
-  };
-
   /*
    * Fetch the profiles.
    */
@@ -97,10 +91,38 @@ bool Inliner::runOnModule (Module &M) {
     }
   }
 
+  /*
+   * Check if we are hoisting loops to the entry function.
+   */
+  auto doHoist = this->shouldHoistLoopsToMain();
+
+  /*
+   * Check if the inlining of calls involved in loop-carried data dependences is driven by the profiles.
+   * In this case, all calls are inlined within the first invocation and no further invocation is needed.
+   */
+  auto isBudgetDriven = (this->codeGrowthBudget > 0) && profiles->isAvailable();
+  if (  true
+        && isBudgetDriven
+        && (!doHoist)
+     ){
+    auto inlined = this->inlineCallsWithinBudget(noelle, pcg, profiles);
+
+    /*
+     * Free the memory.
+     */
+    delete pcg;
+
+    errs() << "Inliner: Exit\n";
+    return inlined;
+  }
+
   /*
    * Inline calls involved in loop-carried data dependences.
+   * When the inlining is driven by the profiles, these calls have already been considered.
    */
-  getLoopsToInline(noelle, profiles);
+  if (!isBudgetDriven){
+    getLoopsToInline(noelle, profiles);
+  }
 
   /*
    * Perform the inlining.
@@ -108,7 +130,7 @@ bool Inliner::runOnModule (Module &M) {
   auto inlined = this->inlineCallsInvolvedInLoopCarriedDataDependences(noelle, pcg);
   if (inlined){
     errs() << "Inliner:   Inlined calls due to loop-carried data dependences\n";
-    writeToContinueFile();
+    this->requestAnotherInvocation();
 
     /*
      * Free the memory.
@@ -145,9 +167,6 @@ bool Inliner::runOnModule (Module &M) {
   /*
    * Inline functions containing targeted loops so the loop is in main
    */
-  ifstream doHoistFile("dgsimplify_do_hoist.txt");
-  bool doHoist = doHoistFile.good();
-  doHoistFile.close();
   if (doHoist) {
     std::string filename = "dgsimplify_loop_hoisting.txt";
     getFunctionsToInline(filename);
@@ -167,7 +186,7 @@ bool Inliner::runOnModule (Module &M) {
 
     auto remaining = registerRemainingFunctions(filename);
     if (remaining) {
-      writeToContinueFile();
+      this->requestAnotherInvocation();
     }
 
     printFnInfo();
@@ -193,9 +212,36 @@ bool Inliner::runOnModule (Module &M) {
   return false;
 }
 
+void Inliner::setProgress (Progress *progress) {
+  this->progress = progress;
+
+  return ;
+}
+
 /*
- * Progress Tracking using file system
+ * Progress Tracking using file system (or the progress given by the driver)
  */
+bool Inliner::shouldHoistLoopsToMain (void) const {
+  if (this->progress != nullptr){
+    return this->progress->hoistLoopsToMain;
+  }
+  ifstream doHoistFile("dgsimplify_do_hoist.txt");
+
+  return doHoistFile.good();
+}
+
+void Inliner::requestAnotherInvocation (void) {
+  if (this->progress != nullptr){
+    this->progress->shouldInvokeAgain = true;
+    return ;
+  }
+  ofstream continuefile("dgsimplify_continue.txt");
+  continuefile << "1\n";
+  continuefile.close();
+
+  return ;
+}
+
 void Inliner::getLoopsToInline (Noelle &noelle, Hot *profiles) {
   assert(profiles != nullptr);
 
@@ -227,6 +273,19 @@ void Inliner::getLoopsToInline (Noelle &noelle, Hot *profiles) {
 
 void Inliner::getFunctionsToInline (std::string filename) {
   fnsToCheck.clear();
+  if (this->progress != nullptr){
+    if (this->progress->hasFunctionsToHoist){
+      for (auto fnInd : this->progress->functionsToHoist){
+        assert(fnInd > 0 && fnInd < depthOrderedFns.size());
+        fnsToCheck.insert(depthOrderedFns[fnInd]);
+      }
+    } else {
+      for (auto funcLoops : preOrderedLoops) {
+        fnsToCheck.insert(funcLoops.first);
+      }
+    }
+    return ;
+  }
   ifstream infile(filename);
   if (infile.good()) {
     std::string line;
@@ -244,12 +303,16 @@ void Inliner::getFunctionsToInline (std::string filename) {
 }
 
 bool Inliner::registerRemainingFunctions (std::string filename) {
-  remove(filename.c_str());
+  if (this->progress != nullptr){
+    this->progress->hasFunctionsToHoist = false;
+    this->progress->functionsToHoist.clear();
+  } else {
+    remove(filename.c_str());
+  }
   if (fnsToCheck.empty()) {
     return false;
   }
 
-  ofstream outfile(filename);
   std::vector<int> fnInds;
   for (auto F : fnsToCheck) {
     auto fID = fnOrders[F];
@@ -261,6 +324,12 @@ bool Inliner::registerRemainingFunctions (std::string filename) {
 
   std::sort(fnInds.begin(), fnInds.end());
 
+  if (this->progress != nullptr){
+    this->progress->hasFunctionsToHoist = true;
+    this->progress->functionsToHoist = fnInds;
+    return true;
+  }
+  ofstream outfile(filename);
   for (auto ind : fnInds) {
     outfile << ind << "\n";
   }
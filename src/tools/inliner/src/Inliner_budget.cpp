@@ -0,0 +1,254 @@
+/*
+ * Copyright 2020 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "Inliner.hpp"
+#include "DOALL.hpp"
+
+namespace llvm::noelle {
+
+/*
+ * GOAL: Inline the calls involved in loop-carried data dependences that are most likely to pay off
+ * The benefit of a call is the work of the sequential SCC it belongs to that could run in parallel once the dependences of the call are removed.
+ * The cost of a call is the number of instructions its inlining adds to the program.
+ * Calls are inlined from the one with the highest benefit per instruction added until the code growth budget runs out.
+ */
+bool Inliner::inlineCallsWithinBudget (Noelle &noelle, noelle::CallGraph *pcg, Hot *profiles) {
+  assert(pcg != nullptr);
+  assert(profiles != nullptr);
+
+  /*
+   * Compute the budget.
+   */
+  uint64_t programInstructions = 0;
+  auto program = noelle.getProgram();
+  for (auto &F : *program){
+    programInstructions += profiles->getStaticInstructions(&F);
+  }
+  uint64_t budget = (programInstructions * this->codeGrowthBudget) / 100;
+  if (this->verbose != Verbosity::Disabled) {
+    errs() << "Inliner:   Code growth budget = " << budget << " instructions\n";
+  }
+
+  /*
+   * Inline calls until either the budget runs out or no candidate is left.
+   * The dependences of the functions modified are computed again to find the candidates exposed by the inlining.
+   */
+  auto anyInlined = false;
+  auto inlined = true;
+  auto currentPCG = pcg;
+  while (inlined){
+    inlined = false;
+
+    /*
+     * Rank the candidates.
+     */
+    auto compareCandidates = [](InliningCandidate const &c1, InliningCandidate const &c2) -> bool {
+      return (c1.benefit / c1.cost) < (c2.benefit / c2.cost);
+    };
+    std::priority_queue<InliningCandidate, std::vector<InliningCandidate>, decltype(compareCandidates)> candidates(compareCandidates);
+    for (auto &candidate : this->getInliningCandidates(noelle, currentPCG, profiles)){
+      candidates.push(candidate);
+    }
+
+    /*
+     * Inline the candidates that fit within the budget.
+     */
+    std::set<Function *> modifiedFunctions;
+    while (!candidates.empty()){
+      auto candidate = candidates.top();
+      candidates.pop();
+      if (candidate.cost > budget){
+        continue ;
+      }
+      auto caller = candidate.call->getFunction();
+      auto callee = candidate.call->getCalledFunction();
+      if (this->verbose != Verbosity::Disabled) {
+        errs() << "Inliner:   Inlining " << callee->getName() << " into " << caller->getName() << " (benefit = " << candidate.benefit << ", cost = " << candidate.cost << ")\n";
+      }
+
+      /*
+       * Inline the call.
+       */
+      InlineFunctionInfo IFI;
+      if (!InlineFunction(candidate.call, IFI)){
+        continue ;
+      }
+      budget -= candidate.cost;
+      modifiedFunctions.insert(caller);
+      inlined = true;
+    }
+
+    /*
+     * The dependences and the loops of the modified functions are not valid anymore.
+     * Furthermore, the code inlined has no profile yet, so the calls it includes could not become candidates.
+     */
+    for (auto F : modifiedFunctions){
+      noelle.invalidateFunctionDependenceGraph(F);
+      noelle.invalidateLoopNestingForest(F);
+      this->updateProfiles(F, profiles);
+    }
+
+    /*
+     * The inlined code brings the calls of the callees into their callers, so the call graph of the program is computed again.
+     * The call graph given as input is freed by the caller.
+     */
+    if (inlined){
+      if (currentPCG != pcg){
+        delete currentPCG;
+      }
+      auto fm = noelle.getFunctionsManager();
+      fm->invalidateProgramCallGraph();
+      currentPCG = fm->getProgramCallGraph();
+    }
+    anyInlined |= inlined;
+  }
+
+  /*
+   * Free the memory.
+   */
+  if (currentPCG != pcg){
+    delete currentPCG;
+    noelle.getFunctionsManager()->invalidateProgramCallGraph();
+  }
+
+  return anyInlined;
+}
+
+/*
+ * Set the invocations of the basic blocks of @F from its block frequencies.
+ * The inlined code keeps the branch weights of the callee, so the frequencies of its basic blocks are scaled to the invocations of the call inlined.
+ */
+void Inliner::updateProfiles (Function *F, Hot *profiles) {
+  auto& bfi = getAnalysis<BlockFrequencyInfoWrapperPass>(*F).getBFI();
+  for (auto &bb : *F){
+    auto count = bfi.getBlockProfileCount(&bb);
+    if (!count.hasValue()){
+      profiles->setBasicBlockInvocations(&bb, 0);
+      continue ;
+    }
+    profiles->setBasicBlockInvocations(&bb, count.getValue());
+  }
+
+  return ;
+}
+
+std::vector<Inliner::InliningCandidate> Inliner::getInliningCandidates (Noelle &noelle, noelle::CallGraph *pcg, Hot *profiles) {
+  std::vector<InliningCandidate> candidates;
+
+  for (auto &F : *noelle.getProgram()){
+    if (F.empty()){
+      continue ;
+    }
+    if (!profiles->hasBeenExecuted(&F)){
+      continue ;
+    }
+
+    /*
+     * Check the loops of the function that are hot enough.
+     * Only the dependences of the hottest loops are needed, so they are computed only for these loops.
+     */
+    auto loops = noelle.getLoops(&F, noelle.getMinimumHotness(), true);
+    for (auto LDI : *loops){
+      auto loopStructure = LDI->getLoopStructure();
+      if (profiles->getDynamicTotalInstructionCoverage(loopStructure) < noelle.getMinimumHotness()){
+        continue ;
+      }
+
+      /*
+       * Check the calls of the SCCs that block DOALL.
+       */
+      for (auto scc : DOALL::getSCCsThatBlockDOALLToBeApplicable(LDI, noelle)){
+
+        /*
+         * Do not inline a call that depends only on itself because it is unlikely to make a difference.
+         */
+        if (scc->numberOfInstructions() == 1){
+          continue ;
+        }
+
+        /*
+         * Count the memory dependences within the SCC.
+         */
+        auto countMemoryDependences = [](DGNode<Value> *node) -> uint64_t {
+          uint64_t memoryDependences = 0;
+          for (auto edge : node->getAllConnectedEdges()) {
+            if (edge->isMemoryDependence()) {
+              memoryDependences++;
+            }
+          }
+          return memoryDependences;
+        };
+        uint64_t sccMemoryDependences = 0;
+        for (auto node : scc->getNodes()){
+          sccMemoryDependences += countMemoryDependences(node);
+        }
+        if (sccMemoryDependences == 0){
+          continue ;
+        }
+        auto sccWork = profiles->getTotalInstructions(scc);
+
+        for (auto node : scc->getNodes()){
+
+          /*
+           * Fetch the calls to functions with a body that have been executed.
+           */
+          auto call = dyn_cast<CallInst>(node->getT());
+          if (call == nullptr){
+            continue ;
+          }
+          auto callee = call->getCalledFunction();
+          if (  false
+                || (callee == nullptr)
+                || callee->empty()
+                || callee->isIntrinsic()
+                || (callee == &F)
+                || (!profiles->hasBeenExecuted(call))
+             ){
+            continue ;
+          }
+
+          /*
+           * Do not consider calls within sub-loops and calls that are in a cycle within the program call graph.
+           */
+          if (  false
+                || loopStructure->isIncludedInItsSubLoops(call)
+                || pcg->doesItBelongToASCC(callee)
+             ){
+            continue ;
+          }
+
+          /*
+           * Compute the benefit and the cost of the inlining.
+           */
+          InliningCandidate candidate;
+          candidate.call = call;
+          candidate.benefit = ((double)sccWork) * ((double)countMemoryDependences(node)) / ((double)sccMemoryDependences);
+          candidate.cost = std::max<uint64_t>(profiles->getStaticInstructions(callee), 1);
+          if (candidate.benefit == 0){
+            continue ;
+          }
+          candidates.push_back(candidate);
+        }
+      }
+    }
+
+    /*
+     * Free the memory.
+     */
+    for (auto LDI : *loops){
+      delete LDI;
+    }
+    delete loops;
+  }
+
+  return candidates;
+}
+
+}
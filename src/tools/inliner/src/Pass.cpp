@@ -18,9 +18,11 @@ using namespace llvm::noelle;
  * Options of the dependence graph simplifier pass.
  */
 static cl::opt<int> Verbose("noelle-inliner-verbose", cl::ZeroOrMore, cl::Hidden, cl::desc("Verbose output (0: disabled, 1: minimal, 2: maximal"));
+static cl::opt<int> CodeGrowthBudget("noelle-inliner-code-growth-budget", cl::ZeroOrMore, cl::Hidden, cl::init(0), cl::desc("Inline calls ranked by their profiled benefit until the program grows by this percentage of its instructions (0: disabled)"));
 
 bool Inliner::doInitialization (Module &M) {
   this->verbose = static_cast<Verbosity>(Verbose.getValue());
+  this->codeGrowthBudget = CodeGrowthBudget.getValue();
 
   return false;
 }
@@ -30,6 +32,7 @@ void Inliner::getAnalysisUsage(AnalysisUsage &AU) const {
   AU.addRequired<LoopInfoWrapperPass>();
   AU.addRequired<CallGraphWrapperPass>();
   AU.addRequired<DominatorTreeWrapperPass>();
+  AU.addRequired<BlockFrequencyInfoWrapperPass>();
 
   return ;
 }
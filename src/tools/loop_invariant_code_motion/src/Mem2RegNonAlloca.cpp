@@ -79,6 +79,178 @@ bool Mem2RegNonAlloca::promoteMemoryToRegister (void) {
     }
   }
 
+  /*
+   * Promote memory locations accessed across the whole loop nest (e.g., accumulators stored in globals or in fields of structures updated by sub-loops).
+   */
+  if (this->promoteMemoryToRegisterAcrossLoopNest()) {
+    return true;
+  }
+
+  return false;
+}
+
+bool Mem2RegNonAlloca::promoteMemoryToRegisterAcrossLoopNest (void) {
+
+  /*
+   * Fetch the loop and the data layout.
+   */
+  auto loopStructure = LDI.getLoopStructure();
+  auto loopFunction = loopStructure->getFunction();
+  auto &DL = loopFunction->getParent()->getDataLayout();
+  auto loopDG = LDI.getLoopDG();
+
+  /*
+   * Group the loads and stores of the whole nest by the memory location they access.
+   * A memory location is identified by a base pointer defined outside the loop and a constant offset from it.
+   */
+  std::map<std::pair<Value *, int64_t>, std::unordered_set<Instruction *>> accessesByLocation;
+  std::set<std::pair<Value *, int64_t>> storedLocations;
+  for (auto B : loopStructure->getBasicBlocks()) {
+    for (auto &I : *B) {
+      Value *pointer = nullptr;
+      if (auto load = dyn_cast<LoadInst>(&I)) {
+        if (!load->isSimple()) continue;
+        pointer = load->getPointerOperand();
+      } else if (auto store = dyn_cast<StoreInst>(&I)) {
+        if (!store->isSimple()) continue;
+        pointer = store->getPointerOperand();
+      } else {
+        continue;
+      }
+
+      APInt offset(DL.getIndexTypeSizeInBits(pointer->getType()), 0);
+      auto base = pointer->stripAndAccumulateInBoundsConstantOffsets(DL, offset);
+      if (auto baseInst = dyn_cast<Instruction>(base)) {
+        if (loopStructure->isIncluded(baseInst)) continue;
+      }
+
+      auto location = std::make_pair(base, offset.getSExtValue());
+      accessesByLocation[location].insert(&I);
+      if (isa<StoreInst>(&I)) {
+        storedLocations.insert(location);
+      }
+    }
+  }
+
+  /*
+   * Promote the first location that is both loaded and stored within the nest, and that is not aliased by any other instruction of the nest.
+   */
+  for (auto &locationAndAccesses : accessesByLocation) {
+    auto location = locationAndAccesses.first;
+    auto &accesses = locationAndAccesses.second;
+    if (storedLocations.find(location) == storedLocations.end()) continue;
+    if (accesses.size() < 2) continue;
+
+    /*
+     * All accesses must use the same type.
+     */
+    Type *accessType = nullptr;
+    auto isTypeConsistent = true;
+    for (auto I : accesses) {
+      auto currentType = isa<LoadInst>(I) ? I->getType() : cast<StoreInst>(I)->getValueOperand()->getType();
+      if (accessType && accessType != currentType) {
+        isTypeConsistent = false;
+        break;
+      }
+      accessType = currentType;
+    }
+    if (!isTypeConsistent) continue;
+
+    /*
+     * The only memory dependences of the accesses within the nest must be between them.
+     */
+    auto isAliased = false;
+    for (auto I : accesses) {
+      auto isDependenceWithOtherInstruction = [&accesses, loopStructure](Value *v, DGEdge<Value> *dep) -> bool {
+        auto otherInst = dyn_cast<Instruction>(v);
+        if (!otherInst || !loopStructure->isIncluded(otherInst)) return false;
+        return accesses.find(otherInst) == accesses.end();
+      };
+      if (loopDG->iterateOverDependencesFrom(I, false, true, false, isDependenceWithOtherInstruction)
+        || loopDG->iterateOverDependencesTo(I, false, true, false, isDependenceWithOtherInstruction)) {
+        isAliased = true;
+        break;
+      }
+    }
+    if (isAliased) continue;
+
+    /*
+     * The location will be loaded in the pre-header and stored at the exits of the loop.
+     * This must not introduce accesses to memory that is not accessible.
+     */
+    if (!this->isSafeToAccessAtLoopBoundaries(location.first, location.second, accessType, accesses)) continue;
+
+    /*
+     * Fetch a pointer to the location that is available in the pre-header.
+     */
+    Value *memoryLocation = nullptr;
+    for (auto I : accesses) {
+      auto pointer = isa<LoadInst>(I) ? cast<LoadInst>(I)->getPointerOperand() : cast<StoreInst>(I)->getPointerOperand();
+      auto pointerInst = dyn_cast<Instruction>(pointer);
+      if (!pointerInst || !loopStructure->isIncluded(pointerInst)) {
+        memoryLocation = pointer;
+        break;
+      }
+    }
+    if (!memoryLocation) {
+      IRBuilder<> preHeaderBuilder(loopStructure->getPreHeader()->getTerminator());
+      auto base = location.first;
+      auto addressSpace = cast<PointerType>(base->getType())->getAddressSpace();
+      auto baseAsBytes = preHeaderBuilder.CreateBitCast(base, preHeaderBuilder.getInt8PtrTy(addressSpace));
+      auto locationAsBytes = preHeaderBuilder.CreateInBoundsGEP(preHeaderBuilder.getInt8Ty(), baseAsBytes, preHeaderBuilder.getInt64(location.second));
+      memoryLocation = preHeaderBuilder.CreateBitCast(locationAsBytes, accessType->getPointerTo(addressSpace));
+    }
+
+    if (noelle.getVerbosity() >= Verbosity::Maximal) {
+      memoryLocation->print(errs() << "Mem2Reg:  Promote memory location across the loop nest: "); errs() << "\n";
+    }
+
+    /*
+     * Promote the location.
+     * The loop-carried memory dependences become register ones (e.g., reductions).
+     */
+    auto orderedMemoryInstsByBlock = this->orderMemoryInstsByBlock(accesses);
+    return this->promoteMemoryInstructionsToRegister(orderedMemoryInstsByBlock, memoryLocation);
+  }
+
+  return false;
+}
+
+bool Mem2RegNonAlloca::isSafeToAccessAtLoopBoundaries (
+  Value *base,
+  int64_t offset,
+  Type *accessType,
+  std::unordered_set<Instruction *> const &accesses
+) {
+  auto loopStructure = LDI.getLoopStructure();
+  auto &DL = loopStructure->getFunction()->getParent()->getDataLayout();
+  if (offset < 0) return false;
+  auto accessEnd = ((uint64_t)offset) + DL.getTypeStoreSize(accessType);
+
+  /*
+   * Mutable global variables can always be accessed.
+   */
+  if (auto globalVar = dyn_cast<GlobalVariable>(base)) {
+    if (globalVar->isConstant()) return false;
+    return accessEnd <= DL.getTypeAllocSize(globalVar->getValueType());
+  }
+
+  /*
+   * Arguments that are known to point to enough bytes (e.g., "this" of C++ methods) can always be accessed.
+   */
+  if (auto arg = dyn_cast<Argument>(base)) {
+    if (accessEnd <= arg->getDereferenceableBytes()) return true;
+  }
+
+  /*
+   * Otherwise, the location must be accessed every time the loop is entered.
+   * This is guaranteed if the header accesses it.
+   */
+  auto loopHeader = loopStructure->getHeader();
+  for (auto I : accesses) {
+    if (I->getParent() == loopHeader) return true;
+  }
+
   return false;
 }
 
@@ -183,6 +355,14 @@ bool Mem2RegNonAlloca::promoteMemoryToRegisterForSCC (SCC *scc, Value *memoryLoc
 
   auto orderedMemoryInstsByBlock = collectOrderedMemoryInstsByBlock(scc);
 
+  return this->promoteMemoryInstructionsToRegister(orderedMemoryInstsByBlock, memoryLocation);
+}
+
+bool Mem2RegNonAlloca::promoteMemoryInstructionsToRegister (
+  std::unordered_map<BasicBlock *, std::vector<Instruction *>> const &orderedMemoryInstsByBlock,
+  Value *memoryLocation
+) {
+
   /*
    * Traverse loop blocks, creating PHIs to track the latest value to-be-stored
    * and replacing uses of the loads with the latest value at that point
@@ -502,18 +682,24 @@ std::unordered_map<BasicBlock *, std::vector<Instruction *>> Mem2RegNonAlloca::c
     errs() << "Mem2Reg:  Collecting and ordering memory loads/stores by basic block\n";
   }
 
-  /*
-   * Index memory values by their basic block
-   */
-  std::unordered_map<BasicBlock *, std::unordered_set<Instruction *>> memoryInstsByBlock;
+  std::unordered_set<Instruction *> memoryInsts;
   for (auto nodePair : scc->internalNodePairs()) {
     auto value = nodePair.first;
-    Instruction *memoryInst = nullptr;
     if (isa<LoadInst>(value) || isa<StoreInst>(value)) {
-      memoryInst = cast<Instruction>(value);
+      memoryInsts.insert(cast<Instruction>(value));
     }
-    if (!memoryInst) continue;
+  }
+
+  return this->orderMemoryInstsByBlock(memoryInsts);
+}
 
+std::unordered_map<BasicBlock *, std::vector<Instruction *>> Mem2RegNonAlloca::orderMemoryInstsByBlock (std::unordered_set<Instruction *> const &memoryInstsToOrder) {
+
+  /*
+   * Index memory values by their basic block
+   */
+  std::unordered_map<BasicBlock *, std::unordered_set<Instruction *>> memoryInstsByBlock;
+  for (auto memoryInst : memoryInstsToOrder) {
     auto B = memoryInst->getParent();
     if (memoryInstsByBlock.find(B) == memoryInstsByBlock.end()) {
       std::unordered_set<Instruction *> memoryInsts = { memoryInst };
@@ -38,7 +38,24 @@ namespace llvm::noelle {
       bool hoistMemoryInstructionsRelyingOnExistingRegisterValues (SCC *scc, Value *memoryLocation) ;
       bool promoteMemoryToRegisterForSCC (SCC *scc, Value *memoryLocation) ;
 
+      /*
+       * Promote a location (base pointer defined outside the loop plus a constant offset) that is not aliased within the whole loop nest.
+       */
+      bool promoteMemoryToRegisterAcrossLoopNest (void) ;
+      bool isSafeToAccessAtLoopBoundaries (
+        Value *base,
+        int64_t offset,
+        Type *accessType,
+        std::unordered_set<Instruction *> const &accesses
+      ) ;
+
+      bool promoteMemoryInstructionsToRegister (
+        std::unordered_map<BasicBlock *, std::vector<Instruction *>> const &orderedMemoryInstsByBlock,
+        Value *memoryLocation
+      ) ;
+
       std::unordered_map<BasicBlock *, std::vector<Instruction *>> collectOrderedMemoryInstsByBlock (SCC *scc) ;
+      std::unordered_map<BasicBlock *, std::vector<Instruction *>> orderMemoryInstsByBlock (std::unordered_set<Instruction *> const &memoryInsts) ;
 
       void removeRedundantPHIs (
         std::unordered_set<PHINode *> phis,
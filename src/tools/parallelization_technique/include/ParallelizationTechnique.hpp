@@ -56,6 +56,11 @@ namespace llvm::noelle {
 
       Value * getEnvArray (void) const ;
 
+      /*
+       * Return the functions that implement the tasks generated by the last application of the technique.
+       */
+      std::vector<Function *> getTaskFunctions (void) const ;
+
       BasicBlock *getParLoopEntryPoint () { return entryPointOfParallelizedLoop; }
       BasicBlock *getParLoopExitPoint () { return exitPointOfParallelizedLoop; }
 
@@ -190,6 +195,11 @@ namespace llvm::noelle {
         Type *typeForValue
       );
 
+      int getEnvIndexOfLiveOutProducedBySCC (
+        LoopDependenceInfo *LDI,
+        SCC *scc
+      );
+
       Value *castToCorrectReducibleType (IRBuilder<> &builder, Value *value, Type *targetType) ;
 
       /*
@@ -28,6 +28,15 @@ Value * ParallelizationTechnique::getEnvArray (void) const {
   return envBuilder->getEnvArray(); 
 }
 
+std::vector<Function *> ParallelizationTechnique::getTaskFunctions (void) const {
+  std::vector<Function *> taskFunctions;
+  for (auto task : this->tasks){
+    taskFunctions.push_back(task->getTaskBody());
+  }
+
+  return taskFunctions;
+}
+
 void ParallelizationTechnique::initializeEnvironmentBuilder (
   LoopDependenceInfo *LDI,
   std::set<int> simpleVars,
@@ -43,8 +52,8 @@ void ParallelizationTechnique::initializeEnvironmentBuilder (
    * Collect the Type of each environment variable
    */
   std::vector<Type *> varTypes;
-  for (int64_t i = 0; i < LDI->environment->size(); ++i) {
-    varTypes.push_back(LDI->environment->typeOfEnvironmentLocation(i));
+  for (int64_t i = 0; i < LDI->getEnvironment()->size(); ++i) {
+    varTypes.push_back(LDI->getEnvironment()->typeOfEnvironmentLocation(i));
   }
 
   this->envBuilder = new EnvBuilder(module.getContext());
@@ -105,7 +114,7 @@ void ParallelizationTechnique::populateLiveInEnvironment (LoopDependenceInfo *LD
   /*
    * Fetch the loop environment.
    */
-  auto env = LDI->environment;
+  auto env = LDI->getEnvironment();
 
   /*
    * Store live-in values into the environment just before jumping to the parallelized loop.
@@ -151,11 +160,13 @@ BasicBlock * ParallelizationTechnique::propagateLiveOutEnvironment (LoopDependen
    */
   std::unordered_map<int, int> reducableBinaryOps;
   std::unordered_map<int, Value *> initialValues;
-  for (auto envInd : LDI->environment->getEnvIndicesOfLiveOutVars()) {
+  std::unordered_map<int, CmpInst::Predicate> minMaxPredicates;
+  std::unordered_map<int, std::pair<int, bool>> indicesOfMinMax;
+  for (auto envInd : LDI->getEnvironment()->getEnvIndicesOfLiveOutVars()) {
     auto isReduced = envBuilder->isReduced(envInd);
     if (!isReduced) continue;
 
-    auto producer = LDI->environment->producerAt(envInd);
+    auto producer = LDI->getEnvironment()->producerAt(envInd);
     auto producerSCC = sccManager->getSCCDAG()->sccOfValue(producer);
     auto producerSCCAttributes = sccManager->getSCCAttrs(producerSCC);
 
@@ -163,8 +174,29 @@ BasicBlock * ParallelizationTechnique::propagateLiveOutEnvironment (LoopDependen
      * HACK: Need to get accumulator that feeds directly into producer PHI, not any intermediate one
      */
     auto firstAccumI = *(producerSCCAttributes->getAccumulators().begin());
-    auto binOpCode = firstAccumI->getOpcode();
-    reducableBinaryOps[envInd] = sccManager->accumOpInfo.accumOpForType(binOpCode, producer->getType());
+    auto minMaxSCC = producerSCCAttributes->getMinMaxTrackedByIndex();
+    if (minMaxSCC != nullptr) {
+
+      /*
+       * The live-out is the position of a min/max, which is reduced together with the min/max.
+       */
+      auto minMaxEnvInd = this->getEnvIndexOfLiveOutProducedBySCC(LDI, minMaxSCC);
+      auto minMaxPredicate = sccManager->getSCCAttrs(minMaxSCC)->getSingleLoopCarriedVariable()->getMinMaxPredicate();
+      indicesOfMinMax[envInd] = std::make_pair(minMaxEnvInd, AccumulatorOpInfo::doesMinMaxKeepFirstOfEqualValues(minMaxPredicate));
+      reducableBinaryOps[envInd] = Instruction::Select;
+
+    } else if (isa<SelectInst>(firstAccumI)) {
+
+      /*
+       * The live-out is a min/max.
+       */
+      minMaxPredicates[envInd] = producerSCCAttributes->getSingleLoopCarriedVariable()->getMinMaxPredicate();
+      reducableBinaryOps[envInd] = Instruction::Select;
+
+    } else {
+      auto binOpCode = firstAccumI->getOpcode();
+      reducableBinaryOps[envInd] = sccManager->accumOpInfo.accumOpForType(binOpCode, producer->getType());
+    }
 
     PHINode *loopEntryProducerPHI = fetchLoopEntryPHIOfProducer(LDI, producer);
     auto initValPHIIndex = loopEntryProducerPHI->getBasicBlockIndex(loopPreHeader);
@@ -177,6 +209,8 @@ BasicBlock * ParallelizationTechnique::propagateLiveOutEnvironment (LoopDependen
     *builder,
     reducableBinaryOps,
     initialValues,
+    minMaxPredicates,
+    indicesOfMinMax,
     numberOfThreadsExecuted);
 
   /*
@@ -195,8 +229,8 @@ BasicBlock * ParallelizationTechnique::propagateLiveOutEnvironment (LoopDependen
     afterReductionBuilder = new IRBuilder<>(afterReductionB);
   }
 
-  for (int envInd : LDI->environment->getEnvIndicesOfLiveOutVars()) {
-    auto prod = LDI->environment->producerAt(envInd);
+  for (int envInd : LDI->getEnvironment()->getEnvIndicesOfLiveOutVars()) {
+    auto prod = LDI->getEnvironment()->producerAt(envInd);
 
     /*
      * NOTE(angelo): If the environment variable isn't reduced, it is held in allocated
@@ -210,7 +244,7 @@ BasicBlock * ParallelizationTechnique::propagateLiveOutEnvironment (LoopDependen
       envVar = afterReductionBuilder->CreateLoad(envBuilder->getEnvVar(envInd));
     }
 
-    for (auto consumer : LDI->environment->consumersOf(prod)) {
+    for (auto consumer : LDI->getEnvironment()->consumersOf(prod)) {
       if (auto depPHI = dyn_cast<PHINode>(consumer)) {
         depPHI->addIncoming(envVar, this->exitPointOfParallelizedLoop);
         continue;
@@ -392,13 +426,18 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
   rootLoop->getFunction()->print(errs());
 
   /*
-   * Check every stack object that can be safely cloned.
+   * Check every memory object that can be safely cloned.
    */
+  auto int64 = IntegerType::get(this->module.getContext(), 64);
+  Function *allocatePrivateCopy = nullptr;
+  Function *releasePrivateCopies = nullptr;
+  int64_t privateCopies = 0;
   for (auto location : memoryCloningAnalysis->getClonableMemoryLocations()) {
 
     /*
-     * Fetch the stack object.
+     * Fetch the memory object.
      */
+    auto memoryObject = location->getMemoryObject();
     auto alloca = location->getAllocation();
 
     /*
@@ -422,11 +461,14 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
 
     /*
      *
-     * The stack object can be safely cloned (thanks to the object-cloning analysis) and it is used by our loop.
+     * The memory object can be safely cloned (thanks to the object-cloning analysis) and it is used by our loop.
      *
-     * First, we need to remove the alloca instruction to be a live-in.
+     * First, we need to remove the instruction that allocates it to be a live-in.
+     * Globals are constants, so they are never live-in.
      */
-    task->removeLiveIn(alloca);
+    if (!location->isGlobal()){
+      task->removeLiveIn(cast<Instruction>(memoryObject));
+    }
 
     /*
      * Now we need to traverse operands of loop instructions to clone
@@ -522,9 +564,9 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
           }
 
           /*
-           * Check if the current operand is the alloca instruction that will be cloned.
+           * Check if the current operand is the memory object that will be cloned.
            */
-          if (opJ == alloca){
+          if (opJ == memoryObject){
             assert(!task->isAnOriginalLiveIn(opJ));
             continue ;
           }
@@ -534,7 +576,7 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
            */
           auto newLiveIn = true;
           for (auto envIndex : envUser->getEnvIndicesOfLiveInVars()) {
-            auto producer = LDI->environment->producerAt(envIndex);
+            auto producer = LDI->getEnvironment()->producerAt(envIndex);
             if (producer == opJ){
               newLiveIn = false;
               break;
@@ -549,7 +591,7 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
            *
            * Make space in the environment for the new live-in.
            */
-          auto newLiveInEnvironmentIndex = LDI->environment->addLiveInValue(opJ, {opI});
+          auto newLiveInEnvironmentIndex = LDI->getEnvironment()->addLiveInValue(opJ, {opI});
           this->envBuilder->addVariableToEnvironment(newLiveInEnvironmentIndex, opJ->getType());
 
           /*
@@ -571,18 +613,104 @@ void ParallelizationTechnique::cloneMemoryLocationsLocallyAndRewireLoop (
       }
     }
 
+    auto firstInst = &*entryBlock.begin();
+    entryBuilder.SetInsertPoint(firstInst);
+
     /*
      * Clone the stack object at the beginning of the task.
      */
-    auto allocaClone = alloca->clone();
-    auto firstInst = &*entryBlock.begin();
-    entryBuilder.SetInsertPoint(firstInst);
-    entryBuilder.Insert(allocaClone);
+    if (location->isStackObject()){
+      auto allocaClone = alloca->clone();
+      entryBuilder.Insert(allocaClone);
+
+      /*
+       * Keep track of the original-clone mapping.
+       */
+      task->addInstruction(alloca, allocaClone);
+      continue ;
+    }
+
+    /*
+     * Heap objects and globals are cloned into memory provided by the runtime.
+     * The runtime reuses the memory of the current worker, so the private copy is allocated once per invocation of the task rather than once per iteration.
+     */
+    if (allocatePrivateCopy == nullptr){
+      allocatePrivateCopy = this->module.getFunction("NOELLE_allocatePrivateCopy");
+      releasePrivateCopies = this->module.getFunction("NOELLE_releasePrivateCopies");
+      if (  false
+            || (allocatePrivateCopy == nullptr)
+            || (releasePrivateCopies == nullptr)
+         ){
+        errs() << "NOELLE: ERROR = functions NOELLE_allocatePrivateCopy and NOELLE_releasePrivateCopies couldn't be found\n";
+        abort();
+      }
+    }
+    auto privateCopyBytes = ConstantInt::get(int64, location->getSizeInBytes());
+    auto privateCopyMemory = entryBuilder.CreateCall(allocatePrivateCopy, ArrayRef<Value *>({ privateCopyBytes }));
+    auto privateCopy = entryBuilder.CreateBitCast(privateCopyMemory, memoryObject->getType());
+    privateCopies++;
+
+    /*
+     * Keep track of the original-clone mapping of heap objects.
+     */
+    if (!location->isGlobal()){
+      task->addInstruction(cast<Instruction>(memoryObject), cast<Instruction>(privateCopy));
+      continue ;
+    }
 
     /*
-     * Keep track of the original-clone mapping.
+     * Globals are constants, so the data flow adjustment doesn't redirect their uses.
+     * Redirect the uses of the global within the task to the private copy.
+     * Constant casts and GEPs of the global are turned into instructions of the task that use the private copy.
      */
-    task->addInstruction(alloca, allocaClone);
+    std::unordered_map<Constant *, Value *> privateAliases;
+    privateAliases[cast<Constant>(memoryObject)] = privateCopy;
+    std::function<Value *(Constant *)> getPrivateAlias = [&](Constant *c) -> Value * {
+      if (privateAliases.find(c) != privateAliases.end()){
+        return privateAliases[c];
+      }
+      auto aliasInst = cast<ConstantExpr>(c)->getAsInstruction();
+      for (auto &op : aliasInst->operands()){
+        auto opC = dyn_cast<Constant>(op.get());
+        if (  true
+              && (opC != nullptr)
+              && ((opC == memoryObject) || location->isConstantCastOrGEPOfLocation(opC))
+           ){
+          op.set(getPrivateAlias(opC));
+        }
+      }
+      entryBuilder.Insert(aliasInst);
+      privateAliases[c] = aliasInst;
+      return aliasInst;
+    };
+    std::vector<Instruction *> taskBodyInstructions;
+    for (auto &inst : instructions(task->getTaskBody())){
+      taskBodyInstructions.push_back(&inst);
+    }
+    for (auto inst : taskBodyInstructions){
+      for (auto &op : inst->operands()){
+        auto opC = dyn_cast<Constant>(op.get());
+        if (  false
+              || (opC == nullptr)
+              || ((opC != memoryObject) && (!location->isConstantCastOrGEPOfLocation(opC)))
+           ){
+          continue ;
+        }
+        op.set(getPrivateAlias(opC));
+      }
+    }
+  }
+
+  /*
+   * Release the private copies of heap objects and globals when the task ends.
+   */
+  if (privateCopies > 0){
+    auto exitBlock = task->getExit();
+    IRBuilder<> exitBuilder(exitBlock);
+    if (auto exitTerminator = exitBlock->getTerminator()){
+      exitBuilder.SetInsertPoint(exitTerminator);
+    }
+    exitBuilder.CreateCall(releasePrivateCopies, ArrayRef<Value *>({ ConstantInt::get(int64, privateCopies) }));
   }
   task->getTaskBody()->print(errs());
   rootLoop->getFunction()->print(errs());
@@ -614,7 +742,7 @@ void ParallelizationTechnique::generateCodeToLoadLiveInVariables (
     /*
      * Fetch the current producer of the original code that generates the live-in value.
      */
-    auto producer = LDI->environment->producerAt(envIndex);
+    auto producer = LDI->getEnvironment()->producerAt(envIndex);
 
     /*
      * Create GEP access of the environment variable at the given index
@@ -670,7 +798,7 @@ void ParallelizationTechnique::generateCodeToStoreLiveOutVariables (
      * assume the direct cloning of the producer is the only clone
      * TODO: Find a better place to map this single clone (perhaps when the original loop's values are cloned)
      */
-    auto producer = (Instruction*)LDI->environment->producerAt(envIndex);
+    auto producer = (Instruction*)LDI->getEnvironment()->producerAt(envIndex);
     if (!task->doesOriginalLiveOutHaveManyClones(producer)) {
       auto singleProducerClone = task->getCloneOfOriginalInstruction(producer);
       task->addLiveOut(producer, singleProducerClone);
@@ -806,7 +934,7 @@ Instruction * ParallelizationTechnique::fetchOrCreatePHIForIntermediateProducerV
   /*
    * Fetch all clones of intermediate values of the producer
    */
-  auto producer = (Instruction*)LDI->environment->producerAt(envIndex);
+  auto producer = (Instruction*)LDI->getEnvironment()->producerAt(envIndex);
   auto producerSCC = sccManager->getSCCDAG()->sccOfValue(producer);
 
   std::set<Instruction *> intermediateValues{};
@@ -1027,7 +1155,7 @@ void ParallelizationTechnique::setReducableVariablesToBeginAtIdentityValue (
   /*
    * Iterate over live-out variables.
    */
-  for (auto envInd : LDI->environment->getEnvIndicesOfLiveOutVars()) {
+  for (auto envInd : LDI->getEnvironment()->getEnvIndicesOfLiveOutVars()) {
 
     /*
      * Check if the current live-out variable can be reduced.
@@ -1043,7 +1171,7 @@ void ParallelizationTechnique::setReducableVariablesToBeginAtIdentityValue (
      * PHI node in the header. The incoming value from the preheader is the
      * location of the initial value that needs to be changed
      */
-    auto producer = LDI->environment->producerAt(envInd);
+    auto producer = LDI->getEnvironment()->producerAt(envInd);
     PHINode *loopEntryProducerPHI = fetchLoopEntryPHIOfProducer(LDI, producer);
 
     /*
@@ -1109,7 +1237,7 @@ Value * ParallelizationTechnique::getIdentityValueForEnvironmentValue (
   /*
    * Fetch the producer of new values of the current environment variable.
    */
-  auto producer = LDI->environment->producerAt(environmentIndex);
+  auto producer = LDI->getEnvironment()->producerAt(environmentIndex);
 
   /*
    * Fetch the SCC that this producer belongs to.
@@ -1123,11 +1251,33 @@ Value * ParallelizationTechnique::getIdentityValueForEnvironmentValue (
   auto sccAttrs = sccManager->getSCCAttrs(producerSCC);
   assert(sccAttrs->numberOfAccumulators() > 0 && "The environment value isn't accumulated!");
 
+  /*
+   * Check if the environment value is the position of a min/max.
+   * Its identity must lose every tie between equal min/max values.
+   */
+  auto minMaxSCC = sccAttrs->getMinMaxTrackedByIndex();
+  if (minMaxSCC != nullptr) {
+    auto minMaxPredicate = sccManager->getSCCAttrs(minMaxSCC)->getSingleLoopCarriedVariable()->getMinMaxPredicate();
+    auto positionType = cast<IntegerType>(typeForValue);
+    if (AccumulatorOpInfo::doesMinMaxKeepFirstOfEqualValues(minMaxPredicate)) {
+      return ConstantInt::get(positionType, APInt::getSignedMaxValue(positionType->getBitWidth()));
+    }
+    return ConstantInt::get(positionType, APInt::getSignedMinValue(positionType->getBitWidth()));
+  }
+
   /*
    * Fetch the accumulator.
    */
   auto firstAccumI = *(sccAttrs->getAccumulators().begin());
 
+  /*
+   * Check if the environment value is a min/max.
+   */
+  if (isa<SelectInst>(firstAccumI)) {
+    auto minMaxPredicate = sccAttrs->getSingleLoopCarriedVariable()->getMinMaxPredicate();
+    return sccManager->accumOpInfo.generateIdentityForMinMax(minMaxPredicate, typeForValue);
+  }
+
   /*
    * Fetch the identity.
    */
@@ -1139,6 +1289,22 @@ Value * ParallelizationTechnique::getIdentityValueForEnvironmentValue (
   return identityValue;
 }
 
+int ParallelizationTechnique::getEnvIndexOfLiveOutProducedBySCC (
+  LoopDependenceInfo *LDI,
+  SCC *scc
+){
+  auto sccManager = LDI->getSCCManager();
+  for (auto envInd : LDI->getEnvironment()->getEnvIndicesOfLiveOutVars()) {
+    auto producer = LDI->getEnvironment()->producerAt(envInd);
+    if (sccManager->getSCCDAG()->sccOfValue(producer) == scc) {
+      return envInd;
+    }
+  }
+
+  errs() << "ParallelizationTechnique: ERROR = the SCC doesn't produce any live-out\n";
+  abort();
+}
+
 void ParallelizationTechnique::generateCodeToStoreExitBlockIndex (
   LoopDependenceInfo *LDI,
   int taskIndex
@@ -1158,13 +1324,13 @@ void ParallelizationTechnique::generateCodeToStoreExitBlockIndex (
    *
    * Fetch the pointer of the location where the exit block ID taken will be stored.
    */
-  auto exitBlockEnvIndex = LDI->environment->indexOfExitBlockTaken();
+  auto exitBlockEnvIndex = LDI->getEnvironment()->indexOfExitBlockTaken();
   assert(exitBlockEnvIndex != -1);
   auto envUser = this->envBuilder->getUser(taskIndex);
   auto entryTerminator = task->getEntry()->getTerminator();
   IRBuilder<> entryBuilder(entryTerminator);
 
-  auto envType = LDI->environment->typeOfEnvironmentLocation(exitBlockEnvIndex);
+  auto envType = LDI->getEnvironment()->typeOfEnvironmentLocation(exitBlockEnvIndex);
   envUser->createEnvPtr(entryBuilder, exitBlockEnvIndex, envType);
 
   /*
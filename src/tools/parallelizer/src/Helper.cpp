@@ -34,6 +34,43 @@ namespace llvm::noelle {
       }
       par.queues.queuePops.push_back(popFunction);
     }
+    std::string roundRobinPushers[4] = { "queuePushRoundRobin8", "queuePushRoundRobin16", "queuePushRoundRobin32", "queuePushRoundRobin64" };
+    std::string roundRobinPoppers[4] = { "queuePopRoundRobin8", "queuePopRoundRobin16", "queuePopRoundRobin32", "queuePopRoundRobin64" };
+    for (auto pusher : roundRobinPushers) {
+      auto pushFunction = M.getFunction(pusher);
+      if (pushFunction == nullptr){
+        errs() << "Parallelizer: ERROR = function \"" << pusher << "\" could not be found\n";
+        abort();
+      }
+      par.queues.queueRoundRobinPushes.push_back(pushFunction);
+    }
+    for (auto popper : roundRobinPoppers) {
+      auto popFunction = M.getFunction(popper);
+      if (popFunction == nullptr){
+        errs() << "Parallelizer: ERROR = function \"" << popper << "\" could not be found\n";
+        abort();
+      }
+      par.queues.queueRoundRobinPops.push_back(popFunction);
+    }
+    par.queues.queueFlush = M.getFunction("queueFlush");
+    if (par.queues.queueFlush == nullptr){
+      errs() << "Parallelizer: ERROR = function \"queueFlush\" could not be found\n";
+      abort();
+    }
+    par.queues.queueRoundRobinFlush = M.getFunction("queueFlushRoundRobin");
+    if (par.queues.queueRoundRobinFlush == nullptr){
+      errs() << "Parallelizer: ERROR = function \"queueFlushRoundRobin\" could not be found\n";
+      abort();
+    }
+    par.queues.queueRecordPush = M.getFunction("queuePushRecord");
+    par.queues.queueRecordPop = M.getFunction("queuePopRecord");
+    if (  false
+          || (par.queues.queueRecordPush == nullptr)
+          || (par.queues.queueRecordPop == nullptr)
+       ){
+      errs() << "Parallelizer: ERROR = functions \"queuePushRecord\" and \"queuePopRecord\" could not be found\n";
+      abort();
+    }
     for (auto queueF : par.queues.queuePushes) {
       par.queues.queueTypes.push_back(queueF->arg_begin()->getType());
     }
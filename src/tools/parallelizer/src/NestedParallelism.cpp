@@ -0,0 +1,257 @@
+/*
+ * Copyright 2020 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "Parallelizer.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+namespace llvm::noelle {
+
+  uint32_t Parallelizer::selectNumberOfCoresForHELIXWithNestedDOALLs (
+    LoopDependenceInfo *LDI,
+    Noelle &par,
+    DOALL &doall,
+    Heuristics *h,
+    uint32_t *coresPerNestedDOALL
+    ){
+
+    /*
+     * Fetch the cores available to the loop.
+     */
+    auto maxCores = LDI->getMaximumNumberOfCores();
+    (*coresPerNestedDOALL) = 1;
+
+    /*
+     * The model relies on profiles.
+     * Moreover, at least two cores are needed at each level.
+     */
+    auto profiles = par.getProfiles();
+    auto ls = LDI->getLoopStructure();
+    if (  false
+          || (!profiles->isAvailable())
+          || (profiles->getTotalInstructions(ls) == 0)
+          || (maxCores < 4)
+       ){
+      return maxCores;
+    }
+    auto loopInsts = (double)profiles->getTotalInstructions(ls);
+
+    /*
+     * Compute the time spent in the outermost DOALL loops nested within the loop.
+     */
+    uint64_t nestedDOALLInsts = 0;
+    uint64_t nestedDOALLInvocations = 0;
+    std::queue<LoopStructure *> loopsToCheck;
+    for (auto child : ls->getChildren()){
+      loopsToCheck.push(child);
+    }
+    while (!loopsToCheck.empty()){
+      auto nestedLoop = loopsToCheck.front();
+      loopsToCheck.pop();
+
+      auto nestedLDI = par.getLoop(nestedLoop);
+      if (doall.canBeAppliedToLoop(nestedLDI, par, h)){
+        nestedDOALLInsts += profiles->getTotalInstructions(nestedLoop);
+        nestedDOALLInvocations += profiles->getInvocations(nestedLoop);
+      } else {
+        for (auto child : nestedLoop->getChildren()){
+          loopsToCheck.push(child);
+        }
+      }
+      delete nestedLDI;
+    }
+    if (nestedDOALLInsts == 0){
+      return maxCores;
+    }
+
+    /*
+     * Compute the fraction of time spent in the biggest sequential SCC of the loop.
+     * HELIX cannot run faster than this SCC, no matter how many cores it uses.
+     */
+    uint64_t biggestSCCInsts = 0;
+    for (auto sequentialSCC : DOALL::getSCCsThatBlockDOALLToBeApplicable(LDI, par)){
+      biggestSCCInsts = std::max(biggestSCCInsts, profiles->getTotalInstructions(sequentialSCC));
+    }
+    auto sequentialFraction = ((double)biggestSCCInsts) / loopInsts;
+
+    /*
+     * Compute the fraction of time spent in the nested DOALL loops and the overhead of dispatching them.
+     */
+    double dispatchCost = 2000;
+    auto nestedFraction = ((double)nestedDOALLInsts) / loopInsts;
+    auto dispatchFraction = (((double)nestedDOALLInvocations) * dispatchCost) / loopInsts;
+
+    /*
+     * Split the cores between HELIX (outer level) and the nested DOALL loops (inner level).
+     *
+     * The time of the loop (normalized to its sequential time) is estimated as
+     *    max(sequentialFraction, ((1 - nestedFraction) + (nestedFraction / innerCores) + dispatchFraction) / outerCores)
+     * Ties are broken in favor of the outer level as it does not pay the dispatch overhead at every iteration.
+     */
+    uint32_t bestOuterCores = maxCores;
+    auto bestTime = std::max(sequentialFraction, 1.0 / ((double)maxCores));
+    for (uint32_t outerCores = maxCores / 2; outerCores >= 2; outerCores--){
+      auto innerCores = maxCores / outerCores;
+      auto iterationTime = (1 - nestedFraction) + (nestedFraction / innerCores) + dispatchFraction;
+      auto time = std::max(sequentialFraction, iterationTime / outerCores);
+      if (time < bestTime){
+        bestTime = time;
+        bestOuterCores = outerCores;
+        (*coresPerNestedDOALL) = innerCores;
+      }
+    }
+
+    /*
+     * Print the decision.
+     */
+    if (par.getVerbosity() != Verbosity::Disabled){
+      errs() << "Parallelizer:  Nested parallelism\n";
+      errs() << "Parallelizer:    Time in nested DOALL loops = " << (nestedFraction * 100) << "%\n";
+      errs() << "Parallelizer:    Time in the biggest sequential SCC = " << (sequentialFraction * 100) << "%\n";
+      errs() << "Parallelizer:    Cores for the loop = " << bestOuterCores << "\n";
+      errs() << "Parallelizer:    Cores for each nested DOALL loop = " << (*coresPerNestedDOALL) << "\n";
+    }
+
+    return bestOuterCores;
+  }
+
+  LoopDependenceInfo * Parallelizer::fetchNextNestedDOALL (
+    Function *taskFunction,
+    Noelle &par,
+    DOALL &doall,
+    Heuristics *h,
+    std::unordered_set<BasicBlock *> &checkedHeaders
+    ){
+
+    /*
+     * The task has been generated (or modified) after the dependences of the program have been computed.
+     * Hence, the dependences of the task must be computed from its current code.
+     */
+    par.invalidateFunctionDependenceGraph(taskFunction);
+
+    /*
+     * The outermost loops of a task are the clones of the parallelized loop.
+     * Look for the outermost DOALL loops nested within them that have not been checked yet.
+     */
+    auto& LI = getAnalysis<LoopInfoWrapperPass>(*taskFunction).getLoopInfo();
+    std::vector<BasicBlock *> headersToCheck;
+    std::queue<Loop *> loopsToCheck;
+    for (auto topLoop : LI){
+      for (auto subLoop : topLoop->getSubLoops()){
+        loopsToCheck.push(subLoop);
+      }
+    }
+    while (!loopsToCheck.empty()){
+      auto loop = loopsToCheck.front();
+      loopsToCheck.pop();
+
+      /*
+       * DOALL loops that have been checked already are not considered again, and neither are the loops nested within them.
+       */
+      if (checkedHeaders.find(loop->getHeader()) != checkedHeaders.end()){
+        continue ;
+      }
+      headersToCheck.push_back(loop->getHeader());
+      for (auto subLoop : loop->getSubLoops()){
+        loopsToCheck.push(subLoop);
+      }
+    }
+
+    /*
+     * Check the loops from the outermost ones.
+     * The loops nested within a DOALL loop are never reached: the DOALL loop is returned first and, once checked, it is skipped together with its nested loops.
+     * The LLVM loop analyses are fetched again for every loop as building a loop abstraction invalidates them.
+     */
+    for (auto header : headersToCheck){
+      auto& currentLI = getAnalysis<LoopInfoWrapperPass>(*taskFunction).getLoopInfo();
+      auto loop = currentLI.getLoopFor(header);
+
+      /*
+       * Check if the loop is DOALL.
+       */
+      LoopStructure ls{loop};
+      if (ls.getPreHeader() == nullptr){
+        continue ;
+      }
+      auto nestedLDI = par.getLoop(&ls);
+      if (doall.canBeAppliedToLoop(nestedLDI, par, h)){
+        checkedHeaders.insert(header);
+        return nestedLDI;
+      }
+      delete nestedLDI;
+    }
+
+    return nullptr;
+  }
+
+  bool Parallelizer::parallelizeNestedDOALLs (
+    LoopDependenceInfo *LDI,
+    Noelle &par,
+    ParallelizationTechnique &outerTechnique,
+    uint32_t coresPerNestedDOALL,
+    DSWP &dswp,
+    DOALL &doall,
+    HELIX &helix,
+    Heuristics *h
+    ){
+    auto taskFunctions = outerTechnique.getTaskFunctions();
+
+    /*
+     * If the split of the cores has not been decided yet (e.g., DSWP), the tasks use one core each.
+     * The cores left are split evenly between the tasks that include nested DOALL loops.
+     * The runtime grants these cores only if they are idle when the nested loop starts (e.g., they are not used by replicas of stages).
+     */
+    if (coresPerNestedDOALL == 0){
+      uint32_t tasksWithNestedDOALLs = 0;
+      for (auto taskFunction : taskFunctions){
+        std::unordered_set<BasicBlock *> checkedHeaders;
+        auto nestedLDI = this->fetchNextNestedDOALL(taskFunction, par, doall, h, checkedHeaders);
+        if (nestedLDI != nullptr){
+          tasksWithNestedDOALLs++;
+          delete nestedLDI;
+        }
+      }
+      if (tasksWithNestedDOALLs == 0){
+        return false;
+      }
+      auto maxCores = LDI->getMaximumNumberOfCores();
+      auto outerCores = (uint32_t)taskFunctions.size();
+      coresPerNestedDOALL = 1;
+      if (maxCores > outerCores){
+        coresPerNestedDOALL += (maxCores - outerCores) / tasksWithNestedDOALLs;
+      }
+    }
+    if (coresPerNestedDOALL <= 1){
+      return false;
+    }
+
+    /*
+     * Parallelize the nested loops.
+     * A nested loop is parallelized before the next one is analyzed: the code of the task changes after every parallelization.
+     */
+    auto modified = false;
+    for (auto taskFunction : taskFunctions){
+      std::unordered_set<BasicBlock *> checkedHeaders;
+      while (auto nestedLDI = this->fetchNextNestedDOALL(taskFunction, par, doall, h, checkedHeaders)){
+        nestedLDI->setMaximumNumberOfCores(coresPerNestedDOALL);
+        nestedLDI->disableTransformation(DSWP_ID);
+        nestedLDI->disableTransformation(HELIX_ID);
+        if (this->parallelizeLoop(nestedLDI, par, dswp, doall, helix, h)){
+          errs() << "Parallelizer:    Nested loop " << nestedLDI->getID() << " has been parallelized with " << coresPerNestedDOALL << " cores\n";
+          modified = true;
+        }
+        delete nestedLDI;
+      }
+    }
+
+    return modified;
+  }
+}
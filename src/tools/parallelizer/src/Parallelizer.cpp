@@ -61,6 +61,8 @@ namespace llvm::noelle {
      */
     auto codeModified = false;
     ParallelizationTechnique *usedTechnique = nullptr;
+    uint32_t coresPerNestedDOALL = 0;
+    uint32_t outerCoresWithNestedDOALLs = 0;
     if (  true
         && par.isTransformationEnabled(DOALL_ID)
         && LDI->isTransformationEnabled(DOALL_ID)
@@ -80,6 +82,14 @@ namespace llvm::noelle {
         && helix.canBeAppliedToLoop(LDI, par, h)   
         ){
 
+      /*
+       * Split the cores between HELIX and the DOALL loops nested within the loop.
+       * HELIX is generated for all cores: it will be limited to its share only if a nested DOALL loop gets parallelized.
+       */
+      if (this->enableNestedParallelism){
+        outerCoresWithNestedDOALLs = this->selectNumberOfCoresForHELIXWithNestedDOALLs(LDI, par, doall, h, &coresPerNestedDOALL);
+      }
+
       /*
        * Apply HELIX
        */
@@ -153,7 +163,7 @@ namespace llvm::noelle {
     if (verbose != Verbosity::Disabled) {
       errs() << "Parallelizer:  Link the parallelize loop\n";
     }
-    auto exitIndex = cast<Value>(ConstantInt::get(par.int64, LDI->environment->indexOfExitBlockTaken()));
+    auto exitIndex = cast<Value>(ConstantInt::get(par.int64, LDI->getEnvironment()->indexOfExitBlockTaken()));
     auto loopExitBlocks = loopStructure->getLoopExitBasicBlocks();
     par.linkTransformedLoopToOriginalFunction(
         loopFunction->getParent(),
@@ -165,6 +175,42 @@ namespace llvm::noelle {
         loopExitBlocks
         );
     assert(par.verifyCode());
+
+    /*
+     * Parallelize the DOALL loops nested within the tasks of a pipeline or of HELIX (nested parallelism).
+     * These loops share the cores of the program with the outer parallelization through the runtime.
+     */
+    if (  true
+          && this->enableNestedParallelism
+          && (usedTechnique != &doall)
+       ){
+      auto nestedDOALLsParallelized = this->parallelizeNestedDOALLs(LDI, par, *usedTechnique, coresPerNestedDOALL, dswp, doall, helix, h);
+
+      /*
+       * Leave to the nested DOALL loops the cores HELIX does not need.
+       */
+      if (  true
+            && nestedDOALLsParallelized
+            && (usedTechnique == &helix)
+            && (outerCoresWithNestedDOALLs > 0)
+         ){
+        helix.limitNumberOfCores(par, outerCoresWithNestedDOALLs);
+      }
+    }
+
+    /*
+     * Replace the multiplications of induction variables within the tasks (e.g., those introduced by the chunking of DOALL) with additions.
+     */
+    if (par.isTransformationEnabled(SCEV_SIMPLIFICATION_ID)){
+      this->reduceStrengthOfTaskLoops(*usedTechnique, par);
+    }
+
+    /*
+     * Unroll the loops of the DOALL and HELIX tasks so every iteration of a chunk does more work per check of the loop control.
+     */
+    if (usedTechnique != &dswp){
+      this->unrollTaskLoops(*usedTechnique, par);
+    }
     // if (verbose >= Verbosity::Maximal) {
     //   loopFunction->print(errs() << "Final printout:\n"); errs() << "\n";
     // }
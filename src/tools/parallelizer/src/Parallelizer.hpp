@@ -26,6 +26,7 @@
 #include "llvm/Analysis/ScalarEvolutionExpressions.h"
 #include "llvm/IR/Dominators.h"
 #include "llvm/Analysis/AssumptionCache.h"
+#include "llvm/Analysis/DependenceAnalysis.h"
 #include "llvm/IR/Mangler.h"
 #include "llvm/IR/IRBuilder.h"
 
@@ -36,6 +37,7 @@
 #include "SCCDAG.hpp"
 #include "Noelle.hpp"
 #include "HeuristicsPass.hpp"
+#include "SCEVSimplification.hpp"
 #include "DSWP.hpp"
 #include "DOALL.hpp"
 #include "HELIX.hpp"
@@ -65,6 +67,9 @@ namespace llvm::noelle {
        */
       bool forceParallelization;
       bool forceNoSCCPartition;
+      bool forceNoStageReplication;
+      bool enableNestedParallelism;
+      uint32_t taskUnrollFactor;
 
       /*
        * Methods
@@ -88,6 +93,52 @@ namespace llvm::noelle {
         noelle::StayConnectedNestedLoopForestNode *tree
         ) ;
 
+      /*
+       * Nested parallelism
+       */
+      uint32_t selectNumberOfCoresForHELIXWithNestedDOALLs (
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        DOALL &doall,
+        Heuristics *h,
+        uint32_t *coresPerNestedDOALL
+      );
+
+      LoopDependenceInfo * fetchNextNestedDOALL (
+        Function *taskFunction,
+        Noelle &par,
+        DOALL &doall,
+        Heuristics *h,
+        std::unordered_set<BasicBlock *> &checkedHeaders
+      );
+
+      bool parallelizeNestedDOALLs (
+        LoopDependenceInfo *LDI,
+        Noelle &par,
+        ParallelizationTechnique &outerTechnique,
+        uint32_t coresPerNestedDOALL,
+        DSWP &dswp,
+        DOALL &doall,
+        HELIX &helix,
+        Heuristics *h
+      );
+
+      /*
+       * Strength reduction of the multiplications of induction variables within the generated tasks
+       */
+      bool reduceStrengthOfTaskLoops (
+        ParallelizationTechnique &technique,
+        Noelle &par
+      );
+
+      /*
+       * Unrolling of the loops within the generated tasks
+       */
+      bool unrollTaskLoops (
+        ParallelizationTechnique &technique,
+        Noelle &par
+      );
+
       /*
        * Debug utilities
        */
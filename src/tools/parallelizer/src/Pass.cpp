@@ -19,12 +19,18 @@ using namespace llvm::noelle;
  */
 static cl::opt<bool> ForceParallelization("noelle-parallelizer-force", cl::ZeroOrMore, cl::Hidden, cl::desc("Force the parallelization"));
 static cl::opt<bool> ForceNoSCCPartition("dswp-no-scc-merge", cl::ZeroOrMore, cl::Hidden, cl::desc("Force no SCC merging when parallelizing"));
+static cl::opt<bool> ForceNoStageReplication("dswp-no-stage-replication", cl::ZeroOrMore, cl::Hidden, cl::desc("Force no replication of stateless DSWP stages (PS-DSWP)"));
+static cl::opt<int> TaskUnrollFactor("noelle-parallelizer-task-unroll-factor", cl::ZeroOrMore, cl::Hidden, cl::init(1), cl::desc("Number of times the loops of the DOALL and HELIX tasks are unrolled (1 means no unrolling)"));
+static cl::opt<bool> DisableNestedParallelism("noelle-parallelizer-no-nested-parallelism", cl::ZeroOrMore, cl::Hidden, cl::desc("Disable the parallelization of DOALL loops nested within DSWP and HELIX loops"));
 
 Parallelizer::Parallelizer()
   :
     ModulePass{ID}, 
     forceParallelization{false},
-    forceNoSCCPartition{false}
+    forceNoSCCPartition{false},
+    forceNoStageReplication{false},
+    enableNestedParallelism{true},
+    taskUnrollFactor{1}
 {
 
   return ;
@@ -33,6 +39,9 @@ Parallelizer::Parallelizer()
 bool Parallelizer::doInitialization (Module &M) {
   this->forceParallelization = (ForceParallelization.getNumOccurrences() > 0);
   this->forceNoSCCPartition = (ForceNoSCCPartition.getNumOccurrences() > 0);
+  this->forceNoStageReplication = (ForceNoStageReplication.getNumOccurrences() > 0);
+  this->enableNestedParallelism = (DisableNestedParallelism.getNumOccurrences() == 0);
+  this->taskUnrollFactor = TaskUnrollFactor.getValue();
 
   return false; 
 }
@@ -64,6 +73,7 @@ bool Parallelizer::runOnModule (Module &M) {
       *profiles,
       this->forceParallelization,
       !this->forceNoSCCPartition,
+      !this->forceNoStageReplication,
       verbosity
   };
   DOALL doall{
@@ -303,6 +313,8 @@ void Parallelizer::getAnalysisUsage (AnalysisUsage &AU) const {
   AU.addRequired<ScalarEvolutionWrapperPass>();
   AU.addRequired<DominatorTreeWrapperPass>();
   AU.addRequired<PostDominatorTreeWrapperPass>();
+  AU.addRequired<AssumptionCacheTracker>();
+  AU.addRequired<DependenceAnalysisWrapperPass>();
 
   /*
    * Noelle.
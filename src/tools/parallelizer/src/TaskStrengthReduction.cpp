@@ -0,0 +1,76 @@
+/*
+ * Copyright 2020 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "Parallelizer.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+namespace llvm::noelle {
+
+  bool Parallelizer::reduceStrengthOfTaskLoops (
+    ParallelizationTechnique &technique,
+    Noelle &par
+    ){
+
+    /*
+     * Reduce the strength of the multiplications of every loop of every task.
+     * Building a loop abstraction fetches the loops of the task again, which frees the ones fetched before.
+     * Hence, the headers of the loops are collected first and every loop is fetched again from its header.
+     */
+    auto verbose = par.getVerbosity();
+    auto modified = false;
+    SCEVSimplification scevSimplification(par);
+    for (auto taskFunction : technique.getTaskFunctions()){
+
+      /*
+       * The loop abstractions of the task must be built from its current code rather than from the dependences computed before the task was generated.
+       */
+      par.invalidateFunctionDependenceGraph(taskFunction);
+
+      auto& taskLI = getAnalysis<LoopInfoWrapperPass>(*taskFunction).getLoopInfo();
+      std::vector<BasicBlock *> loopHeaders;
+      for (auto loop : taskLI.getLoopsInPreorder()){
+        loopHeaders.push_back(loop->getHeader());
+      }
+      for (auto header : loopHeaders){
+        auto& LI = getAnalysis<LoopInfoWrapperPass>(*taskFunction).getLoopInfo();
+        auto loop = LI.getLoopFor(header);
+        if (  false
+              || (loop == nullptr)
+              || (loop->getHeader() != header)
+           ){
+          continue ;
+        }
+        LoopStructure ls{loop};
+        if (ls.getPreHeader() == nullptr){
+          continue ;
+        }
+        auto LDI = par.getLoop(&ls);
+        auto reduced = scevSimplification.reduceStrengthOfIVMultiplications(*LDI);
+        delete LDI;
+        if (!reduced){
+          continue ;
+        }
+        if (verbose != Verbosity::Disabled) {
+          errs() << "Parallelizer:  Reduced the strength of multiplications in a loop of the task " << taskFunction->getName() << "\n";
+        }
+        modified = true;
+
+        /*
+         * The new induction variables are not part of the dependences of the task yet.
+         */
+        par.invalidateFunctionDependenceGraph(taskFunction);
+      }
+    }
+
+    return modified;
+  }
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2020 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "Parallelizer.hpp"
+#include "LoopUnroll.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+namespace llvm::noelle {
+
+  bool Parallelizer::unrollTaskLoops (
+    ParallelizationTechnique &technique,
+    Noelle &par
+    ){
+
+    /*
+     * Check if the loops of the tasks need to be unrolled.
+     */
+    if (this->taskUnrollFactor < 2){
+      return false;
+    }
+
+    /*
+     * Unroll the outermost loop of every task (e.g., the loop that iterates over the chunks of DOALL).
+     */
+    auto verbose = par.getVerbosity();
+    auto modified = false;
+    LoopUnroll loopUnroll{};
+    for (auto taskFunction : technique.getTaskFunctions()){
+
+      /*
+       * Compute the dependences of the task from its current code (e.g., nested DOALL loops may have been parallelized within it).
+       */
+      par.invalidateFunctionDependenceGraph(taskFunction);
+
+      /*
+       * Fetch the outermost loops of the task.
+       */
+      auto& taskLI = getAnalysis<LoopInfoWrapperPass>(*taskFunction).getLoopInfo();
+      std::vector<BasicBlock *> topLoopHeaders;
+      for (auto topLoop : taskLI){
+        topLoopHeaders.push_back(topLoop->getHeader());
+      }
+      for (auto header : topLoopHeaders){
+
+        /*
+         * The LLVM analyses are fetched again for every loop as building a loop abstraction and unrolling a loop invalidate them.
+         */
+        auto& currentLI = getAnalysis<LoopInfoWrapperPass>(*taskFunction).getLoopInfo();
+        auto topLoop = currentLI.getLoopFor(header);
+        if (  false
+              || (topLoop == nullptr)
+              || (topLoop->getHeader() != header)
+           ){
+          continue ;
+        }
+        LoopStructure ls{topLoop};
+        if (ls.getPreHeader() == nullptr){
+          continue ;
+        }
+
+        /*
+         * Count the sub-loops before building the loop abstraction, which frees the loops of the task fetched so far.
+         */
+        auto numberOfSubLoops = topLoop->getSubLoops().size();
+        auto LDI = par.getLoop(&ls);
+        auto& LI = getAnalysis<LoopInfoWrapperPass>(*taskFunction).getLoopInfo();
+        auto& DT = getAnalysis<DominatorTreeWrapperPass>(*taskFunction).getDomTree();
+        auto& SE = getAnalysis<ScalarEvolutionWrapperPass>(*taskFunction).getSE();
+        auto& AC = getAnalysis<AssumptionCacheTracker>().getAssumptionCache(*taskFunction);
+        auto& DI = getAnalysis<DependenceAnalysisWrapperPass>(*taskFunction).getDI();
+
+        /*
+         * Loops with a single sub-loop are unrolled and jammed.
+         * This keeps the sub-loop as a single loop, which now executes the work of several iterations of the outer loop.
+         * Loops without sub-loops are partially unrolled.
+         */
+        auto unrolled = false;
+        if (numberOfSubLoops == 1){
+          if (verbose != Verbosity::Disabled) {
+            errs() << "Parallelizer:  Try to unroll and jam the loop of the task " << taskFunction->getName() << "\n";
+          }
+          unrolled = loopUnroll.unrollAndJamLoop(*LDI, this->taskUnrollFactor, LI, DT, SE, AC, DI);
+
+        } else if (numberOfSubLoops == 0){
+          if (verbose != Verbosity::Disabled) {
+            errs() << "Parallelizer:  Try to unroll the loop of the task " << taskFunction->getName() << "\n";
+          }
+          unrolled = loopUnroll.partiallyUnrollLoop(*LDI, this->taskUnrollFactor, LI, DT, SE, AC);
+        }
+        delete LDI;
+
+        /*
+         * The dependences, the dominators, and the loops of the task do not describe its code anymore.
+         */
+        if (unrolled){
+          par.invalidateFunctionDependenceGraph(taskFunction);
+          par.invalidateLoopNestingForest(taskFunction);
+          modified = true;
+        }
+      }
+    }
+
+    return modified;
+  }
+}
@@ -140,7 +140,7 @@ void PDGStats::collectStatsForPotentialEdges (std::unordered_map<Function *, Sta
     for (auto loopTree : loopForest->getTrees()){
       auto visitor = [&totLoads, &totStores, &totCalls](StayConnectedNestedLoopForestNode *n, uint32_t level) -> bool {
         auto currentLoop = n->getLoop();
-        for (auto inst : currentLoop->getInstructions()){
+        for (auto inst : currentLoop->instructions()){
           if (isa<LoadInst>(inst)){
             totLoads++;
             continue ;
@@ -0,0 +1,40 @@
+/*
+ * Copyright 2020 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "PipelineDriver.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+static cl::opt<std::string> ProfileFile("noelle-pipeline-profile", cl::ZeroOrMore, cl::Hidden, cl::init(""), cl::desc("Profiles (merged by llvm-profdata) to embed before transforming the code"));
+static cl::opt<bool> DisableInliner("noelle-pipeline-no-inliner", cl::ZeroOrMore, cl::Hidden, cl::desc("Do not run the inliner within the pipeline"));
+static cl::opt<bool> DisableParallelizer("noelle-pipeline-no-parallelizer", cl::ZeroOrMore, cl::Hidden, cl::desc("Stop the pipeline before the parallelization"));
+static cl::opt<int> MaximumFixedPointIterations("noelle-pipeline-max-iterations", cl::ZeroOrMore, cl::Hidden, cl::init(100), cl::desc("Maximum number of invocations of a stage that runs until a fixed point"));
+
+bool PipelineDriver::doInitialization (Module &M) {
+  this->profileFile = ProfileFile.getValue();
+  this->enableInliner = (DisableInliner.getNumOccurrences() == 0) ? true : false;
+  this->enableParallelizer = (DisableParallelizer.getNumOccurrences() == 0) ? true : false;
+  this->maximumFixedPointIterations = MaximumFixedPointIterations.getValue();
+
+  return false;
+}
+
+void PipelineDriver::getAnalysisUsage (AnalysisUsage &AU) const {
+
+  /*
+   * Every stage computes the analyses it needs within the pipeline.
+   */
+  return ;
+}
+
+// Next there is code to register your pass to "opt"
+char PipelineDriver::ID = 0;
+static RegisterPass<PipelineDriver> X("noelle-pipeline", "Run the NOELLE pipeline, from the normalization to the parallelization, within a single invocation");
@@ -0,0 +1,319 @@
+/*
+ * Copyright 2020 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "PipelineDriver.hpp"
+#include "Inliner.hpp"
+#include "llvm/Transforms/Instrumentation.h"
+#include <sys/resource.h>
+
+namespace llvm::noelle {
+
+  /*
+   * Alias analyses and analyses NOELLE relies on (see noelle-load).
+   */
+  static const std::vector<std::string> NOELLE_ANALYSES = {
+    "globals-aa", "cfl-steens-aa", "tbaa", "scoped-noalias", "scev-aa", "cfl-anders-aa",
+    "scalar-evolution", "loops", "domtree", "postdomtree", "noellescaf", "noellesvf"
+  };
+
+  /*
+   * Passes of noelle-norm.
+   */
+  static const std::vector<std::string> NORMALIZATION_PASSES = {
+    "basicaa", "mem2reg", "break-constgeps", "lowerswitch", "mergereturn", "break-crit-edges", "loop-simplify", "lcssa", "indvars"
+  };
+
+  /*
+   * Passes of noelle-simplification.
+   */
+  static const std::vector<std::string> SIMPLIFICATION_PASSES = {
+    "basicaa", "mem2reg", "simplifycfg", "instcombine", "tailcallelim", "loop-simplify", "lcssa", "licm", "loop-unswitch", "globalopt", "instcombine", "ipsccp", "dce", "gvn", "dse", "adce", "loop-simplify", "lcssa", "indvars", "loop-deletion", "instcombine", "indvars",
+    "break-constgeps", "lowerswitch", "mergereturn", "break-crit-edges", "loop-simplify", "lcssa"
+  };
+
+  /*
+   * Passes that are registered only when the library that provides them has been loaded.
+   * Like noelle-norm and noelle-simplification (see WPAPASSINV), they are skipped when they are not available.
+   */
+  static const std::set<std::string> OPTIONAL_PASSES = {
+    "break-constgeps"
+  };
+
+  PipelineDriver::PipelineDriver ()
+    : ModulePass{ID}
+    {
+    return ;
+  }
+
+  bool PipelineDriver::runOnModule (Module &M) {
+    errs() << "NOELLE: Pipeline: Start\n";
+
+    /*
+     * The enablers reach their fixed point within a single invocation.
+     * Hence, NOELLE and the dependence graphs are computed once for all enablers, and only the abstractions of the functions they modify are computed again.
+     */
+    this->setOption("noelle-enablers-fixed-point", "true");
+
+    /*
+     * Normalize and simplify the code as noelle-norm and noelle-simplification do.
+     */
+    this->setOption("simplifycfg-sink-common", "false");
+
+    /*
+     * Embed the profiles.
+     * The profiles have been collected on the input bitcode, so they must be embedded before changing it.
+     */
+    auto modified = false;
+    if (this->profileFile != ""){
+      modified |= this->runStage("Profile embedding", [this, &M](void) -> bool {
+        return this->embedProfiles(M);
+      });
+    }
+
+    /*
+     * Prepare the code (see noelle-pre).
+     */
+    modified |= this->runStage("Debug information removal", [this, &M](void) -> bool {
+      return this->runPasses(M, { "strip-debug", "strip-debug-declare" });
+    });
+    modified |= this->runStage("Dead function elimination", [this, &M](void) -> bool {
+      return this->runUntilFixedPoint(M, { "noelle-dfe" });
+    });
+    modified |= this->runStage("Simplification", [this, &M](void) -> bool {
+      return this->simplify(M);
+    });
+    if (this->enableInliner){
+      modified |= this->runStage("Inlining", [this, &M](void) -> bool {
+        return this->inlineFunctions(M);
+      });
+      modified |= this->runStage("Simplification after inlining", [this, &M](void) -> bool {
+        return this->simplify(M);
+      });
+      modified |= this->runStage("Dead function elimination after inlining", [this, &M](void) -> bool {
+        return this->runUntilFixedPoint(M, { "noelle-dfe" });
+      });
+      modified |= this->runStage("Simplification after dead function elimination", [this, &M](void) -> bool {
+        return this->simplify(M);
+      });
+    }
+    modified |= this->runStage("Enablers", [this, &M](void) -> bool {
+      auto modified = this->normalize(M);
+      modified |= this->runNOELLEPasses(M, { "enablers" });
+      return modified;
+    });
+    modified |= this->runStage("Simplification after enablers", [this, &M](void) -> bool {
+      return this->simplify(M);
+    });
+    modified |= this->runStage("Loop metadata embedding", [this, &M](void) -> bool {
+      return this->runNOELLEPasses(M, { "LoopMetadata" });
+    });
+
+    /*
+     * Parallelize the code (see noelle-parallelizer).
+     */
+    if (this->enableParallelizer){
+      modified |= this->runStage("Parallelization", [this, &M](void) -> bool {
+        return this->runNOELLEPasses(M, { "heuristics", "parallelizer" });
+      });
+      modified |= this->runStage("Loop metadata embedding after parallelization", [this, &M](void) -> bool {
+        return this->runNOELLEPasses(M, { "LoopMetadata" });
+      });
+    }
+
+    /*
+     * Print the statistics of the stages.
+     */
+    this->printReport();
+
+    errs() << "NOELLE: Pipeline: Exit\n";
+    return modified;
+  }
+
+  bool PipelineDriver::runStage (
+    std::string const &name,
+    std::function<bool (void)> stage
+    ){
+    errs() << "NOELLE: Pipeline:   Stage \"" << name << "\"\n";
+
+    /*
+     * Run the stage.
+     */
+    auto start = std::chrono::steady_clock::now();
+    auto modified = stage();
+    auto end = std::chrono::steady_clock::now();
+
+    /*
+     * Collect the statistics.
+     * The peak resident set size is the one of the process until the end of this stage.
+     */
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    StageStatistics stats;
+    stats.name = name;
+    stats.seconds = std::chrono::duration<double>(end - start).count();
+    stats.peakRSSInKB = usage.ru_maxrss;
+    stats.modified = modified;
+    this->stages.push_back(stats);
+    errs() << "NOELLE: Pipeline:     Time = " << stats.seconds << " seconds, peak RSS = " << stats.peakRSSInKB << " KB\n";
+
+    return modified;
+  }
+
+  bool PipelineDriver::runPasses (
+    Module &M,
+    std::vector<std::string> const &passNames,
+    std::function<void (std::string const &, Pass *)> configurePass
+    ){
+
+    /*
+     * Create the passes.
+     * All of them must have been loaded (see noelle-pipeline).
+     */
+    legacy::PassManager pm;
+    auto registry = PassRegistry::getPassRegistry();
+    for (auto &passName : passNames){
+      auto passInfo = registry->getPassInfo(passName);
+      if (  (passInfo == nullptr)
+         && (OPTIONAL_PASSES.count(passName) > 0)  ){
+        continue ;
+      }
+      if (passInfo == nullptr){
+        errs() << "NOELLE: Pipeline: ERROR = pass \"" << passName << "\" is not available\n";
+        abort();
+      }
+      auto pass = passInfo->createPass();
+      if (configurePass){
+        configurePass(passName, pass);
+      }
+      pm.add(pass);
+    }
+
+    /*
+     * Run the passes on the in-memory module.
+     */
+    auto modified = pm.run(M);
+
+    return modified;
+  }
+
+  bool PipelineDriver::runNOELLEPasses (
+    Module &M,
+    std::vector<std::string> const &passNames,
+    std::function<void (std::string const &, Pass *)> configurePass
+    ){
+    auto allPasses = NOELLE_ANALYSES;
+    allPasses.insert(allPasses.end(), passNames.begin(), passNames.end());
+
+    return this->runPasses(M, allPasses, configurePass);
+  }
+
+  void PipelineDriver::setOption (
+    std::string const &name,
+    std::string const &value
+    ){
+    auto &options = cl::getRegisteredOptions();
+    auto option = options.find(name);
+    if (option == options.end()){
+      errs() << "NOELLE: Pipeline: ERROR = option \"" << name << "\" is not available\n";
+      abort();
+    }
+    option->second->addOccurrence(0, name, value);
+
+    return ;
+  }
+
+  bool PipelineDriver::runUntilFixedPoint (
+    Module &M,
+    std::vector<std::string> const &passNames
+    ){
+
+    /*
+     * Run the passes until they do not change the code anymore (see noelle-fixedpoint).
+     */
+    auto modified = false;
+    for (auto i = 0; i < this->maximumFixedPointIterations; i++){
+      errs() << "NOELLE: Pipeline:     Invocation " << i << "\n";
+      if (!this->runNOELLEPasses(M, passNames)){
+        return modified;
+      }
+      modified = true;
+
+      /*
+       * Normalize the code before the next invocation.
+       */
+      this->normalize(M);
+    }
+    errs() << "NOELLE: Pipeline:     The fixed point has not been reached after " << this->maximumFixedPointIterations << " invocations\n";
+
+    return modified;
+  }
+
+  bool PipelineDriver::normalize (Module &M){
+    return this->runPasses(M, NORMALIZATION_PASSES);
+  }
+
+  bool PipelineDriver::simplify (Module &M){
+    return this->runPasses(M, SIMPLIFICATION_PASSES);
+  }
+
+  bool PipelineDriver::embedProfiles (Module &M){
+    legacy::PassManager pm;
+    pm.add(createPGOInstrumentationUseLegacyPass(this->profileFile));
+
+    return pm.run(M);
+  }
+
+  bool PipelineDriver::inlineFunctions (Module &M){
+
+    /*
+     * The progress of the inliner across its invocations is kept in memory (noelle-inline keeps it in files instead).
+     */
+    Inliner::Progress progress;
+    auto attachProgress = [&progress](std::string const &passName, Pass *pass) -> void {
+      if (passName == "inliner"){
+        static_cast<Inliner *>(pass)->setProgress(&progress);
+      }
+    };
+
+    /*
+     * Inline calls within SCCs first, and then hoist loops to main.
+     */
+    auto modified = false;
+    for (auto hoistLoops : { false, true }){
+      progress.hoistLoopsToMain = hoistLoops;
+      progress.hasFunctionsToHoist = false;
+      progress.functionsToHoist.clear();
+      for (auto i = 0; i < this->maximumFixedPointIterations; i++){
+        progress.shouldInvokeAgain = false;
+        errs() << "NOELLE: Pipeline:     Inliner invocation " << i << (hoistLoops ? " (hoist loops to main)" : "") << "\n";
+        modified |= this->runNOELLEPasses(M, { "heuristics", "inliner" }, attachProgress);
+        modified |= this->normalize(M);
+        if (!progress.shouldInvokeAgain){
+          break ;
+        }
+      }
+    }
+
+    return modified;
+  }
+
+  void PipelineDriver::printReport (void) const {
+    errs() << "NOELLE: Pipeline:   Statistics\n";
+    auto totalSeconds = 0.0;
+    for (auto &stage : this->stages){
+      errs() << "NOELLE: Pipeline:     " << stage.name << ": " << stage.seconds << " seconds, peak RSS " << stage.peakRSSInKB << " KB" << (stage.modified ? ", modified the code" : "") << "\n";
+      totalSeconds += stage.seconds;
+    }
+    errs() << "NOELLE: Pipeline:     Total: " << totalSeconds << " seconds\n";
+
+    return ;
+  }
+
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2020 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+#include "SystemHeaders.hpp"
+
+namespace llvm::noelle {
+
+  class PipelineDriver : public ModulePass {
+    public:
+
+      /*
+       * Class fields
+       */
+      static char ID;
+
+      /*
+       * Methods
+       */
+      PipelineDriver ();
+
+      bool doInitialization (Module &M) override ;
+
+      bool runOnModule (Module &M) override ;
+
+      void getAnalysisUsage (AnalysisUsage &AU) const override ;
+
+    private:
+
+      /*
+       * Statistics of a stage of the pipeline.
+       */
+      struct StageStatistics {
+        std::string name;
+        double seconds;
+        uint64_t peakRSSInKB;
+        bool modified;
+      };
+
+      /*
+       * Fields
+       */
+      std::string profileFile;
+      bool enableInliner;
+      bool enableParallelizer;
+      uint32_t maximumFixedPointIterations;
+      std::vector<StageStatistics> stages;
+
+      /*
+       * Methods
+       */
+      bool runStage (
+        std::string const &name,
+        std::function<bool (void)> stage
+        );
+
+      bool runPasses (
+        Module &M,
+        std::vector<std::string> const &passNames,
+        std::function<void (std::string const &, Pass *)> configurePass = nullptr
+        );
+
+      bool runNOELLEPasses (
+        Module &M,
+        std::vector<std::string> const &passNames,
+        std::function<void (std::string const &, Pass *)> configurePass = nullptr
+        );
+
+      void setOption (
+        std::string const &name,
+        std::string const &value
+        );
+
+      bool runUntilFixedPoint (
+        Module &M,
+        std::vector<std::string> const &passNames
+        );
+
+      bool normalize (Module &M);
+
+      bool simplify (Module &M);
+
+      bool embedProfiles (Module &M);
+
+      bool inlineFunctions (Module &M);
+
+      void printReport (void) const ;
+  };
+
+}
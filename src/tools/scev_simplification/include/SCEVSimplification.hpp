@@ -39,6 +39,13 @@ namespace llvm::noelle {
         LoopDependenceInfo const &LDI
       );
 
+      /*
+       * Replace multiplications of a PHI of the header of the loop by a loop invariant with a new PHI that evolves by the scaled steps.
+       */
+      bool reduceStrengthOfIVMultiplications (
+        LoopDependenceInfo const &LDI
+      );
+
     private:
 
       const SCEV *getOffsetBetween (ScalarEvolution &SE, const SCEV *startSCEV, const SCEV *intermediateSCEV) ;
@@ -93,6 +100,23 @@ namespace llvm::noelle {
       ) const ;
       bool isPartOfShlShrTruncationPair (Instruction *I) const ;
 
+      bool isEvolutionScalable (
+        LoopStructure *loop,
+        PHINode *headerPHI,
+        Value *value,
+        std::unordered_set<Instruction *> &instructionsToScale
+      ) const ;
+
+      Value *scaleEvolution (
+        LoopStructure *loop,
+        PHINode *headerPHI,
+        PHINode *scaledPHI,
+        Value *value,
+        Value *factor,
+        IRBuilder<> &preheaderBuilder,
+        std::unordered_map<Value *, Value *> &scaledValues
+      ) ;
+
 
       /*
        * Fields
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2020 - 2021  Simone Campanoni
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "SCEVSimplification.hpp"
+
+using namespace llvm;
+using namespace llvm::noelle;
+
+/*
+ * A multiplication costs about as much as three additions.
+ */
+static const uint32_t ADDITIONS_PER_MULTIPLICATION = 3;
+
+bool SCEVSimplification::reduceStrengthOfIVMultiplications (
+  LoopDependenceInfo const &LDI
+) {
+
+  /*
+   * Fetch the loop information.
+   */
+  auto loopStructure = LDI.getLoopStructure();
+  auto loopHeader = loopStructure->getHeader();
+  auto loopPreheader = loopStructure->getPreHeader();
+  if (loopPreheader == nullptr){
+    return false;
+  }
+  auto ivManager = LDI.getInductionVariableManager();
+
+  /*
+   * Values that are defined before the loop starts can be used in its pre-header.
+   */
+  auto isAvailableInPreheader = [loopStructure](Value *value) -> bool {
+    if (auto inst = dyn_cast<Instruction>(value)){
+      return !loopStructure->isIncluded(inst);
+    }
+    return isa<Constant>(value) || isa<Argument>(value);
+  };
+
+  /*
+   * Collect the multiplications of the PHIs of the header by values available in the pre-header.
+   * Shifts to the left by a constant are multiplications by a power of two.
+   */
+  std::map<std::pair<PHINode *, Value *>, std::vector<Instruction *>> multiplications;
+  for (auto inst : loopStructure->instructions()){
+    auto binOp = dyn_cast<BinaryOperator>(inst);
+    if (  false
+          || (binOp == nullptr)
+          || (!binOp->getType()->isIntegerTy())
+       ){
+      continue ;
+    }
+    auto op0 = binOp->getOperand(0);
+    auto op1 = binOp->getOperand(1);
+    auto isHeaderPHI = [loopHeader](Value *value) -> bool {
+      auto phi = dyn_cast<PHINode>(value);
+      return (phi != nullptr) && (phi->getParent() == loopHeader);
+    };
+
+    switch (binOp->getOpcode()){
+      case Instruction::Mul:
+        if (isHeaderPHI(op0) && isAvailableInPreheader(op1)){
+          multiplications[std::make_pair(cast<PHINode>(op0), op1)].push_back(binOp);
+        } else if (isHeaderPHI(op1) && isAvailableInPreheader(op0)){
+          multiplications[std::make_pair(cast<PHINode>(op1), op0)].push_back(binOp);
+        }
+        break ;
+
+      case Instruction::Shl:
+        if (auto shiftAmount = dyn_cast<ConstantInt>(op1)){
+          auto bitWidth = binOp->getType()->getIntegerBitWidth();
+          if (  isHeaderPHI(op0)
+                && shiftAmount->getValue().ult(bitWidth)
+            ){
+            auto factor = ConstantInt::get(binOp->getType(), APInt::getOneBitSet(bitWidth, shiftAmount->getZExtValue()));
+            multiplications[std::make_pair(cast<PHINode>(op0), factor)].push_back(binOp);
+          }
+        }
+        break ;
+
+      default:
+        break ;
+    }
+  }
+  if (multiplications.size() == 0){
+    return false;
+  }
+
+  /*
+   * Reduce the strength of the multiplications.
+   *
+   * Multiplications distribute over the additions that evolve the PHI across iterations (modulo 2^n), so (phi + step) * factor = phi * factor + step * factor.
+   * Hence a new PHI that starts from start * factor and evolves by the scaled steps always holds phi * factor.
+   */
+  auto modified = false;
+  IRBuilder<> preheaderBuilder(loopPreheader->getTerminator());
+  IRBuilder<> headerBuilder(loopHeader->getFirstNonPHI());
+  for (auto &pair : multiplications){
+    auto headerPHI = pair.first.first;
+    auto factor = pair.first.second;
+    auto &multiplicationsToReduce = pair.second;
+
+    /*
+     * Check whether the IV manager knows the evolution of the PHI.
+     * In this case, the PHI is incremented by the same step at every iteration.
+     */
+    Value *ivStepValue = nullptr;
+    auto iv = ivManager->getInductionVariable(*loopStructure, headerPHI);
+    if (  true
+          && (iv != nullptr)
+          && (iv->getLoopEntryPHI() == headerPHI)
+          && iv->isStepValueLoopInvariant()
+       ){
+      ivStepValue = iv->getSingleComputedStepValue();
+      if (  false
+            || (ivStepValue == nullptr)
+            || (ivStepValue->getType() != headerPHI->getType())
+            || (!isAvailableInPreheader(ivStepValue))
+         ){
+        ivStepValue = nullptr;
+      }
+    }
+
+    /*
+     * Otherwise, the evolution of the PHI must be composed only by additions, subtractions, and selections of values.
+     * This is the case of the induction variables that iterate over chunks of iterations in the tasks generated by DOALL.
+     */
+    uint32_t instructionsAddedPerIteration = 0;
+    if (ivStepValue != nullptr){
+      instructionsAddedPerIteration = loopStructure->getLatches().size();
+
+    } else {
+      std::unordered_set<Instruction *> instructionsToScale;
+      auto isScalable = true;
+      for (auto i = 0u; i < headerPHI->getNumIncomingValues(); ++i){
+        if (headerPHI->getIncomingBlock(i) == loopPreheader){
+          continue ;
+        }
+        if (!this->isEvolutionScalable(loopStructure, headerPHI, headerPHI->getIncomingValue(i), instructionsToScale)){
+          isScalable = false;
+          break ;
+        }
+      }
+      if (!isScalable){
+        continue ;
+      }
+      instructionsAddedPerIteration = instructionsToScale.size();
+    }
+
+    /*
+     * Check if the reduction pays off.
+     */
+    if (instructionsAddedPerIteration > (ADDITIONS_PER_MULTIPLICATION * multiplicationsToReduce.size())){
+      continue ;
+    }
+    if (noelle.getVerbosity() >= Verbosity::Maximal) {
+      headerPHI->print(errs() << "SCEVSimplification:   Reduce the strength of " << multiplicationsToReduce.size() << " multiplications of "); errs() << "\n";
+    }
+
+    /*
+     * Create the new PHI.
+     */
+    auto scaledPHI = headerBuilder.CreatePHI(headerPHI->getType(), headerPHI->getNumIncomingValues(), "scaledIV");
+    std::unordered_map<Value *, Value *> scaledValues;
+    Value *scaledStep = nullptr;
+    if (ivStepValue != nullptr){
+      scaledStep = preheaderBuilder.CreateMul(ivStepValue, factor);
+    }
+    for (auto i = 0u; i < headerPHI->getNumIncomingValues(); ++i){
+      auto incomingBlock = headerPHI->getIncomingBlock(i);
+      auto incomingValue = headerPHI->getIncomingValue(i);
+      if (incomingBlock == loopPreheader){
+        scaledPHI->addIncoming(preheaderBuilder.CreateMul(incomingValue, factor), incomingBlock);
+        continue ;
+      }
+      if (scaledStep != nullptr){
+        IRBuilder<> latchBuilder(incomingBlock->getTerminator());
+        scaledPHI->addIncoming(latchBuilder.CreateAdd(scaledPHI, scaledStep), incomingBlock);
+        continue ;
+      }
+      auto scaledIncomingValue = this->scaleEvolution(loopStructure, headerPHI, scaledPHI, incomingValue, factor, preheaderBuilder, scaledValues);
+      scaledPHI->addIncoming(scaledIncomingValue, incomingBlock);
+    }
+
+    /*
+     * Replace the multiplications.
+     */
+    for (auto multiplication : multiplicationsToReduce){
+      multiplication->replaceAllUsesWith(scaledPHI);
+      multiplication->eraseFromParent();
+    }
+    modified = true;
+  }
+
+  return modified;
+}
+
+bool SCEVSimplification::isEvolutionScalable (
+  LoopStructure *loop,
+  PHINode *headerPHI,
+  Value *value,
+  std::unordered_set<Instruction *> &instructionsToScale
+) const {
+  if (value == headerPHI){
+    return true;
+  }
+
+  /*
+   * Values defined outside the loop are scaled in the pre-header.
+   */
+  auto inst = dyn_cast<Instruction>(value);
+  if (inst == nullptr){
+    return isa<Constant>(value) || isa<Argument>(value);
+  }
+  if (!loop->isIncluded(inst)){
+    return true;
+  }
+  if (instructionsToScale.find(inst) != instructionsToScale.end()){
+    return true;
+  }
+
+  /*
+   * Only additions, subtractions, and selections distribute the multiplication over their operands.
+   */
+  if (auto binOp = dyn_cast<BinaryOperator>(inst)){
+    if (  true
+          && (binOp->getOpcode() != Instruction::Add)
+          && (binOp->getOpcode() != Instruction::Sub)
+       ){
+      return false;
+    }
+    instructionsToScale.insert(inst);
+    return  true
+            && this->isEvolutionScalable(loop, headerPHI, binOp->getOperand(0), instructionsToScale)
+            && this->isEvolutionScalable(loop, headerPHI, binOp->getOperand(1), instructionsToScale)
+            ;
+  }
+  if (auto selectInst = dyn_cast<SelectInst>(inst)){
+    instructionsToScale.insert(inst);
+    return  true
+            && this->isEvolutionScalable(loop, headerPHI, selectInst->getTrueValue(), instructionsToScale)
+            && this->isEvolutionScalable(loop, headerPHI, selectInst->getFalseValue(), instructionsToScale)
+            ;
+  }
+
+  return false;
+}
+
+Value *SCEVSimplification::scaleEvolution (
+  LoopStructure *loop,
+  PHINode *headerPHI,
+  PHINode *scaledPHI,
+  Value *value,
+  Value *factor,
+  IRBuilder<> &preheaderBuilder,
+  std::unordered_map<Value *, Value *> &scaledValues
+) {
+  if (value == headerPHI){
+    return scaledPHI;
+  }
+  if (scaledValues.find(value) != scaledValues.end()){
+    return scaledValues.at(value);
+  }
+
+  /*
+   * Values defined outside the loop are scaled in the pre-header.
+   */
+  auto inst = dyn_cast<Instruction>(value);
+  if (  false
+        || (inst == nullptr)
+        || (!loop->isIncluded(inst))
+     ){
+    auto scaledValue = preheaderBuilder.CreateMul(value, factor);
+    scaledValues[value] = scaledValue;
+    return scaledValue;
+  }
+
+  /*
+   * Scale the operands and replicate the instruction right after the original one.
+   * isEvolutionScalable guarantees @inst is either an addition, a subtraction, or a selection.
+   */
+  IRBuilder<> builder(inst->getNextNode());
+  Value *scaledValue = nullptr;
+  if (auto selectInst = dyn_cast<SelectInst>(inst)){
+    auto scaledTrueValue = this->scaleEvolution(loop, headerPHI, scaledPHI, selectInst->getTrueValue(), factor, preheaderBuilder, scaledValues);
+    auto scaledFalseValue = this->scaleEvolution(loop, headerPHI, scaledPHI, selectInst->getFalseValue(), factor, preheaderBuilder, scaledValues);
+    scaledValue = builder.CreateSelect(selectInst->getCondition(), scaledTrueValue, scaledFalseValue);
+
+  } else {
+    auto binOp = cast<BinaryOperator>(inst);
+    auto scaledOp0 = this->scaleEvolution(loop, headerPHI, scaledPHI, binOp->getOperand(0), factor, preheaderBuilder, scaledValues);
+    auto scaledOp1 = this->scaleEvolution(loop, headerPHI, scaledPHI, binOp->getOperand(1), factor, preheaderBuilder, scaledValues);
+    scaledValue = builder.CreateBinOp(binOp->getOpcode(), scaledOp0, scaledOp1);
+  }
+  scaledValues[value] = scaledValue;
+
+  return scaledValue;
+}
@@ -0,0 +1,54 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct _N {
+  int v;
+  double w;
+  long z;
+  _N *next;
+} N;
+
+void appendNode (N* tail, int newValue, int howManyMore){
+
+  N *newNode = (N *) malloc(sizeof(N));
+  newNode->v = newValue;
+  newNode->w = newValue * 0.5;
+  newNode->z = newValue * 3;
+  newNode->next = NULL;
+
+  tail->next = newNode ;
+
+  if (howManyMore > 0){
+    appendNode(newNode, newValue+1, howManyMore - 1);
+  }
+
+  return ;
+}
+
+int main (){
+  N *n0 = (N *) malloc(sizeof(N));
+  n0->v = 41;
+  n0->w = 20.5;
+  n0->z = 123;
+
+  appendNode(n0, 42, 999);
+
+  /*
+   * The traversal of the list produces several values per iteration that are consumed by the stage that prints them.
+   * These values are packed into a single record per iteration.
+   */
+  long sum = 0;
+  N *tmpN = n0;
+  while (tmpN != NULL){
+    int v = tmpN->v;
+    double w = tmpN->w;
+    long z = tmpN->z;
+    sum += z;
+
+    printf("%d %f %ld %ld\n", v, w, z, sum);
+
+    tmpN = tmpN->next;
+  }
+
+  return 0;
+}
@@ -0,0 +1,44 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCRATCH_ELEMENTS 16
+
+static int globalScratch[SCRATCH_ELEMENTS];
+
+int main (int argc, char *argv[]){
+  auto iterations = 1000;
+  if (argc > 1){
+    iterations = atoi(argv[1]);
+  }
+  auto results = (long *) calloc(iterations, sizeof(long));
+  auto scratch = (int *) malloc(SCRATCH_ELEMENTS * sizeof(int));
+
+  /*
+   * The heap buffer and the global array are overwritten at the beginning of every iteration before being read.
+   * Hence, every worker can use its own private copy of them.
+   */
+  for (auto i = 0; i < iterations; i++){
+    memset(scratch, 0, SCRATCH_ELEMENTS * sizeof(int));
+    memset(globalScratch, 0, sizeof(globalScratch));
+    for (auto j = 0; j < SCRATCH_ELEMENTS; j++){
+      scratch[(i + j) % SCRATCH_ELEMENTS] += i * j;
+      globalScratch[(i * j) % SCRATCH_ELEMENTS] += scratch[j];
+    }
+
+    long value = 0;
+    for (auto j = 0; j < SCRATCH_ELEMENTS; j++){
+      value += scratch[j] ^ globalScratch[j];
+    }
+    results[i] = value;
+  }
+  free(scratch);
+
+  long sum = 0;
+  for (auto i = 0; i < iterations; i++){
+    sum += results[i];
+  }
+  printf("%ld\n", sum);
+
+  return 0;
+}
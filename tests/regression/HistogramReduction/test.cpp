@@ -0,0 +1,41 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BUCKETS 64
+#define LARGE_BUCKETS (1024 * 1024)
+
+static long histogram[BUCKETS];
+
+int main (int argc, char *argv[]){
+  auto iterations = 100000;
+  if (argc > 1){
+    iterations = atoi(argv[1]);
+  }
+  auto largeHistogram = (int *) calloc(LARGE_BUCKETS, sizeof(int));
+  double weights[BUCKETS] = { 0 };
+
+  /*
+   * The arrays are only updated by adding values that do not depend on them.
+   * Hence, the iterations can update them in any order.
+   */
+  for (auto i = 0; i < iterations; i++){
+    auto key = (i * 7919) % BUCKETS;
+    histogram[key]++;
+    weights[key] += ((double)i) / iterations;
+    largeHistogram[(i * 104729L) % LARGE_BUCKETS] -= i % 3;
+  }
+
+  long sum = 0;
+  double weightsSum = 0;
+  for (auto i = 0; i < BUCKETS; i++){
+    sum += histogram[i] * i;
+    weightsSum += weights[i];
+  }
+  for (auto i = 0; i < LARGE_BUCKETS; i++){
+    sum += largeHistogram[i];
+  }
+  free(largeHistogram);
+  printf("%ld %.3f\n", sum, weightsSum);
+
+  return 0;
+}
@@ -0,0 +1,40 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+static long accumulated = 0;
+
+static void __attribute__ ((noinline)) record (long *v, long i){
+  v[i] = v[i] * 2 + i;
+  accumulated += v[i];
+}
+
+static long __attribute__ ((noinline)) rarelyUsed (long *v, long i){
+  long t = 0;
+  for (auto j = 0; j < 10; j++){
+    t += v[(i + j) % 10] * j;
+  }
+  return t;
+}
+
+int main (int argc, char *argv[]){
+  auto iterations = 10003;
+  if (argc > 1){
+    iterations = atoi(argv[1]);
+  }
+  auto v = (long *) calloc(iterations, sizeof(long));
+
+  /*
+   * The hot call is involved in loop-carried dependences, so it is the first candidate to inline.
+   * The cold call is not executed by the profiled run.
+   */
+  for (auto i = 0; i < iterations; i++){
+    record(v, i);
+    if (i == (iterations + 1)){
+      accumulated += rarelyUsed(v, i);
+    }
+  }
+
+  printf("%ld\n", accumulated);
+
+  return 0;
+}
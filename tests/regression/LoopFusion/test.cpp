@@ -0,0 +1,38 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int main (int argc, char *argv[]){
+  auto elements = 10000;
+  if (argc > 1){
+    elements = atoi(argv[1]);
+  }
+  auto a = (long *) calloc(elements, sizeof(long));
+  auto b = (long *) calloc(elements, sizeof(long));
+  auto c = (long *) calloc(elements, sizeof(long));
+
+  /*
+   * The second loop reads only the element of a[] written by the same iteration of the first loop.
+   * Hence, the two loops can be fused and the fused loop is still DOALL.
+   */
+  for (auto i = 0; i < elements; i++){
+    a[i] = (i * 7) % 13;
+  }
+  for (auto i = 0; i < elements; i++){
+    b[i] = a[i] * 3 + i;
+  }
+
+  /*
+   * The next loop reads elements written by later iterations of the previous one, so it cannot be fused with it.
+   */
+  for (auto i = 0; i < elements; i++){
+    c[i] = b[elements - i - 1] + a[i];
+  }
+
+  long sum = 0;
+  for (auto i = 0; i < elements; i++){
+    sum += c[i];
+  }
+  printf("%ld\n", sum);
+
+  return 0;
+}
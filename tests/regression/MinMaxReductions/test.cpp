@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int main (int argc, char *argv[]){
+  auto iterations = 100000;
+  if (argc > 1){
+    iterations = atoi(argv[1]);
+  }
+  auto values = (int *) malloc(sizeof(int) * iterations);
+  auto weights = (double *) malloc(sizeof(double) * iterations);
+  for (auto i = 0; i < iterations; i++){
+    values[i] = (int)((i * 7919L) % 100003) - 50000;
+    weights[i] = ((double)((i * 104729L) % 1009)) / 7;
+  }
+
+  /*
+   * The variables evolve only by min/max, bitwise operations, and by keeping the position of a minimum.
+   * Hence, the iterations can update them in any order.
+   */
+  auto minimum = values[0];
+  auto maximum = values[0];
+  double maximumWeight = 0;
+  unsigned int orBits = 0;
+  unsigned int andBits = ~0U;
+  unsigned int xorBits = 0;
+  long positionOfMinimum = -1;
+  auto minimumAtPosition = 1000000;
+  for (auto i = 0; i < iterations; i++){
+    auto value = values[i];
+    minimum = value < minimum ? value : minimum;
+    maximum = value > maximum ? value : maximum;
+    maximumWeight = weights[i] > maximumWeight ? weights[i] : maximumWeight;
+    orBits |= value;
+    andBits &= value;
+    xorBits ^= value;
+    if ((value % 1000) < minimumAtPosition){
+      minimumAtPosition = value % 1000;
+      positionOfMinimum = i;
+    }
+  }
+  free(values);
+  free(weights);
+  printf("%d %d %.3f %u %u %u %ld %d\n", minimum, maximum, maximumWeight, orBits, andBits, xorBits, positionOfMinimum, minimumAtPosition);
+
+  return 0;
+}
@@ -0,0 +1,37 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+long total = 0;
+
+struct stats {
+  long sum;
+  long count;
+};
+
+int main (int argc, char *argv[]){
+  auto rows = 100;
+  auto columns = 200;
+  if (argc > 2){
+    rows = atoi(argv[1]);
+    columns = atoi(argv[2]);
+  }
+  auto m = (long *) calloc(rows * columns, sizeof(long));
+  for (auto i = 0; i < rows * columns; i++){
+    m[i] = i % 17;
+  }
+  auto s = (struct stats *) calloc(1, sizeof(struct stats));
+
+  /*
+   * The accumulators live in a global variable and in the fields of a structure, and they are updated by the inner loop only.
+   */
+  for (auto i = 0; i < rows; i++){
+    for (auto j = 0; j < columns; j++){
+      total += m[i * columns + j];
+      s->count++;
+    }
+    s->sum += i;
+  }
+  printf("%ld %ld %ld\n", total, s->sum, s->count);
+
+  return 0;
+}
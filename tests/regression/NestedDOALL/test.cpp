@@ -0,0 +1,42 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct _N {
+  int v;
+  _N *next;
+} N;
+
+int main (int argc, char *argv[]){
+  auto elements = 100;
+  auto values = 1000;
+  if (argc > 1){
+    elements = atoi(argv[1]);
+  }
+
+  /*
+   * Create the list.
+   */
+  N *head = nullptr;
+  for (auto i = 0; i < elements; i++){
+    auto n = (N *) malloc(sizeof(N));
+    n->v = i;
+    n->next = head;
+    head = n;
+  }
+  auto array = (long *) calloc(values, sizeof(long));
+
+  /*
+   * The outer loop carries a dependence (the traversal of the list), so it cannot be DOALL.
+   * The inner loop is DOALL and it can run in parallel within the stage (or the iteration) that includes it.
+   */
+  long sum = 0;
+  for (auto n = head; n != nullptr; n = n->next){
+    for (auto j = 0; j < values; j++){
+      array[j] = array[j] + ((n->v * j) % 7);
+    }
+    sum += array[n->v % values];
+  }
+  printf("%ld\n", sum);
+
+  return 0;
+}
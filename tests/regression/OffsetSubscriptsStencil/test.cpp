@@ -0,0 +1,53 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#define N 512
+
+static double A[N][N];
+static double B[N][N];
+
+int main (int argc, char *argv[]){
+  auto steps = 10;
+  if (argc > 1){
+    steps = atoi(argv[1]);
+  }
+  for (auto i = 0; i < N; i++){
+    for (auto j = 0; j < N; j++){
+      A[i][j] = ((double)((i * 7919L + j) % 1009)) / 7;
+      B[i][j] = 0;
+    }
+  }
+
+  for (auto t = 0; t < steps; t++){
+
+    /*
+     * The rows read by an iteration of the outer loop are only written by the other loop nest.
+     * Hence, the iterations of the outer loop are independent.
+     */
+    for (auto i = 1; i < N - 1; i++){
+      for (auto j = 1; j < N - 1; j++){
+        B[i][j] = 0.2 * (A[i][j] + A[i - 1][j] + A[i + 1][j] + A[i][j - 1] + A[i][j + 1]);
+      }
+    }
+
+    /*
+     * The element written by an iteration is read by the next iteration of the outer loop (distance 1).
+     * The element read at an offset of both subscripts is never written by the inner loop.
+     */
+    for (auto i = 1; i < N - 1; i++){
+      for (auto j = 1; j < N - 1; j++){
+        A[i][j] = B[i][j] + 0.1 * A[i - 1][j + 1];
+      }
+    }
+  }
+
+  auto sum = 0.0;
+  for (auto i = 0; i < N; i++){
+    for (auto j = 0; j < N; j++){
+      sum += A[i][j];
+    }
+  }
+  printf("%f\n", sum);
+
+  return 0;
+}
@@ -0,0 +1,50 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+typedef struct _N {
+  int v;
+  _N *next;
+} N;
+
+void appendNode (N* tail, int newValue, int howManyMore){
+
+  N *newNode = (N *) malloc(sizeof(N));
+  newNode->v = newValue;
+  newNode->next = NULL;
+
+  tail->next = newNode ;
+
+  if (howManyMore > 0){
+    appendNode(newNode, newValue+1, howManyMore - 1);
+  }
+
+  return ;
+}
+
+int main (){
+  N *n0 = (N *) malloc(sizeof(N));
+  n0->v = 41;
+
+  appendNode(n0, 42, 999);
+
+  /*
+   * The first stage traverses the list (sequential).
+   * The second stage computes a value per node without side effects (stateless, it can be replicated).
+   * The third stage prints the values in order (sequential).
+   */
+  N *tmpN = n0;
+  while (tmpN != NULL){
+    double d = (double)tmpN->v;
+    for (int i=0; i < 20; i++){
+      d = sqrt(d + 0.143);
+    }
+    int v = (int)(d * 1000);
+
+    printf("%d\n", v);
+
+    tmpN = tmpN->next;
+  }
+
+  return 0;
+}
@@ -0,0 +1,36 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int main (int argc, char *argv[]){
+  long elements = 10000;
+  if (argc > 1){
+    elements = atol(argv[1]);
+  }
+  auto a = (long *) calloc(elements, sizeof(long));
+  auto b = (long *) calloc(elements, sizeof(long));
+  for (long i = 0; i < elements; i++){
+    b[i] = i;
+  }
+
+  /*
+   * The recurrence on x must run sequentially, but it only depends on the loop control and it is small compared to the rest of the body.
+   * Distributing it into its own loop replicates only the loop control (the inner loop stays in the parallel one) and leaves a heavy loop that can be DOALL.
+   */
+  long x = 1;
+  for (long i = 0; i < elements; i++){
+    long v = b[i];
+    for (long j = 0; j < 100; j++){
+      v = (v * 17 + j) % 1009;
+    }
+    a[i] = v;
+    x = (x * 3 + i) % 100003;
+  }
+
+  long sum = 0;
+  for (long i = 0; i < elements; i++){
+    sum += a[i];
+  }
+  printf("%ld %ld\n", sum, x);
+
+  return 0;
+}
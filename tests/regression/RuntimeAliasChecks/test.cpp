@@ -0,0 +1,45 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * The alias analyses cannot prove that dst and src point to different arrays.
+ * The loop is versioned: it runs in parallel only when the ranges accessed through dst and src are disjoint.
+ */
+void __attribute__ ((noinline)) compute (long *dst, long *src, long elements){
+  for (auto i = 0; i < elements; i++){
+    dst[i] = (src[i] * 3) + (i % 5);
+  }
+}
+
+int main (int argc, char *argv[]){
+  auto elements = 1000;
+  if (argc > 1){
+    elements = atoi(argv[1]);
+  }
+
+  /*
+   * Disjoint arrays.
+   */
+  auto a = (long *) calloc(elements * 2, sizeof(long));
+  auto b = (long *) calloc(elements, sizeof(long));
+  for (auto i = 0; i < elements; i++){
+    b[i] = i;
+  }
+  compute(a, b, elements);
+
+  /*
+   * Overlapping ranges: the original loop must run.
+   */
+  for (auto i = 0; i < elements; i++){
+    a[i] = i;
+  }
+  compute(a + 1, a, elements);
+
+  long sum = 0;
+  for (auto i = 0; i < (elements + 1); i++){
+    sum += a[i] % 1000;
+  }
+  printf("%ld\n", sum);
+
+  return 0;
+}
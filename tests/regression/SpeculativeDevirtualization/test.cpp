@@ -0,0 +1,37 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+static long square (long v){
+  return v * v;
+}
+
+static long negate (long v){
+  return -v;
+}
+
+int main (int argc, char *argv[]){
+  auto iterations = 10007;
+  if (argc > 1){
+    iterations = atoi(argv[1]);
+  }
+  auto v = (long *) calloc(iterations, sizeof(long));
+
+  /*
+   * The indirect call of the loop invokes square most of the time.
+   * Profiles make the enablers call it directly, keeping the indirect call for the other callees.
+   */
+  long (*operations[2])(long) = { square, negate };
+  auto selector = (argc > 5) ? 1 : 0;
+  for (auto i = 0; i < iterations; i++){
+    auto op = operations[((i % 97) == 0) ? 1 - selector : selector];
+    v[i] = (*op)(i % 1000);
+  }
+
+  long sum = 0;
+  for (auto i = 0; i < iterations; i++){
+    sum += v[i];
+  }
+  printf("%ld\n", sum);
+
+  return 0;
+}
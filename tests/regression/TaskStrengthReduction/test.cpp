@@ -0,0 +1,30 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int main (int argc, char *argv[]){
+  auto elements = 1003;
+  auto stride = 7;
+  if (argc > 2){
+    elements = atoi(argv[1]);
+    stride = atoi(argv[2]);
+  }
+  auto a = (int *) calloc(elements * stride, sizeof(int));
+  auto b = (int *) calloc(elements * 8, sizeof(int));
+
+  /*
+   * The multiplications of the induction variable by a loop invariant and by a power of two become additions in the DOALL tasks.
+   * The induction variable of these tasks iterates over chunks, so its evolution is not a SCEV add recurrence anymore.
+   */
+  for (auto i = 0; i < elements; i++){
+    a[i * stride] = i * 3;
+    b[i << 3] = i + a[i * stride];
+  }
+
+  long sum = 0;
+  for (auto i = 0; i < elements; i++){
+    sum += a[i * stride] + b[i * 8];
+  }
+  printf("%ld\n", sum);
+
+  return 0;
+}
@@ -0,0 +1,38 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+int main (int argc, char *argv[]){
+  auto rows = 1001;
+  auto columns = 37;
+  if (argc > 2){
+    rows = atoi(argv[1]);
+    columns = atoi(argv[2]);
+  }
+  auto m = (long *) calloc(rows * columns, sizeof(long));
+  auto v = (long *) calloc(rows, sizeof(long));
+
+  /*
+   * The task of this DOALL loop iterates over a nest that can be unrolled and jammed.
+   * The number of rows is not a multiple of common unroll factors to exercise the remainder.
+   */
+  for (auto i = 0; i < rows; i++){
+    for (auto j = 0; j < columns; j++){
+      m[i * columns + j] = (i + j) % 11;
+    }
+  }
+
+  /*
+   * The task of this DOALL loop has no nested loops, so it is partially unrolled.
+   */
+  for (auto i = 0; i < rows; i++){
+    v[i] = m[i * columns] * 3 + i;
+  }
+
+  long sum = 0;
+  for (auto i = 0; i < rows; i++){
+    sum += v[i];
+  }
+  printf("%ld\n", sum);
+
+  return 0;
+}
@@ -12,6 +12,14 @@ function runningTestsWrapper {
   return ;
 }
 
+function runningPipelineTestsWrapper {
+  local optionsToUse="$@" ;
+
+  runningTests "Testing the NOELLE pipeline with \"${optionsToUse}\"" "-noelle-verbose=3 ${optionsToUse}" "NOELLE_PIPELINE=1" ;
+
+  return ;
+}
+
 function runningTests {
   echo $1 ;
 
@@ -43,7 +51,7 @@ function runningTests {
     make clean > /dev/null ; 
 
     # Compile
-    make PARALLELIZATION_OPTIONS="$2" >> compiler_output.txt 2>&1 ;
+    make PARALLELIZATION_OPTIONS="$2" $3 >> compiler_output.txt 2>&1 ;
     
     # Generate the input
     make input.txt &> /dev/null ;
@@ -96,10 +104,20 @@ runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -dswp-no-sc
 
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-helix ;
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-helix -dswp-no-scc-merge ;
+runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-helix -dswp-no-stage-replication ;
 
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-dswp ;
 runningTestsWrapper -noelle-parallelizer-force -noelle-disable-doall -noelle-disable-dswp -dswp-no-scc-merge ;
 
+# Test the unrolling of the loops of the tasks (e.g., TaskUnrollAndJam)
+runningTestsWrapper -noelle-parallelizer-force -noelle-disable-dswp -noelle-parallelizer-task-unroll-factor=2 ;
+
+# Test the profile-guided inliner (e.g., InliningBudget)
+runningTests "Testing the inliner with a code growth budget" "-noelle-verbose=3 -noelle-parallelizer-force" "PRE_OPTIONS=-noelle-inliner-code-growth-budget=20" ;
+
+# Test the pipeline that runs all tools within a single invocation
+runningPipelineTestsWrapper -noelle-parallelizer-force ;
+
 cd ../ ;
 
 exit 0;
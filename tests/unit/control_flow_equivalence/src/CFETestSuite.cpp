@@ -50,46 +50,7 @@ bool CFETestSuite::runOnModule (Module &M) {
   errs() << "CFETestSuite: Start\n";
   auto mainFunction = M.getFunction("main");
 
-  auto &LI = getAnalysis<LoopInfoWrapperPass>(*mainFunction).getLoopInfo();
-  LoopsSummary LIS(LI.getLoopsInPreorder()[0]);
-  auto &DT = getAnalysis<DominatorTreeWrapperPass>(*mainFunction).getDomTree();
-  auto &PDT = getAnalysis<PostDominatorTreeWrapperPass>(*mainFunction).getPostDomTree();
-  DominatorSummary DS(DT, PDT);
-
-  /*
-  std::queue<BasicBlock *> bbQ;
-  for (auto bb : DT.getRoots()) bbQ.push(bb);
-  while (!bbQ.empty()) {
-    // Traverse DT and PDT to figure out why top level blocks aren't grouped together in CFE
-    auto bb = bbQ.front();
-    bbQ.pop();
-
-    bb->printAsOperand(errs() << "NODE: "); errs() << "\t";
-    auto node = DT.getNode(bb);
-    for (auto child : node->getChildren()) {
-      child->getBlock()->printAsOperand(errs() << " C: ");
-      bbQ.push(child->getBlock());
-    }
-    errs() << "\n";
-  }
-
-  for (auto bb : PDT.getRoots()) bbQ.push(bb);
-  while (!bbQ.empty()) {
-    // Traverse DT and PDT to figure out why top level blocks aren't grouped together in CFE
-    auto bb = bbQ.front();
-    bbQ.pop();
-
-    bb->printAsOperand(errs() << "PNODE: "); errs() << "\t";
-    auto node = PDT.getNode(bb);
-    for (auto child : node->getChildren()) {
-      child->getBlock()->printAsOperand(errs() << " C: ");
-      bbQ.push(child->getBlock());
-    }
-    errs() << "\n";
-  }
-  */
-
-  this->CFE = new ControlFlowEquivalence(&DS, &LIS, *mainFunction);
+  this->CFE = new ControlFlowEquivalence(*mainFunction);
 
   suite->runTests((ModulePass &)*this);
 
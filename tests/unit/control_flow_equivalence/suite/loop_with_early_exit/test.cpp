@@ -0,0 +1,23 @@
+#include <stdio.h>
+#include <stdint.h>
+
+int main (int argc, char *argv[]){
+  int v = argc;
+  for (int i = 0; i < 100; ++i) {
+
+    // Early exit: the body does not execute as many times as the header
+    if (v > argc * 50) {
+      break;
+    }
+
+    // Both paths join at the latch
+    if (i % 3 == 0) {
+      v += 2;
+      continue;
+    }
+    v += 1;
+  }
+
+  printf("%d\n", v);
+  return 0;
+}
@@ -67,6 +67,8 @@ namespace llvm::noelle {
 
       static Values loopCarriedDependencies (ModulePass &pass, TestSuite &suite) ;
 
+      static Values sameAttributesWithMultipleThreads (ModulePass &pass, TestSuite &suite) ;
+
       static Values printSCCs (ModulePass &pass, TestSuite &suite, std::set<SCC *> sccs) ;
 
       TestSuite *suite;
@@ -76,5 +78,6 @@ namespace llvm::noelle {
       PDG *fdg;
       SCCDAG *sccdag;
       SCCDAGAttrs *attrs;
+      SCCDAGAttrs *attrsWithMultipleThreads;
   };
 }
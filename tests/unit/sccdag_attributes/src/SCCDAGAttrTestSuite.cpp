@@ -32,7 +32,8 @@ const char *SCCDAGAttrTestSuite::tests[] = {
   "reducible SCC",
   "clonable SCC",
   "clonable SCC into local memory",
-  "loop carried dependencies (top loop)"
+  "loop carried dependencies (top loop)",
+  "same attributes with multiple threads"
 };
 TestFunction SCCDAGAttrTestSuite::testFns[] = {
   SCCDAGAttrTestSuite::sccdagHasCorrectSCCs,
@@ -40,7 +41,8 @@ TestFunction SCCDAGAttrTestSuite::testFns[] = {
   SCCDAGAttrTestSuite::reducibleSCCsAreFound,
   SCCDAGAttrTestSuite::clonableSCCsAreFound,
   SCCDAGAttrTestSuite::clonableSCCsIntoLocalMemoryAreFound,
-  SCCDAGAttrTestSuite::loopCarriedDependencies
+  SCCDAGAttrTestSuite::loopCarriedDependencies,
+  SCCDAGAttrTestSuite::sameAttributesWithMultipleThreads
 };
 
 bool SCCDAGAttrTestSuite::doInitialization (Module &M) {
@@ -89,11 +91,20 @@ bool SCCDAGAttrTestSuite::runOnModule (Module &M) {
   // TODO: Test attribution on normalized SCCDAG as well
   this->attrs = sccManager;
 
+  /*
+   * Classify the same SCCs with several threads.
+   * The loops are the ones the SCCs have been classified with by the loop abstraction.
+   */
+  errs() << "SCCDAGAttrTestSuite: Constructing SCCDAGAttrs with multiple threads\n";
+  auto &loopsOfLDI = const_cast<LoopsSummary &>(loopDI->getLoopHierarchyStructures());
+  this->attrsWithMultipleThreads = new SCCDAGAttrs(true, loopDI->getLoopDG(), this->sccdag, loopsOfLDI, *SE, *loopDI->getInductionVariableManager(), DS, 4);
+
   // DGPrinter::writeGraph<SCCDAG, SCC>("graph-loop.dot", sccdag);
 
   errs() << "SCCDAGAttrTestSuite: Running suite\n";
   suite->runTests((ModulePass &)*this);
 
+  delete this->attrsWithMultipleThreads;
   delete this->attrs;
   delete this->sccdag;
 
@@ -179,6 +190,35 @@ Values SCCDAGAttrTestSuite::printSCCs (ModulePass &pass, TestSuite &suite, std::
   return valueNames;
 }
 
+Values SCCDAGAttrTestSuite::sameAttributesWithMultipleThreads (ModulePass &pass, TestSuite &suite) {
+  auto &attrPass = static_cast<SCCDAGAttrTestSuite &>(pass);
+
+  /*
+   * Collect the SCCs whose attributes depend on the number of threads used to classify them.
+   */
+  std::set<SCC *> sccs;
+  for (auto node : attrPass.sccdag->getNodes()) {
+    auto scc = node->getT();
+    auto sccAttrs = attrPass.attrs->getSCCAttrs(scc);
+    auto sccAttrsWithThreads = attrPass.attrsWithMultipleThreads->getSCCAttrs(scc);
+    auto dependences = attrPass.attrs->sccToLoopCarriedDependencies[scc];
+    auto dependencesWithThreads = attrPass.attrsWithMultipleThreads->sccToLoopCarriedDependencies[scc];
+    if (  false
+          || (sccAttrs->getType() != sccAttrsWithThreads->getType())
+          || (sccAttrs->canExecuteReducibly() != sccAttrsWithThreads->canExecuteReducibly())
+          || (sccAttrs->canBeCloned() != sccAttrsWithThreads->canBeCloned())
+          || (sccAttrs->canBeClonedUsingLocalMemoryLocations() != sccAttrsWithThreads->canBeClonedUsingLocalMemoryLocations())
+          || (sccAttrs->isInductionVariableSCC() != sccAttrsWithThreads->isInductionVariableSCC())
+          || (sccAttrs->isCommutative() != sccAttrsWithThreads->isCommutative())
+          || (dependences.size() != dependencesWithThreads.size())
+       ){
+      sccs.insert(scc);
+    }
+  }
+
+  return SCCDAGAttrTestSuite::printSCCs(pass, suite, sccs);
+}
+
 Values SCCDAGAttrTestSuite::loopCarriedDependencies (ModulePass &pass, TestSuite &suite) {
   SCCDAGAttrTestSuite &attrPass = static_cast<SCCDAGAttrTestSuite &>(pass);
   Values valueNames{};